@@ -0,0 +1,83 @@
+`timescale 1ns / 1ps
+
+// Dual-clock FIFO with Gray-coded pointers. Each side sees the other's
+// pointer through a two-flop synchronizer, so full/empty are conservative
+// but never wrong. The write clock may stop between bursts (e.g. SCLK);
+// `full` then stays pessimistic until it runs again.
+module async_fifo #(
+    parameter int WIDTH     = 8,
+    parameter int ADDR_BITS = 3   // 2**ADDR_BITS entries, at least 2
+) (
+    input logic rst_n,  // asynchronous, clears both sides
+
+    // Write side
+    input  logic             wclk,
+    input  logic             wr_en,
+    input  logic [WIDTH-1:0] wr_data,
+    output logic             full,
+
+    // Read side
+    input  logic             rclk,
+    input  logic             rd_en,
+    output logic [WIDTH-1:0] rd_data,   // head entry, valid while !empty
+    output logic             empty
+);
+
+  localparam int DEPTH = 1 << ADDR_BITS;
+
+  logic [WIDTH-1:0] mem[DEPTH];
+
+  // Binary and Gray pointers carry one extra wrap bit
+  logic [ADDR_BITS:0] wbin, wgray, rbin, rgray;
+  logic [ADDR_BITS:0] rgray_w1, rgray_w2;  // read pointer in the write domain
+  logic [ADDR_BITS:0] wgray_r1, wgray_r2;  // write pointer in the read domain
+
+  function automatic logic [ADDR_BITS:0] bin2gray(input logic [ADDR_BITS:0] b);
+    return b ^ (b >> 1);
+  endfunction
+
+  // ---------------- Write domain
+  logic [ADDR_BITS:0] wbin_next;
+  assign wbin_next = wbin + 1'b1;
+  assign full = bin2gray(wbin) == {~rgray_w2[ADDR_BITS:ADDR_BITS-1], rgray_w2[ADDR_BITS-2:0]};
+
+  always_ff @(posedge wclk or negedge rst_n) begin
+    if (!rst_n) begin
+      wbin     <= '0;
+      wgray    <= '0;
+      rgray_w1 <= '0;
+      rgray_w2 <= '0;
+    end else begin
+      rgray_w1 <= rgray;
+      rgray_w2 <= rgray_w1;
+      if (wr_en && !full) begin
+        mem[wbin[ADDR_BITS-1:0]] <= wr_data;
+        wbin  <= wbin_next;
+        wgray <= bin2gray(wbin_next);
+      end
+    end
+  end
+
+  // ---------------- Read domain
+  logic [ADDR_BITS:0] rbin_next;
+  assign rbin_next = rbin + 1'b1;
+  assign empty = rgray == wgray_r2;
+  assign rd_data = mem[rbin[ADDR_BITS-1:0]];
+
+  always_ff @(posedge rclk or negedge rst_n) begin
+    if (!rst_n) begin
+      rbin     <= '0;
+      rgray    <= '0;
+      wgray_r1 <= '0;
+      wgray_r2 <= '0;
+    end else begin
+      wgray_r1 <= wgray;
+      wgray_r2 <= wgray_r1;
+      if (rd_en && !empty) begin
+        rbin  <= rbin_next;
+        rgray <= bin2gray(rbin_next);
+      end
+    end
+  end
+
+endmodule
@@ -4,7 +4,13 @@
 `include "bnn_module/bnn_top.sv"
 `endif
 
-module bnn_interface (
+module bnn_interface #(
+    // bnn_top replicas; jobs are dispatched round-robin and retired in order
+    parameter int NUM_BNN_CORES = 1,
+    // 1: bnn_top runs on clk and its result is taken as soon as it rises,
+    //    without the clk/4 enable and the result synchronizers
+    parameter bit LOW_LATENCY = 0
+) (
     input logic clk,
     input logic rst_n,
 
@@ -12,23 +18,40 @@ module bnn_interface (
     input  logic [899:0] img_in,
     output logic [  3:0] result_out,
 
+    // Pixels changed since the previous job; without dirty_all the core only
+    // recomputes what those pixels affect
+    input  logic [899:0] dirty_in,
+    input  logic         dirty_all,
+    output logic         img_latched,  // pulse: img_in/dirty_in have been taken
+
     // Control
     output logic result_ready,
     input  logic bnn_enable,
     input  logic bnn_clear,
-    output logic bnn_ready_for_input
+    input  logic result_ack,  // release the result so the BNN can take a new job
+    output logic bnn_ready_for_input,
+
+    // Runtime weight upload, broadcast to every core (weight_loader)
+    input logic        weight_bank,
+    input logic        weight_wr_en,
+    input logic [13:0] weight_wr_addr,
+    input logic [ 7:0] weight_wr_data,
+
+    input logic debug_enable  // bnn_top logs job events only while high (simulation)
+`ifndef SYNTHESIS
+    ,
+    // bnn_top's out_valid for the core whose result is reported next, so
+    // the testbench can time the result path
+    output logic bnn_done
+`endif
 );
   //------------------------------------------------------------------
-  // Parameters / types
+  // Parameters
   //------------------------------------------------------------------
   parameter int CONV1_IMG_IN_SIZE = 30;
   parameter int CONV1_IC = 1;
 
-  typedef enum logic [1:0] {
-    IDLE,
-    INFERENCE,
-    DONE
-  } bnn_state_t;
+  localparam int PTR_W = (NUM_BNN_CORES > 1) ? $clog2(NUM_BNN_CORES) : 1;
 
   //------------------------------------------------------------------
   // Slow-clock enable (divide-by-4 for example)
@@ -43,168 +66,285 @@ module bnn_interface (
 
   assign bnn_clk_en = (clk_div == 2'b00);
 
+  logic bnn_clk;
+  assign bnn_clk = LOW_LATENCY ? clk : bnn_clk_en;
+
   //------------------------------------------------------------------
-  // Internal / intermediate signals
+  // Dispatcher
   //------------------------------------------------------------------
-  // Top-level Module signals
-  logic [899:0] img_in_internal;
-  logic         result_ready_internal;
-  logic [  3:0] result_out_internal;
+  // issue_ptr: core that takes the next image, retire_ptr: core whose
+  // result is reported next. With one core both stay at 0.
+  logic [PTR_W-1:0] issue_ptr, retire_ptr;
 
-  // BNN Module signals
-  logic [899:0] img_to_bnn_raw;
-  logic         data_in_ready_raw;
-  logic [  3:0] result_out_from_bnn_raw;
-  logic         data_out_ready_raw;
+  logic [NUM_BNN_CORES-1:0] core_ready;  // can latch an image
+  logic [NUM_BNN_CORES-1:0] core_latched;  // pulse: took img_in
+  logic [NUM_BNN_CORES-1:0] core_result_ready;
+  logic [3:0] core_result[NUM_BNN_CORES];
 
-  // Intermediate signals
-  logic         data_in_ready_stage;
-  logic         data_out_ready_stage;
-
-  logic start_sys, start_sync1, start_sync2;
-  wire h2b_pulse;
+  // An incremental run needs the core's own previous activations, which a
+  // round-robin core never has for the image it is given
+  logic incremental_ok;
+  assign incremental_ok = (NUM_BNN_CORES == 1) && !dirty_all;
 
   always_ff @(posedge clk or negedge rst_n) begin
     if (!rst_n) begin
-      start_sys <= 1'b0;
+      issue_ptr  <= '0;
+      retire_ptr <= '0;
     end else if (bnn_clear) begin
-      start_sys <= 1'b0;  // explicit clear
-    end else if (state == IDLE && bnn_enable) begin
-      start_sys <= 1'b1;  // arm on bnn_enable in IDLE
-    end else if (data_out_ready_stage) begin
-      start_sys <= 1'b0;  // drop once BNN signals done
-    end
-  end
-
-  always_ff @(posedge clk or negedge rst_n) begin
-    if (!rst_n) begin
-      start_sync1 <= 1'b0;
-      start_sync2 <= 1'b0;
-    end else if (bnn_clk_en) begin
-      start_sync1 <= start_sys;
-      start_sync2 <= start_sync1;
-    end
-  end
-
-  assign h2b_pulse = start_sync1 & ~start_sync2;
-  assign data_in_ready_raw = start_sync2;
-
-  logic data_out_ready_sync1, data_out_ready_sync2;
-
-  logic [3:0] result_out_sync;
-  logic [3:0] result_out_clk_sync1, result_out_clk_sync2;
-
-  always_ff @(posedge clk or negedge rst_n) begin
-    if (!rst_n) begin
-      data_out_ready_sync1 <= 1'b0;
-      data_out_ready_sync2 <= 1'b0;
-      result_out_clk_sync1 <= 4'd0;
-      result_out_clk_sync2 <= 4'd0;
+      issue_ptr  <= '0;
+      retire_ptr <= '0;
     end else begin
-      data_out_ready_sync1 <= data_out_ready_raw;
-      data_out_ready_sync2 <= data_out_ready_sync1;
-      result_out_clk_sync1 <= result_out_sync;
-      result_out_clk_sync2 <= result_out_clk_sync1;
-    end
-  end
-
-  always_ff @(posedge clk or negedge rst_n) begin
-    if (!rst_n) begin
-      result_out_sync <= 4'd0;
-    end else if (bnn_clk_en && data_out_ready_raw) begin
-      result_out_sync <= result_out_from_bnn_raw;
+      if (|core_latched) issue_ptr <= (issue_ptr == PTR_W'(NUM_BNN_CORES - 1)) ? '0 : issue_ptr + 1'b1;
+      if (result_ready && result_ack)
+        retire_ptr <= (retire_ptr == PTR_W'(NUM_BNN_CORES - 1)) ? '0 : retire_ptr + 1'b1;
     end
   end
 
-  assign result_out           = (|img_in_stage) ? result_out_internal : 4'd10;
-  assign result_out_internal  = result_out_stage;
-  assign result_ready         = result_ready_internal;
-  assign data_out_ready_stage = data_out_ready_sync2;
+  assign bnn_ready_for_input = core_ready[issue_ptr];
+  assign img_latched         = |core_latched;
+  assign result_ready        = core_result_ready[retire_ptr];
+  assign result_out          = core_result[retire_ptr];
 
-  //------------------------------------------------------------------
-  // BNN-core instantiation
-  //------------------------------------------------------------------
-  bnn_top u_bnn_top (
-      .clk(bnn_clk_en),
-      .conv1_img_in('{img_to_bnn_raw}),
-      .data_in_ready(data_in_ready_raw),
-      .result(result_out_from_bnn_raw),
-      .data_out_ready(data_out_ready_raw)
-  );
+`ifndef SYNTHESIS
+  logic [NUM_BNN_CORES-1:0] core_done;
+  assign bnn_done = core_done[retire_ptr];
+`endif
 
   //------------------------------------------------------------------
-  // FSM
+  // Cores
   //------------------------------------------------------------------
-  bnn_state_t state, next_state;
-
-  logic [899:0] img_in_stage;
-  logic [  3:0] result_out_stage;
-
-  always_comb begin
-    next_state = state;
-    case (state)
-      IDLE: if (data_in_ready_stage) next_state = INFERENCE;
-      INFERENCE: if (data_out_ready_stage) next_state = DONE;
-      DONE: if (bnn_clear) next_state = IDLE;
-      default: next_state = IDLE;
-    endcase
-  end
-
-  // Main sequential logic
-  always_ff @(posedge clk or negedge rst_n) begin
-    if (!rst_n) begin
-      state <= IDLE;
+  // Each bnn_top streams jobs through its layers: the next image is handed
+  // over as soon as conv1 is done with the previous one. Both directions
+  // cross into bnn_clk with a four-phase handshake (a request level held
+  // until the other side's acknowledge level is seen), and bnn_clear
+  // flushes the layers the same way.
+  localparam int JOBS_IN_FLIGHT = 8;  // per core, latch to result taken
+  localparam int JOBS_W = $clog2(JOBS_IN_FLIGHT + 1);
+
+  for (genvar c = 0; c < NUM_BNN_CORES; c = c + 1) begin : core_gen
+    logic core_enable;
+    logic core_ack;
+    logic core_accept;
+    assign core_enable = bnn_enable && issue_ptr == PTR_W'(c);
+    assign core_ack    = result_ack && retire_ptr == PTR_W'(c);
+
+    // Top-level Module signals
+    logic         result_ready_internal;
+    logic [  3:0] result_out_stage;
+    logic         img_latched_core;
+
+    // BNN Module signals
+    logic [899:0] img_to_bnn_raw;
+    logic [899:0] dirty_to_bnn_raw;
+    logic         incremental_to_bnn_raw;
+    logic         clear_raw;
+    logic         in_valid_raw;
+    logic         in_ready_raw;
+    logic [  3:0] result_out_from_bnn_raw;
+    logic         out_valid_raw;
+    logic         out_ready_raw;
+
+    // Synchronizers into the bnn_clk domain only change on bnn_clk_en, a
+    // full bnn_clk period ahead of the edge that samples them
+    logic job_req, job_sync1, job_sync2;
+    logic flush_req, flush_sync1, flush_sync2;
+
+    always_ff @(posedge clk or negedge rst_n) begin
+      if (!rst_n) begin
+        job_sync1   <= 1'b0;
+        job_sync2   <= 1'b0;
+        flush_sync1 <= 1'b0;
+        flush_sync2 <= 1'b0;
+      end else if (bnn_clk_en || LOW_LATENCY) begin
+        job_sync1   <= job_req;
+        job_sync2   <= job_sync1;
+        flush_sync1 <= flush_req;
+        flush_sync2 <= flush_sync1;
+      end
+    end
 
-      result_ready_internal <= 1'b0;
-      data_in_ready_stage <= 1'b0;
-      result_out_stage <= 4'd0;
+    assign clear_raw = flush_sync2;
 
-      img_in_stage <= 900'd0;
-      img_to_bnn_raw <= 900'd0;
-    end else if (bnn_clear) begin
-      state <= IDLE;
+    // bnn_clk side: job_req has been seen and bnn_top took the job; the
+    // layers have been cleared
+    logic in_taken = 1'b0;
+    logic flush_done = 1'b0;
 
-      result_ready_internal <= 1'b0;
-      data_in_ready_stage <= 1'b0;
-      result_out_stage <= 4'd0;
+    always_ff @(posedge bnn_clk) begin
+      flush_done <= clear_raw;
+      if (clear_raw) in_taken <= 1'b0;
+      else if (in_valid_raw && in_ready_raw) in_taken <= 1'b1;
+      else if (!job_sync2) in_taken <= 1'b0;
+    end
 
-      img_in_stage <= 900'd0;
-      img_to_bnn_raw <= 900'd0;
-    end else begin
-      state <= next_state;
-      case (state)
-        IDLE: begin
-          data_in_ready_stage   <= 1'b0;
-          result_ready_internal <= 1'b0;
-          img_to_bnn_raw        <= 900'd0;
+    assign in_valid_raw = job_sync2 && !in_taken;
+
+    // Back in the clk domain; same clock as bnn_top in LOW_LATENCY
+    logic job_ack_sync1, job_ack_sync2, flush_done_sync1, flush_done_sync2;
+    logic job_ack, flush_ack;
+
+    always_ff @(posedge clk or negedge rst_n) begin
+      if (!rst_n) begin
+        job_ack_sync1    <= 1'b0;
+        job_ack_sync2    <= 1'b0;
+        flush_done_sync1 <= 1'b0;
+        flush_done_sync2 <= 1'b0;
+      end else begin
+        job_ack_sync1    <= in_taken;
+        job_ack_sync2    <= job_ack_sync1;
+        flush_done_sync1 <= flush_done;
+        flush_done_sync2 <= flush_done_sync1;
+      end
+    end
 
-          if (h2b_pulse) begin
-            img_in_stage        <= img_in;
-            img_to_bnn_raw      <= img_in;
-            data_in_ready_stage <= 1'b1;
+    assign job_ack   = LOW_LATENCY ? in_taken : job_ack_sync2;
+    assign flush_ack = LOW_LATENCY ? flush_done : flush_done_sync2;
+
+    // Results. bnn_top holds each one until out_ready, so a full result
+    // slot only stalls the layers.
+    logic       res_valid_stage;
+    logic [3:0] res_data_stage;
+    logic       res_take;
+    logic       flushing;
+
+    assign flushing = flush_req || flush_ack;
+    assign res_take = res_valid_stage && !result_ready_internal && !flushing;
+
+    if (LOW_LATENCY) begin : result_direct
+      // bnn_top runs on clk: plain valid/ready
+      assign res_valid_stage = out_valid_raw;
+      assign res_data_stage  = result_out_from_bnn_raw;
+      assign out_ready_raw   = res_take;
+    end else begin : result_cdc
+      logic       res_req = 1'b0;  // bnn_clk: res_hold is waiting for the clk side
+      logic [3:0] res_hold;
+      logic res_req_sync1, res_req_sync2;
+      logic res_ack, res_ack_sync1, res_ack_sync2;
+
+      assign out_ready_raw = !res_req && !res_ack_sync2;
+
+      always_ff @(posedge bnn_clk) begin
+        if (clear_raw) res_req <= 1'b0;
+        else if (out_valid_raw && out_ready_raw) begin
+          res_req  <= 1'b1;
+          res_hold <= result_out_from_bnn_raw;
+        end else if (res_ack_sync2) res_req <= 1'b0;
+      end
+
+      always_ff @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+          res_req_sync1 <= 1'b0;
+          res_req_sync2 <= 1'b0;
+          res_ack       <= 1'b0;
+          res_ack_sync1 <= 1'b0;
+          res_ack_sync2 <= 1'b0;
+        end else begin
+          res_req_sync1 <= res_req;
+          res_req_sync2 <= res_req_sync1;
+          if (res_take) res_ack <= 1'b1;
+          else if (!res_req_sync2) res_ack <= 1'b0;
+          if (bnn_clk_en) begin
+            res_ack_sync1 <= res_ack;
+            res_ack_sync2 <= res_ack_sync1;
           end
         end
+      end
 
-        INFERENCE: begin
-          data_in_ready_stage <= 1'b0;
-          if (data_out_ready_stage) begin
-            result_out_stage <= result_out_clk_sync2;
-            result_ready_internal <= 1'b1;
-          end else data_in_ready_stage <= 1'b0;
-        end
+      // res_hold has been still for two clocks by the time res_req_sync2 rises
+      assign res_valid_stage = res_req_sync2 && !res_ack;
+      assign res_data_stage  = res_hold;
+    end
 
-        DONE: begin
-          if (bnn_clear) begin
-            result_ready_internal <= 1'b0;  // clear result ready
-          end else begin
-            result_ready_internal <= 1'b1;  // hold ready until clear
-          end
+    // Whether each job in flight had any pixel set, oldest at bit 0: a blank
+    // image shows 10 (blank) whatever the network says
+    logic [JOBS_IN_FLIGHT-1:0] job_nonblank;
+    logic [JOBS_W-1:0] jobs;
+
+    // A new image can be latched once bnn_top has the previous one
+    assign core_ready[c]        = !job_req && !job_ack && !flushing && jobs != JOBS_W'(JOBS_IN_FLIGHT);
+    assign core_accept          = core_enable && core_ready[c];
+    assign core_latched[c]      = img_latched_core;
+    assign core_result_ready[c] = result_ready_internal;
+    assign core_result[c]       = result_out_stage;
+`ifndef SYNTHESIS
+    assign core_done[c] = out_valid_raw;
+`endif
+
+    //------------------------------------------------------------------
+    // BNN-core instantiation
+    //------------------------------------------------------------------
+    bnn_top u_bnn_top (
+        .clk(bnn_clk),
+        .clear(clear_raw),
+        .conv1_img_in('{img_to_bnn_raw}),
+        .in_valid(in_valid_raw),
+        .in_ready(in_ready_raw),
+        .incremental(incremental_to_bnn_raw),
+        .dirty_in(dirty_to_bnn_raw),
+        .result(result_out_from_bnn_raw),
+        .out_valid(out_valid_raw),
+        .out_ready(out_ready_raw),
+        .weight_bank(weight_bank),
+        .weight_wr_en(weight_wr_en),
+        .weight_wr_addr(weight_wr_addr),
+        .weight_wr_data(weight_wr_data),
+        .debug_enable(debug_enable)
+    );
+
+    //------------------------------------------------------------------
+    // Job and result bookkeeping
+    //------------------------------------------------------------------
+    always_ff @(posedge clk or negedge rst_n) begin
+      if (!rst_n) begin
+        job_req   <= 1'b0;
+        flush_req <= 1'b1;  // bnn_top has no reset of its own
+
+        result_ready_internal <= 1'b0;
+        result_out_stage <= 4'd0;
+
+        job_nonblank <= '0;
+        jobs <= '0;
+        img_to_bnn_raw <= 900'd0;
+        dirty_to_bnn_raw <= 900'd0;
+        incremental_to_bnn_raw <= 1'b0;
+        img_latched_core <= 1'b0;
+      end else if (bnn_clear) begin
+        job_req   <= 1'b0;
+        flush_req <= 1'b1;
+
+        result_ready_internal <= 1'b0;
+        result_out_stage <= 4'd0;
+
+        job_nonblank <= '0;
+        jobs <= '0;
+        img_latched_core <= 1'b0;
+      end else begin
+        img_latched_core <= 1'b0;
+        if (flush_ack) flush_req <= 1'b0;
+
+        // The image stays put until bnn_top has taken it
+        if (core_accept) begin
+          img_to_bnn_raw         <= img_in;
+          dirty_to_bnn_raw       <= dirty_in;
+          incremental_to_bnn_raw <= incremental_ok;
+          img_latched_core       <= 1'b1;
+          job_req                <= 1'b1;
+        end else if (job_ack) begin
+          job_req <= 1'b0;
         end
 
-        default: begin
+        if (res_take) job_nonblank <= job_nonblank >> 1;
+        if (core_accept) job_nonblank[jobs-JOBS_W'(res_take)] <= |img_in;
+        jobs <= jobs + JOBS_W'(core_accept) - JOBS_W'(res_take);
+
+        // Hold the result until the host acknowledges it
+        if (res_take) begin
+          result_out_stage      <= job_nonblank[0] ? res_data_stage : 4'd10;
+          result_ready_internal <= 1'b1;
+        end else if (core_ack) begin
           result_ready_internal <= 1'b0;
         end
-      endcase
+      end
     end
   end
 
@@ -2,6 +2,8 @@
     Comparator module, 
     compares the outputs from the FC layer to decide the final classification output
     the inputs should be in the form of Q8.8 fixed-point array
+    in holds still from in_valid until in_ready; out stays put from out_valid
+    until out_ready while the next scan runs
 */
 `timescale 1ns / 1ps
 
@@ -10,34 +12,50 @@ module Comparator #(
     parameter int OUTPUT_BIT = $clog2(IC + 1)  // num of bits to enumerate each class
 ) (
     input logic clk,
-    input logic data_in_ready,
+    input logic clear,
+    input logic in_valid,
+    output logic in_ready,
     input logic signed [15:0] in[0:IC-1],
     output logic [OUTPUT_BIT-1:0] out,
-    output logic data_out_ready
+    output logic out_valid,
+    input logic out_ready
 );
   logic signed [15:0] max;
   logic [OUTPUT_BIT-1:0] max_ind;
   integer cur_ic;
+  logic running = 0;
+  logic pending = 0;  // finished scan waiting for out to be taken
+
+  logic start, finish, publish;
+  assign start = in_valid && !running && !pending && !clear;
+  assign finish = running && cur_ic == IC;
+  assign in_ready = finish;
+  assign publish = (finish || pending) && (!out_valid || out_ready);
 
   always_ff @(posedge clk) begin
-    if (!data_in_ready) begin
+    if (clear) begin
+      running <= 0;
+      pending <= 0;
+      out_valid <= 0;
+    end else begin
+      if (start) running <= 1;
+      else if (finish) running <= 0;
+      pending <= (finish || pending) && !publish;
+      if (publish) out_valid <= 1;
+      else if (out_ready) out_valid <= 0;
+    end
+    if (publish) out <= max_ind;
+
+    if (start) begin
       max <= in[0];
       max_ind <= 0;
       cur_ic <= 0;
-      data_out_ready <= 0;
-      out <= 0;
-    end else
-    if (data_out_ready) begin
-    end else begin
+    end else if (running && cur_ic < IC) begin
       if (max < in[cur_ic]) begin
         max <= in[cur_ic];
         max_ind <= cur_ic[OUTPUT_BIT-1:0];
       end
       cur_ic <= cur_ic + 1;
-      if (cur_ic == IC) begin
-        data_out_ready <= 1;
-        out <= max_ind;
-      end
     end
   end
 
@@ -2,13 +2,17 @@
 `define CONV2D_MAXPOOL2D_SV
 
 `ifndef SYNTHESIS
-`include "ConvCore.sv"
-`include "MaxPoolCore.sv"
+`include "ConvPoolCore.sv"
+`include "ConvPoolCoreFixed.sv"
 `endif
 
 `timescale 1ns / 1ps
 
 module Conv2d_MaxPool2d #(
+    parameter int LAYER = 0,  // 1/2: use the weight-specialized kernel under CONV_SPECIALIZED
+    // 1: keep the pooled maps in ping-pong block RAM, read a channel at a
+    // time through rd_ch / rd_data, instead of driving img_out
+    parameter bit ACT_RAM = 0,
     parameter int IC = 4,
     parameter int OC = 8,
     parameter int CONV_IMG_IN_SIZE = 30,
@@ -16,64 +20,235 @@ module Conv2d_MaxPool2d #(
     parameter int POOL_IMG_OUT_SIZE = CONV_IMG_OUT_SIZE / 2
 ) (
     input logic clk,
-    input logic data_in_ready,
+    input logic clear,  // drop the run in progress and the maps not yet taken
+    // the input (image, dirty_in, incremental) stays put while in_valid is
+    // high; in_ready pulses on the last cycle the run reads it
+    input logic in_valid,
+    output logic in_ready,
+`ifdef CONV_SPECIALIZED
     input logic [CONV_IMG_IN_SIZE*CONV_IMG_IN_SIZE-1:0] img_in[0:IC-1],
+`else
+    // input image one channel at a time (see ConvPoolCore): channel in_ch
+    // must be on in_data one clock later
+    output integer in_ch,
+    input logic [CONV_IMG_IN_SIZE*CONV_IMG_IN_SIZE-1:0] in_data,
+`endif
     input logic [IC*9-1:0] weights[0:OC-1],
+    // incremental mode: only pixels flagged in dirty_in changed since the
+    // previous run, whose activations this module still holds. Only valid
+    // once the maps of every earlier run have been taken (bnn_top runs
+    // incremental jobs on their own)
+    input logic incremental,
+    input logic [CONV_IMG_IN_SIZE*CONV_IMG_IN_SIZE-1:0] dirty_in,
+    // Published maps of the latest run: they stay put from out_valid until
+    // out_ready, while the next run writes the other bank
     output logic [POOL_IMG_OUT_SIZE*POOL_IMG_OUT_SIZE-1:0] img_out [0:OC-1], /* verilator lint_off UNUSEDSIGNAL */
-    output logic data_out_ready
+    output logic [POOL_IMG_OUT_SIZE*POOL_IMG_OUT_SIZE-1:0] dirty_out,  // pooled pixels that changed in any channel
+    output logic out_valid,
+    input logic out_ready,
+    // ACT_RAM: channel rd_ch of the published maps is on rd_data one clock
+    // later
+    input integer rd_ch,
+    output logic [POOL_IMG_OUT_SIZE*POOL_IMG_OUT_SIZE-1:0] rd_data
 );
   logic [IC*9-1:0] core_weight;
-  logic [CONV_IMG_OUT_SIZE*CONV_IMG_OUT_SIZE-1:0] core_img_out;
+  logic [POOL_IMG_OUT_SIZE*POOL_IMG_OUT_SIZE-1:0] core_prev;
   logic [POOL_IMG_OUT_SIZE*POOL_IMG_OUT_SIZE-1:0] pool_img_out;
+  logic [POOL_IMG_OUT_SIZE*POOL_IMG_OUT_SIZE-1:0] dirty_pool;
   logic core_data_in_ready;
   logic core_data_out_ready;
   integer cur_oc;
 
+  logic running = 0;
+  logic pending = 0;  // finished run waiting for the published maps to be taken
+
+  logic start;
+  assign start = in_valid && !running && !pending && !clear;
+
+  // a channel's pooled map is done and gets stored
+  logic store;
+  assign store = running && core_data_out_ready && cur_oc != OC;
+
+  // the last (dummy) core pass is over: the input is free, the maps wait
+  // for the published bank to be free
+  logic finish;
+  assign finish = running && core_data_out_ready && cur_oc == OC;
+  assign in_ready = finish;
+
+  // the finished maps become the published bank
+  logic publish;
+  assign publish = (finish || pending) && (!out_valid || out_ready);
+
+  // channel whose previous map core_prev has to show from the next cycle on
+  integer prev_ch;
+  always_comb begin
+    prev_ch = (cur_oc < OC) ? cur_oc : 0;
+    if (!running) prev_ch = 0;
+    else if (store && cur_oc < OC - 1) prev_ch = cur_oc + 1;
+  end
+
   always_ff @(posedge clk) begin : ConvBlock
-    if (!data_in_ready) begin
+    if (clear) begin
+      running   <= 0;
+      pending   <= 0;
+      out_valid <= 0;
+    end else begin
+      if (start) running <= 1;
+      else if (finish) running <= 0;
+      pending <= (finish || pending) && !publish;
+      if (publish) out_valid <= 1;
+      else if (out_ready) out_valid <= 0;
+    end
+
+    // dirty_out describes the published maps and is only cleared when the
+    // next run starts
+    if (start) dirty_out <= 0;
+
+    if (!running) begin
       cur_oc <= 0;
-      data_out_ready <= 0;
       core_data_in_ready <= 0;
       core_weight <= weights[0];
-      for (int i = 0; i < OC; i = i + 1) begin
-        img_out[i] <= 0;
+    end else if (core_data_out_ready) begin
+      core_data_in_ready <= 0;
+      if (cur_oc != OC) begin
+        cur_oc <= cur_oc + 1;
+        core_weight <= weights[cur_oc+1];
+        dirty_out <= dirty_out | (pool_img_out ^ core_prev);
       end
-    end else
-    if (data_out_ready) begin
     end else begin
-      if (core_data_out_ready) begin
-        core_data_in_ready <= 0;
-        if (cur_oc == OC) begin
-          data_out_ready <= 1;
-        end else begin
-          cur_oc <= cur_oc + 1;
-          core_weight <= weights[cur_oc+1];
-          img_out[cur_oc] <= pool_img_out;
+      core_data_in_ready <= 1;
+    end
+  end
+
+  generate
+    if (ACT_RAM) begin : act_ram_gen
+      // Ping-pong: `bank` holds the published run, which the next layer
+      // reads and an incremental run starts from; the run in progress
+      // writes the other bank. Both have one write and one read port.
+      (* ram_style = "block" *)
+      logic [POOL_IMG_OUT_SIZE*POOL_IMG_OUT_SIZE-1:0] bank0[0:OC-1];
+      (* ram_style = "block" *)
+      logic [POOL_IMG_OUT_SIZE*POOL_IMG_OUT_SIZE-1:0] bank1[0:OC-1];
+      logic [POOL_IMG_OUT_SIZE*POOL_IMG_OUT_SIZE-1:0] q0, q1;
+      logic bank = 0;
+      logic q_bank;
+      integer rd_addr;
+
+      // An incremental run reads the previous maps, from the cycle before
+      // it starts; it only runs once the next layer is done with them. A
+      // full run ignores them, and the next layer reads its input.
+      assign rd_addr = (in_valid && incremental) ? prev_ch : rd_ch;
+
+      always_ff @(posedge clk) begin
+        q0 <= bank0[rd_addr];
+        q1 <= bank1[rd_addr];
+        q_bank <= bank;
+        if (store) begin
+          if (bank) bank0[cur_oc] <= pool_img_out;
+          else bank1[cur_oc] <= pool_img_out;
         end
-      end else begin
-        core_data_in_ready <= 1;
+        if (publish) bank <= !bank;
       end
+
+      assign core_prev = q_bank ? q1 : q0;
+      assign rd_data   = core_prev;
+
+`ifdef BNN_TAPS
+      // flop copy for bnn_top's pool1 tap only
+      always_ff @(posedge clk) begin
+        if (store) img_out[cur_oc] <= pool_img_out;
+      end
+`else
+      assign img_out = '{default: '0};
+`endif
+    end else begin : act_reg_gen
+      // The same ping-pong in registers, with the published bank on
+      // img_out. Nothing is cleared between runs: a full run stores every
+      // channel, and an incremental one needs the maps of the run before it.
+      logic [POOL_IMG_OUT_SIZE*POOL_IMG_OUT_SIZE-1:0] bank0[0:OC-1];
+      logic [POOL_IMG_OUT_SIZE*POOL_IMG_OUT_SIZE-1:0] bank1[0:OC-1];
+      logic bank = 0;
+
+      always_ff @(posedge clk) begin
+        if (store) begin
+          if (bank) bank0[cur_oc] <= pool_img_out;
+          else bank1[cur_oc] <= pool_img_out;
+        end
+        if (publish) bank <= !bank;
+        core_prev <= bank ? bank1[prev_ch] : bank0[prev_ch];
+      end
+
+      always_comb
+        for (int i = 0; i < OC; i++) img_out[i] = bank ? bank1[i] : bank0[i];
+      assign rd_data = '0;
     end
-  end
+  endgenerate
 
-  ConvCore #(
+  // A pooled pixel depends on the 4x4 input patch under its 2x2 conv window,
+  // so it has to be recomputed if any pixel of that patch is dirty
+  genvar row, col;
+  generate
+    for (row = 0; row < POOL_IMG_OUT_SIZE; row = row + 1) begin : dirty_row_gen
+      for (col = 0; col < POOL_IMG_OUT_SIZE; col = col + 1) begin : dirty_col_gen
+        localparam int IN_ROW = 2 * row;
+        localparam int IN_COL = 2 * col;
+        assign dirty_pool[row*POOL_IMG_OUT_SIZE+col] =
+            (|dirty_in[IN_ROW*CONV_IMG_IN_SIZE+IN_COL+:4]) |
+            (|dirty_in[(IN_ROW+1)*CONV_IMG_IN_SIZE+IN_COL+:4]) |
+            (|dirty_in[(IN_ROW+2)*CONV_IMG_IN_SIZE+IN_COL+:4]) |
+            (|dirty_in[(IN_ROW+3)*CONV_IMG_IN_SIZE+IN_COL+:4]);
+      end
+    end
+  endgenerate
+
+  // conv and pool are fused: the core walks the image in pooling-window order
+  // and only ever produces the pooled output
+`ifdef CONV_SPECIALIZED
+  if (LAYER != 0) begin : core_gen
+    ConvPoolCoreFixed #(
+        .LAYER(LAYER),
+        .IC(IC),
+        .OC(OC),
+        .IMG_IN_SIZE(CONV_IMG_IN_SIZE),
+        .CONV_IMG_OUT_SIZE(CONV_IMG_OUT_SIZE),
+        .IMG_OUT_SIZE(POOL_IMG_OUT_SIZE)
+    ) core (
+        .clk(clk),
+        .data_in_ready(core_data_in_ready),
+        .img_in(img_in),
+        .oc(cur_oc),
+        .incremental(incremental),
+        .dirty(dirty_pool),
+        .img_prev(core_prev),
+        .img_out(pool_img_out),
+        .data_out_ready(core_data_out_ready)
+    );
+  end else begin : core_gen
+    // the generic core behind a registered channel read of img_in
+    integer in_ch;
+    logic [CONV_IMG_IN_SIZE*CONV_IMG_IN_SIZE-1:0] in_data;
+    always_ff @(posedge clk) in_data <= img_in[in_ch];
+`endif
+  ConvPoolCore #(
       .IC(IC),
-      .IMG_IN_SIZE(CONV_IMG_IN_SIZE)
+      .IMG_IN_SIZE(CONV_IMG_IN_SIZE),
+      .CONV_IMG_OUT_SIZE(CONV_IMG_OUT_SIZE),
+      .IMG_OUT_SIZE(POOL_IMG_OUT_SIZE)
   ) core (
       .clk(clk),
       .data_in_ready(core_data_in_ready),
-      .img_in(img_in),
+      .ic_next(in_ch),
+      .img_ch(in_data),
       .weights(core_weight),
-      .img_out(core_img_out),
+      .incremental(incremental),
+      .dirty(dirty_pool),
+      .img_prev(core_prev),
+      .img_out(pool_img_out),
       .data_out_ready(core_data_out_ready)
   );
-
-  MaxPoolCore #(
-      .IMG_IN_SIZE(CONV_IMG_OUT_SIZE)
-  ) pool (
-      .img_in (core_img_out),
-      .img_out(pool_img_out)
-  );
+`ifdef CONV_SPECIALIZED
+  end
+`endif
 
 endmodule
 
@@ -0,0 +1,582 @@
+`ifndef CONVKERNELS_SV
+`define CONVKERNELS_SV
+// Weight-specialized conv kernels for ConvPoolCoreFixed, generated by
+// src/host/conv_specialize.cpp from the conv weights in bnn_top.sv.
+// Do not edit by hand.
+`timescale 1ns / 1ps
+
+module ConvKernel_conv1 (
+    input  logic [8:0] patch,  // tap ic*9+k, k = 3x3 row-major
+    output logic [15:0] fires   // one bit per output channel
+);
+
+  // oc 0: 9'h028
+  logic [8:0] match_0;
+  logic [7:0] count_0, sum_0;
+  assign match_0 = {
+    ~patch[8], ~patch[7], ~patch[6],  patch[5], ~patch[4],  patch[3], ~patch[2], ~patch[1], ~patch[0]
+  };
+  assign count_0 = 8'($countones(match_0));
+  assign sum_0 = (count_0 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[0] = ~sum_0[7];
+
+  // oc 1: 9'h1c4
+  logic [8:0] match_1;
+  logic [7:0] count_1, sum_1;
+  assign match_1 = {
+     patch[8],  patch[7],  patch[6], ~patch[5], ~patch[4], ~patch[3],  patch[2], ~patch[1], ~patch[0]
+  };
+  assign count_1 = 8'($countones(match_1));
+  assign sum_1 = (count_1 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[1] = ~sum_1[7];
+
+  // oc 2: 9'h17d
+  logic [8:0] match_2;
+  logic [7:0] count_2, sum_2;
+  assign match_2 = {
+     patch[8], ~patch[7],  patch[6],  patch[5],  patch[4],  patch[3],  patch[2], ~patch[1],  patch[0]
+  };
+  assign count_2 = 8'($countones(match_2));
+  assign sum_2 = (count_2 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[2] = ~sum_2[7];
+
+  // oc 3: 9'h1e2
+  logic [8:0] match_3;
+  logic [7:0] count_3, sum_3;
+  assign match_3 = {
+     patch[8],  patch[7],  patch[6],  patch[5], ~patch[4], ~patch[3], ~patch[2],  patch[1], ~patch[0]
+  };
+  assign count_3 = 8'($countones(match_3));
+  assign sum_3 = (count_3 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[3] = ~sum_3[7];
+
+  // oc 4: 9'h0af
+  logic [8:0] match_4;
+  logic [7:0] count_4, sum_4;
+  assign match_4 = {
+    ~patch[8],  patch[7], ~patch[6],  patch[5], ~patch[4],  patch[3],  patch[2],  patch[1],  patch[0]
+  };
+  assign count_4 = 8'($countones(match_4));
+  assign sum_4 = (count_4 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[4] = ~sum_4[7];
+
+  // oc 5: 9'h0b1
+  logic [8:0] match_5;
+  logic [7:0] count_5, sum_5;
+  assign match_5 = {
+    ~patch[8],  patch[7], ~patch[6],  patch[5],  patch[4], ~patch[3], ~patch[2], ~patch[1],  patch[0]
+  };
+  assign count_5 = 8'($countones(match_5));
+  assign sum_5 = (count_5 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[5] = ~sum_5[7];
+
+  // oc 6: 9'h0b5
+  logic [8:0] match_6;
+  logic [7:0] count_6, sum_6;
+  assign match_6 = {
+    ~patch[8],  patch[7], ~patch[6],  patch[5],  patch[4], ~patch[3],  patch[2], ~patch[1],  patch[0]
+  };
+  assign count_6 = 8'($countones(match_6));
+  assign sum_6 = (count_6 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[6] = ~sum_6[7];
+
+  // oc 7: 9'h1ca
+  logic [8:0] match_7;
+  logic [7:0] count_7, sum_7;
+  assign match_7 = {
+     patch[8],  patch[7],  patch[6], ~patch[5], ~patch[4],  patch[3], ~patch[2],  patch[1], ~patch[0]
+  };
+  assign count_7 = 8'($countones(match_7));
+  assign sum_7 = (count_7 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[7] = ~sum_7[7];
+
+  // oc 8: 9'h1b1
+  logic [8:0] match_8;
+  logic [7:0] count_8, sum_8;
+  assign match_8 = {
+     patch[8],  patch[7], ~patch[6],  patch[5],  patch[4], ~patch[3], ~patch[2], ~patch[1],  patch[0]
+  };
+  assign count_8 = 8'($countones(match_8));
+  assign sum_8 = (count_8 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[8] = ~sum_8[7];
+
+  // oc 9: 9'h079
+  logic [8:0] match_9;
+  logic [7:0] count_9, sum_9;
+  assign match_9 = {
+    ~patch[8], ~patch[7],  patch[6],  patch[5],  patch[4],  patch[3], ~patch[2], ~patch[1],  patch[0]
+  };
+  assign count_9 = 8'($countones(match_9));
+  assign sum_9 = (count_9 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[9] = ~sum_9[7];
+
+  // oc 10: 9'h06d
+  logic [8:0] match_10;
+  logic [7:0] count_10, sum_10;
+  assign match_10 = {
+    ~patch[8], ~patch[7],  patch[6],  patch[5], ~patch[4],  patch[3],  patch[2], ~patch[1],  patch[0]
+  };
+  assign count_10 = 8'($countones(match_10));
+  assign sum_10 = (count_10 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[10] = ~sum_10[7];
+
+  // oc 11: 9'h1d5
+  logic [8:0] match_11;
+  logic [7:0] count_11, sum_11;
+  assign match_11 = {
+     patch[8],  patch[7],  patch[6], ~patch[5],  patch[4], ~patch[3],  patch[2], ~patch[1],  patch[0]
+  };
+  assign count_11 = 8'($countones(match_11));
+  assign sum_11 = (count_11 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[11] = ~sum_11[7];
+
+  // oc 12: 9'h145
+  logic [8:0] match_12;
+  logic [7:0] count_12, sum_12;
+  assign match_12 = {
+     patch[8], ~patch[7],  patch[6], ~patch[5], ~patch[4], ~patch[3],  patch[2], ~patch[1],  patch[0]
+  };
+  assign count_12 = 8'($countones(match_12));
+  assign sum_12 = (count_12 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[12] = ~sum_12[7];
+
+  // oc 13: 9'h158
+  logic [8:0] match_13;
+  logic [7:0] count_13, sum_13;
+  assign match_13 = {
+     patch[8], ~patch[7],  patch[6], ~patch[5],  patch[4],  patch[3], ~patch[2], ~patch[1], ~patch[0]
+  };
+  assign count_13 = 8'($countones(match_13));
+  assign sum_13 = (count_13 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[13] = ~sum_13[7];
+
+  // oc 14: 9'h0a0
+  logic [8:0] match_14;
+  logic [7:0] count_14, sum_14;
+  assign match_14 = {
+    ~patch[8],  patch[7], ~patch[6],  patch[5], ~patch[4], ~patch[3], ~patch[2], ~patch[1], ~patch[0]
+  };
+  assign count_14 = 8'($countones(match_14));
+  assign sum_14 = (count_14 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[14] = ~sum_14[7];
+
+  // oc 15: 9'h11c
+  logic [8:0] match_15;
+  logic [7:0] count_15, sum_15;
+  assign match_15 = {
+     patch[8], ~patch[7], ~patch[6], ~patch[5],  patch[4],  patch[3],  patch[2], ~patch[1], ~patch[0]
+  };
+  assign count_15 = 8'($countones(match_15));
+  assign sum_15 = (count_15 << 1) - 8'd9;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[15] = ~sum_15[7];
+
+endmodule
+
+module ConvKernel_conv2 (
+    input  logic [143:0] patch,  // tap ic*9+k, k = 3x3 row-major
+    output logic [15:0] fires   // one bit per output channel
+);
+
+  // oc 0: 144'h984335a06929ef25208409fdd624c6748e9b
+  logic [143:0] match_0;
+  logic [7:0] count_0, sum_0;
+  assign match_0 = {
+     patch[143], ~patch[142], ~patch[141],  patch[140],  patch[139], ~patch[138], ~patch[137], ~patch[136], ~patch[135], 
+     patch[134], ~patch[133], ~patch[132], ~patch[131], ~patch[130],  patch[129],  patch[128], ~patch[127], ~patch[126], 
+     patch[125],  patch[124], ~patch[123],  patch[122], ~patch[121],  patch[120],  patch[119], ~patch[118],  patch[117], 
+    ~patch[116], ~patch[115], ~patch[114], ~patch[113], ~patch[112], ~patch[111],  patch[110],  patch[109], ~patch[108], 
+     patch[107], ~patch[106], ~patch[105],  patch[104], ~patch[103], ~patch[102],  patch[101], ~patch[100],  patch[99], 
+    ~patch[98], ~patch[97],  patch[96],  patch[95],  patch[94],  patch[93], ~patch[92],  patch[91],  patch[90], 
+     patch[89],  patch[88], ~patch[87], ~patch[86],  patch[85], ~patch[84], ~patch[83],  patch[82], ~patch[81], 
+     patch[80], ~patch[79], ~patch[78],  patch[77], ~patch[76], ~patch[75], ~patch[74], ~patch[73], ~patch[72], 
+     patch[71], ~patch[70], ~patch[69], ~patch[68], ~patch[67],  patch[66], ~patch[65], ~patch[64], ~patch[63], 
+    ~patch[62], ~patch[61], ~patch[60],  patch[59], ~patch[58], ~patch[57],  patch[56],  patch[55],  patch[54], 
+     patch[53],  patch[52],  patch[51],  patch[50], ~patch[49],  patch[48],  patch[47],  patch[46], ~patch[45], 
+     patch[44], ~patch[43],  patch[42],  patch[41], ~patch[40], ~patch[39], ~patch[38],  patch[37], ~patch[36], 
+    ~patch[35],  patch[34], ~patch[33], ~patch[32],  patch[31],  patch[30], ~patch[29], ~patch[28], ~patch[27], 
+     patch[26],  patch[25], ~patch[24], ~patch[23],  patch[22],  patch[21],  patch[20], ~patch[19],  patch[18], 
+    ~patch[17], ~patch[16],  patch[15], ~patch[14], ~patch[13], ~patch[12],  patch[11],  patch[10],  patch[9], 
+    ~patch[8],  patch[7], ~patch[6], ~patch[5],  patch[4],  patch[3], ~patch[2],  patch[1],  patch[0]
+  };
+  assign count_0 = 8'($countones(match_0));
+  assign sum_0 = (count_0 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[0] = ~sum_0[7];
+
+  // oc 1: 144'h68108466d749bd0212f066503bb9ca085040
+  logic [143:0] match_1;
+  logic [7:0] count_1, sum_1;
+  assign match_1 = {
+    ~patch[143],  patch[142],  patch[141], ~patch[140],  patch[139], ~patch[138], ~patch[137], ~patch[136], ~patch[135], 
+    ~patch[134], ~patch[133],  patch[132], ~patch[131], ~patch[130], ~patch[129], ~patch[128],  patch[127], ~patch[126], 
+    ~patch[125], ~patch[124], ~patch[123],  patch[122], ~patch[121], ~patch[120], ~patch[119],  patch[118],  patch[117], 
+    ~patch[116], ~patch[115],  patch[114],  patch[113], ~patch[112],  patch[111],  patch[110], ~patch[109],  patch[108], 
+    ~patch[107],  patch[106],  patch[105],  patch[104], ~patch[103],  patch[102], ~patch[101], ~patch[100],  patch[99], 
+    ~patch[98], ~patch[97],  patch[96],  patch[95], ~patch[94],  patch[93],  patch[92],  patch[91],  patch[90], 
+    ~patch[89],  patch[88], ~patch[87], ~patch[86], ~patch[85], ~patch[84], ~patch[83], ~patch[82],  patch[81], 
+    ~patch[80], ~patch[79], ~patch[78], ~patch[77],  patch[76], ~patch[75], ~patch[74],  patch[73], ~patch[72], 
+     patch[71],  patch[70],  patch[69],  patch[68], ~patch[67], ~patch[66], ~patch[65], ~patch[64], ~patch[63], 
+     patch[62],  patch[61], ~patch[60], ~patch[59],  patch[58],  patch[57], ~patch[56], ~patch[55],  patch[54], 
+    ~patch[53],  patch[52], ~patch[51], ~patch[50], ~patch[49], ~patch[48], ~patch[47], ~patch[46],  patch[45], 
+     patch[44],  patch[43], ~patch[42],  patch[41],  patch[40],  patch[39], ~patch[38],  patch[37],  patch[36], 
+     patch[35], ~patch[34], ~patch[33],  patch[32],  patch[31],  patch[30], ~patch[29], ~patch[28],  patch[27], 
+    ~patch[26],  patch[25], ~patch[24], ~patch[23], ~patch[22], ~patch[21], ~patch[20],  patch[19], ~patch[18], 
+    ~patch[17], ~patch[16], ~patch[15],  patch[14], ~patch[13],  patch[12], ~patch[11], ~patch[10], ~patch[9], 
+    ~patch[8], ~patch[7],  patch[6], ~patch[5], ~patch[4], ~patch[3], ~patch[2], ~patch[1], ~patch[0]
+  };
+  assign count_1 = 8'($countones(match_1));
+  assign sum_1 = (count_1 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[1] = ~sum_1[7];
+
+  // oc 2: 144'h8768853822e3d825008e080023c3e4701620
+  logic [143:0] match_2;
+  logic [7:0] count_2, sum_2;
+  assign match_2 = {
+     patch[143], ~patch[142], ~patch[141], ~patch[140], ~patch[139],  patch[138],  patch[137],  patch[136], ~patch[135], 
+     patch[134],  patch[133], ~patch[132],  patch[131], ~patch[130], ~patch[129], ~patch[128],  patch[127], ~patch[126], 
+    ~patch[125], ~patch[124], ~patch[123],  patch[122], ~patch[121],  patch[120], ~patch[119], ~patch[118],  patch[117], 
+     patch[116],  patch[115], ~patch[114], ~patch[113], ~patch[112], ~patch[111], ~patch[110],  patch[109], ~patch[108], 
+    ~patch[107], ~patch[106],  patch[105], ~patch[104],  patch[103],  patch[102],  patch[101], ~patch[100], ~patch[99], 
+    ~patch[98],  patch[97],  patch[96],  patch[95],  patch[94], ~patch[93],  patch[92],  patch[91], ~patch[90], 
+    ~patch[89], ~patch[88], ~patch[87], ~patch[86],  patch[85], ~patch[84], ~patch[83],  patch[82], ~patch[81], 
+     patch[80], ~patch[79], ~patch[78], ~patch[77], ~patch[76], ~patch[75], ~patch[74], ~patch[73], ~patch[72], 
+     patch[71], ~patch[70], ~patch[69], ~patch[68],  patch[67],  patch[66],  patch[65], ~patch[64], ~patch[63], 
+    ~patch[62], ~patch[61], ~patch[60],  patch[59], ~patch[58], ~patch[57], ~patch[56], ~patch[55], ~patch[54], 
+    ~patch[53], ~patch[52], ~patch[51], ~patch[50], ~patch[49], ~patch[48], ~patch[47], ~patch[46],  patch[45], 
+    ~patch[44], ~patch[43], ~patch[42],  patch[41],  patch[40],  patch[39],  patch[38], ~patch[37], ~patch[36], 
+    ~patch[35], ~patch[34],  patch[33],  patch[32],  patch[31],  patch[30],  patch[29], ~patch[28], ~patch[27], 
+     patch[26], ~patch[25], ~patch[24], ~patch[23],  patch[22],  patch[21],  patch[20], ~patch[19], ~patch[18], 
+    ~patch[17], ~patch[16], ~patch[15], ~patch[14], ~patch[13],  patch[12], ~patch[11],  patch[10],  patch[9], 
+    ~patch[8], ~patch[7], ~patch[6],  patch[5], ~patch[4], ~patch[3], ~patch[2], ~patch[1], ~patch[0]
+  };
+  assign count_2 = 8'($countones(match_2));
+  assign sum_2 = (count_2 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[2] = ~sum_2[7];
+
+  // oc 3: 144'h179df335e6a6dbec6b6c87c5cab6884c9c82
+  logic [143:0] match_3;
+  logic [7:0] count_3, sum_3;
+  assign match_3 = {
+    ~patch[143], ~patch[142], ~patch[141],  patch[140], ~patch[139],  patch[138],  patch[137],  patch[136],  patch[135], 
+    ~patch[134], ~patch[133],  patch[132],  patch[131],  patch[130], ~patch[129],  patch[128],  patch[127],  patch[126], 
+     patch[125],  patch[124], ~patch[123], ~patch[122],  patch[121],  patch[120], ~patch[119], ~patch[118],  patch[117], 
+     patch[116], ~patch[115],  patch[114], ~patch[113],  patch[112],  patch[111],  patch[110],  patch[109], ~patch[108], 
+    ~patch[107],  patch[106],  patch[105], ~patch[104],  patch[103], ~patch[102],  patch[101], ~patch[100], ~patch[99], 
+     patch[98],  patch[97], ~patch[96],  patch[95],  patch[94], ~patch[93],  patch[92],  patch[91], ~patch[90], 
+     patch[89],  patch[88],  patch[87],  patch[86],  patch[85], ~patch[84],  patch[83],  patch[82], ~patch[81], 
+    ~patch[80], ~patch[79],  patch[78],  patch[77], ~patch[76],  patch[75], ~patch[74],  patch[73],  patch[72], 
+    ~patch[71],  patch[70],  patch[69], ~patch[68],  patch[67],  patch[66], ~patch[65], ~patch[64],  patch[63], 
+    ~patch[62], ~patch[61], ~patch[60], ~patch[59],  patch[58],  patch[57],  patch[56],  patch[55],  patch[54], 
+    ~patch[53], ~patch[52], ~patch[51],  patch[50], ~patch[49],  patch[48],  patch[47],  patch[46], ~patch[45], 
+    ~patch[44],  patch[43], ~patch[42],  patch[41], ~patch[40],  patch[39], ~patch[38],  patch[37],  patch[36], 
+    ~patch[35],  patch[34],  patch[33], ~patch[32],  patch[31], ~patch[30], ~patch[29], ~patch[28],  patch[27], 
+    ~patch[26], ~patch[25], ~patch[24], ~patch[23],  patch[22], ~patch[21], ~patch[20],  patch[19],  patch[18], 
+    ~patch[17], ~patch[16],  patch[15], ~patch[14], ~patch[13],  patch[12],  patch[11],  patch[10], ~patch[9], 
+    ~patch[8],  patch[7], ~patch[6], ~patch[5], ~patch[4], ~patch[3], ~patch[2],  patch[1], ~patch[0]
+  };
+  assign count_3 = 8'($countones(match_3));
+  assign sum_3 = (count_3 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[3] = ~sum_3[7];
+
+  // oc 4: 144'h7515da842de59a4cefa267e1f5fd3949be1b
+  logic [143:0] match_4;
+  logic [7:0] count_4, sum_4;
+  assign match_4 = {
+    ~patch[143],  patch[142],  patch[141],  patch[140], ~patch[139],  patch[138], ~patch[137],  patch[136], ~patch[135], 
+    ~patch[134], ~patch[133],  patch[132], ~patch[131],  patch[130], ~patch[129],  patch[128],  patch[127],  patch[126], 
+    ~patch[125],  patch[124],  patch[123], ~patch[122],  patch[121], ~patch[120],  patch[119], ~patch[118], ~patch[117], 
+    ~patch[116], ~patch[115],  patch[114], ~patch[113], ~patch[112], ~patch[111], ~patch[110],  patch[109], ~patch[108], 
+     patch[107],  patch[106], ~patch[105],  patch[104],  patch[103],  patch[102],  patch[101], ~patch[100], ~patch[99], 
+     patch[98], ~patch[97],  patch[96],  patch[95], ~patch[94], ~patch[93],  patch[92],  patch[91], ~patch[90], 
+     patch[89], ~patch[88], ~patch[87],  patch[86], ~patch[85], ~patch[84],  patch[83],  patch[82], ~patch[81], 
+    ~patch[80],  patch[79],  patch[78],  patch[77], ~patch[76],  patch[75],  patch[74],  patch[73],  patch[72], 
+     patch[71], ~patch[70],  patch[69], ~patch[68], ~patch[67], ~patch[66],  patch[65], ~patch[64], ~patch[63], 
+     patch[62],  patch[61], ~patch[60], ~patch[59],  patch[58],  patch[57],  patch[56],  patch[55],  patch[54], 
+     patch[53], ~patch[52], ~patch[51], ~patch[50], ~patch[49],  patch[48],  patch[47],  patch[46],  patch[45], 
+     patch[44], ~patch[43],  patch[42], ~patch[41],  patch[40],  patch[39],  patch[38],  patch[37],  patch[36], 
+     patch[35],  patch[34], ~patch[33],  patch[32], ~patch[31], ~patch[30],  patch[29],  patch[28],  patch[27], 
+    ~patch[26], ~patch[25],  patch[24], ~patch[23],  patch[22], ~patch[21], ~patch[20],  patch[19], ~patch[18], 
+    ~patch[17],  patch[16],  patch[15], ~patch[14],  patch[13],  patch[12],  patch[11],  patch[10],  patch[9], 
+    ~patch[8], ~patch[7], ~patch[6], ~patch[5],  patch[4],  patch[3], ~patch[2],  patch[1],  patch[0]
+  };
+  assign count_4 = 8'($countones(match_4));
+  assign sum_4 = (count_4 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[4] = ~sum_4[7];
+
+  // oc 5: 144'h068ae471f7e1e7e9fced5c121dabc6077c03
+  logic [143:0] match_5;
+  logic [7:0] count_5, sum_5;
+  assign match_5 = {
+    ~patch[143], ~patch[142], ~patch[141], ~patch[140], ~patch[139],  patch[138],  patch[137], ~patch[136],  patch[135], 
+    ~patch[134], ~patch[133], ~patch[132],  patch[131], ~patch[130],  patch[129], ~patch[128],  patch[127],  patch[126], 
+     patch[125], ~patch[124], ~patch[123],  patch[122], ~patch[121], ~patch[120], ~patch[119],  patch[118],  patch[117], 
+     patch[116], ~patch[115], ~patch[114], ~patch[113],  patch[112],  patch[111],  patch[110],  patch[109],  patch[108], 
+    ~patch[107],  patch[106],  patch[105],  patch[104],  patch[103],  patch[102],  patch[101], ~patch[100], ~patch[99], 
+    ~patch[98], ~patch[97],  patch[96],  patch[95],  patch[94],  patch[93], ~patch[92], ~patch[91],  patch[90], 
+     patch[89],  patch[88],  patch[87],  patch[86],  patch[85], ~patch[84],  patch[83], ~patch[82], ~patch[81], 
+     patch[80],  patch[79],  patch[78],  patch[77],  patch[76],  patch[75],  patch[74], ~patch[73], ~patch[72], 
+     patch[71],  patch[70],  patch[69], ~patch[68],  patch[67],  patch[66], ~patch[65],  patch[64], ~patch[63], 
+     patch[62], ~patch[61],  patch[60],  patch[59],  patch[58], ~patch[57], ~patch[56], ~patch[55], ~patch[54], 
+    ~patch[53],  patch[52], ~patch[51], ~patch[50],  patch[49], ~patch[48], ~patch[47], ~patch[46], ~patch[45], 
+     patch[44],  patch[43],  patch[42], ~patch[41],  patch[40],  patch[39], ~patch[38],  patch[37], ~patch[36], 
+     patch[35], ~patch[34],  patch[33],  patch[32],  patch[31],  patch[30], ~patch[29], ~patch[28], ~patch[27], 
+     patch[26],  patch[25], ~patch[24], ~patch[23], ~patch[22], ~patch[21], ~patch[20], ~patch[19],  patch[18], 
+     patch[17],  patch[16], ~patch[15],  patch[14],  patch[13],  patch[12],  patch[11],  patch[10], ~patch[9], 
+    ~patch[8], ~patch[7], ~patch[6], ~patch[5], ~patch[4], ~patch[3], ~patch[2],  patch[1],  patch[0]
+  };
+  assign count_5 = 8'($countones(match_5));
+  assign sum_5 = (count_5 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[5] = ~sum_5[7];
+
+  // oc 6: 144'h942ef0d88693634c1f2d8d274c0802bb77af
+  logic [143:0] match_6;
+  logic [7:0] count_6, sum_6;
+  assign match_6 = {
+     patch[143], ~patch[142], ~patch[141],  patch[140], ~patch[139],  patch[138], ~patch[137], ~patch[136], ~patch[135], 
+    ~patch[134],  patch[133], ~patch[132],  patch[131],  patch[130],  patch[129], ~patch[128],  patch[127],  patch[126], 
+     patch[125],  patch[124], ~patch[123], ~patch[122], ~patch[121], ~patch[120],  patch[119],  patch[118], ~patch[117], 
+     patch[116],  patch[115], ~patch[114], ~patch[113], ~patch[112],  patch[111], ~patch[110], ~patch[109], ~patch[108], 
+    ~patch[107],  patch[106],  patch[105], ~patch[104],  patch[103], ~patch[102], ~patch[101],  patch[100], ~patch[99], 
+    ~patch[98],  patch[97],  patch[96], ~patch[95],  patch[94],  patch[93], ~patch[92], ~patch[91], ~patch[90], 
+     patch[89],  patch[88], ~patch[87],  patch[86], ~patch[85], ~patch[84],  patch[83],  patch[82], ~patch[81], 
+    ~patch[80], ~patch[79], ~patch[78], ~patch[77],  patch[76],  patch[75],  patch[74],  patch[73],  patch[72], 
+    ~patch[71], ~patch[70],  patch[69], ~patch[68],  patch[67],  patch[66], ~patch[65],  patch[64],  patch[63], 
+    ~patch[62], ~patch[61], ~patch[60],  patch[59],  patch[58], ~patch[57],  patch[56], ~patch[55], ~patch[54], 
+     patch[53], ~patch[52], ~patch[51],  patch[50],  patch[49],  patch[48], ~patch[47],  patch[46], ~patch[45], 
+    ~patch[44],  patch[43],  patch[42], ~patch[41], ~patch[40], ~patch[39], ~patch[38], ~patch[37], ~patch[36], 
+     patch[35], ~patch[34], ~patch[33], ~patch[32], ~patch[31], ~patch[30], ~patch[29], ~patch[28], ~patch[27], 
+    ~patch[26],  patch[25], ~patch[24],  patch[23], ~patch[22],  patch[21],  patch[20],  patch[19], ~patch[18], 
+     patch[17],  patch[16], ~patch[15],  patch[14],  patch[13],  patch[12], ~patch[11],  patch[10],  patch[9], 
+     patch[8],  patch[7], ~patch[6],  patch[5], ~patch[4],  patch[3],  patch[2],  patch[1],  patch[0]
+  };
+  assign count_6 = 8'($countones(match_6));
+  assign sum_6 = (count_6 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[6] = ~sum_6[7];
+
+  // oc 7: 144'h604e20512e026bb6f2d2b1831f1a97122b4e
+  logic [143:0] match_7;
+  logic [7:0] count_7, sum_7;
+  assign match_7 = {
+    ~patch[143],  patch[142],  patch[141], ~patch[140], ~patch[139], ~patch[138], ~patch[137], ~patch[136], ~patch[135], 
+     patch[134], ~patch[133], ~patch[132],  patch[131],  patch[130],  patch[129], ~patch[128], ~patch[127], ~patch[126], 
+     patch[125], ~patch[124], ~patch[123], ~patch[122], ~patch[121], ~patch[120], ~patch[119],  patch[118], ~patch[117], 
+     patch[116], ~patch[115], ~patch[114], ~patch[113],  patch[112], ~patch[111], ~patch[110],  patch[109], ~patch[108], 
+     patch[107],  patch[106],  patch[105], ~patch[104], ~patch[103], ~patch[102], ~patch[101], ~patch[100], ~patch[99], 
+    ~patch[98],  patch[97], ~patch[96], ~patch[95],  patch[94],  patch[93], ~patch[92],  patch[91], ~patch[90], 
+     patch[89],  patch[88],  patch[87], ~patch[86],  patch[85],  patch[84], ~patch[83],  patch[82],  patch[81], 
+    ~patch[80],  patch[79],  patch[78],  patch[77],  patch[76], ~patch[75], ~patch[74],  patch[73], ~patch[72], 
+     patch[71],  patch[70], ~patch[69],  patch[68], ~patch[67], ~patch[66],  patch[65], ~patch[64],  patch[63], 
+    ~patch[62],  patch[61],  patch[60], ~patch[59], ~patch[58], ~patch[57],  patch[56],  patch[55], ~patch[54], 
+    ~patch[53], ~patch[52], ~patch[51], ~patch[50],  patch[49],  patch[48], ~patch[47], ~patch[46], ~patch[45], 
+     patch[44],  patch[43],  patch[42],  patch[41],  patch[40], ~patch[39], ~patch[38], ~patch[37],  patch[36], 
+     patch[35], ~patch[34],  patch[33], ~patch[32],  patch[31], ~patch[30], ~patch[29],  patch[28], ~patch[27], 
+     patch[26],  patch[25],  patch[24], ~patch[23], ~patch[22], ~patch[21],  patch[20], ~patch[19], ~patch[18], 
+     patch[17], ~patch[16], ~patch[15], ~patch[14],  patch[13], ~patch[12],  patch[11], ~patch[10],  patch[9], 
+     patch[8], ~patch[7],  patch[6], ~patch[5], ~patch[4],  patch[3],  patch[2],  patch[1], ~patch[0]
+  };
+  assign count_7 = 8'($countones(match_7));
+  assign sum_7 = (count_7 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[7] = ~sum_7[7];
+
+  // oc 8: 144'h8f296b13a8527fff24fcba72e9b8f14780f6
+  logic [143:0] match_8;
+  logic [7:0] count_8, sum_8;
+  assign match_8 = {
+     patch[143], ~patch[142], ~patch[141], ~patch[140],  patch[139],  patch[138],  patch[137],  patch[136], ~patch[135], 
+    ~patch[134],  patch[133], ~patch[132],  patch[131], ~patch[130], ~patch[129],  patch[128], ~patch[127],  patch[126], 
+     patch[125], ~patch[124],  patch[123], ~patch[122],  patch[121],  patch[120], ~patch[119], ~patch[118], ~patch[117], 
+     patch[116], ~patch[115], ~patch[114],  patch[113],  patch[112],  patch[111], ~patch[110],  patch[109], ~patch[108], 
+     patch[107], ~patch[106], ~patch[105], ~patch[104], ~patch[103],  patch[102], ~patch[101],  patch[100], ~patch[99], 
+    ~patch[98],  patch[97], ~patch[96], ~patch[95],  patch[94],  patch[93],  patch[92],  patch[91],  patch[90], 
+     patch[89],  patch[88],  patch[87],  patch[86],  patch[85],  patch[84],  patch[83],  patch[82],  patch[81], 
+     patch[80], ~patch[79], ~patch[78],  patch[77], ~patch[76], ~patch[75],  patch[74], ~patch[73], ~patch[72], 
+     patch[71],  patch[70],  patch[69],  patch[68],  patch[67],  patch[66], ~patch[65], ~patch[64],  patch[63], 
+    ~patch[62],  patch[61],  patch[60],  patch[59], ~patch[58],  patch[57], ~patch[56], ~patch[55],  patch[54], 
+     patch[53],  patch[52], ~patch[51], ~patch[50],  patch[49], ~patch[48],  patch[47],  patch[46],  patch[45], 
+    ~patch[44],  patch[43], ~patch[42], ~patch[41],  patch[40],  patch[39], ~patch[38],  patch[37],  patch[36], 
+     patch[35], ~patch[34], ~patch[33], ~patch[32],  patch[31],  patch[30],  patch[29],  patch[28], ~patch[27], 
+    ~patch[26], ~patch[25],  patch[24], ~patch[23],  patch[22], ~patch[21], ~patch[20], ~patch[19],  patch[18], 
+     patch[17],  patch[16],  patch[15], ~patch[14], ~patch[13], ~patch[12], ~patch[11], ~patch[10], ~patch[9], 
+    ~patch[8],  patch[7],  patch[6],  patch[5],  patch[4], ~patch[3],  patch[2],  patch[1], ~patch[0]
+  };
+  assign count_8 = 8'($countones(match_8));
+  assign sum_8 = (count_8 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[8] = ~sum_8[7];
+
+  // oc 9: 144'h9c8edfc1d770273aee76300554bd01007901
+  logic [143:0] match_9;
+  logic [7:0] count_9, sum_9;
+  assign match_9 = {
+     patch[143], ~patch[142], ~patch[141],  patch[140],  patch[139],  patch[138], ~patch[137], ~patch[136],  patch[135], 
+    ~patch[134], ~patch[133], ~patch[132],  patch[131],  patch[130],  patch[129], ~patch[128],  patch[127],  patch[126], 
+    ~patch[125],  patch[124],  patch[123],  patch[122],  patch[121],  patch[120],  patch[119],  patch[118], ~patch[117], 
+    ~patch[116], ~patch[115], ~patch[114], ~patch[113],  patch[112],  patch[111],  patch[110], ~patch[109],  patch[108], 
+    ~patch[107],  patch[106],  patch[105],  patch[104], ~patch[103],  patch[102],  patch[101],  patch[100], ~patch[99], 
+    ~patch[98], ~patch[97], ~patch[96], ~patch[95], ~patch[94],  patch[93], ~patch[92], ~patch[91],  patch[90], 
+     patch[89],  patch[88], ~patch[87], ~patch[86],  patch[85],  patch[84],  patch[83], ~patch[82],  patch[81], 
+    ~patch[80],  patch[79],  patch[78],  patch[77], ~patch[76],  patch[75],  patch[74],  patch[73], ~patch[72], 
+    ~patch[71],  patch[70],  patch[69],  patch[68], ~patch[67],  patch[66],  patch[65], ~patch[64], ~patch[63], 
+    ~patch[62],  patch[61],  patch[60], ~patch[59], ~patch[58], ~patch[57], ~patch[56], ~patch[55], ~patch[54], 
+    ~patch[53], ~patch[52], ~patch[51],  patch[50], ~patch[49],  patch[48], ~patch[47],  patch[46], ~patch[45], 
+     patch[44], ~patch[43],  patch[42], ~patch[41], ~patch[40],  patch[39], ~patch[38],  patch[37],  patch[36], 
+     patch[35],  patch[34], ~patch[33],  patch[32], ~patch[31], ~patch[30], ~patch[29], ~patch[28], ~patch[27], 
+    ~patch[26], ~patch[25],  patch[24], ~patch[23], ~patch[22], ~patch[21], ~patch[20], ~patch[19], ~patch[18], 
+    ~patch[17], ~patch[16], ~patch[15],  patch[14],  patch[13],  patch[12],  patch[11], ~patch[10], ~patch[9], 
+     patch[8], ~patch[7], ~patch[6], ~patch[5], ~patch[4], ~patch[3], ~patch[2], ~patch[1],  patch[0]
+  };
+  assign count_9 = 8'($countones(match_9));
+  assign sum_9 = (count_9 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[9] = ~sum_9[7];
+
+  // oc 10: 144'h02e47a5db0eae65c9393c6ddc3f0c95eca80
+  logic [143:0] match_10;
+  logic [7:0] count_10, sum_10;
+  assign match_10 = {
+    ~patch[143], ~patch[142], ~patch[141], ~patch[140], ~patch[139], ~patch[138],  patch[137], ~patch[136],  patch[135], 
+     patch[134],  patch[133], ~patch[132], ~patch[131],  patch[130], ~patch[129], ~patch[128], ~patch[127],  patch[126], 
+     patch[125],  patch[124],  patch[123], ~patch[122],  patch[121], ~patch[120], ~patch[119],  patch[118], ~patch[117], 
+     patch[116],  patch[115],  patch[114], ~patch[113],  patch[112],  patch[111], ~patch[110],  patch[109],  patch[108], 
+    ~patch[107], ~patch[106], ~patch[105], ~patch[104],  patch[103],  patch[102],  patch[101], ~patch[100],  patch[99], 
+    ~patch[98],  patch[97], ~patch[96],  patch[95],  patch[94],  patch[93], ~patch[92], ~patch[91],  patch[90], 
+     patch[89], ~patch[88], ~patch[87],  patch[86], ~patch[85],  patch[84],  patch[83],  patch[82], ~patch[81], 
+    ~patch[80],  patch[79], ~patch[78], ~patch[77],  patch[76], ~patch[75], ~patch[74],  patch[73],  patch[72], 
+     patch[71], ~patch[70], ~patch[69],  patch[68], ~patch[67], ~patch[66],  patch[65],  patch[64],  patch[63], 
+     patch[62], ~patch[61], ~patch[60], ~patch[59],  patch[58],  patch[57], ~patch[56],  patch[55],  patch[54], 
+    ~patch[53],  patch[52],  patch[51],  patch[50], ~patch[49],  patch[48],  patch[47],  patch[46], ~patch[45], 
+    ~patch[44], ~patch[43], ~patch[42],  patch[41],  patch[40],  patch[39],  patch[38],  patch[37],  patch[36], 
+    ~patch[35], ~patch[34], ~patch[33], ~patch[32],  patch[31],  patch[30], ~patch[29], ~patch[28],  patch[27], 
+    ~patch[26], ~patch[25],  patch[24], ~patch[23],  patch[22], ~patch[21],  patch[20],  patch[19],  patch[18], 
+     patch[17], ~patch[16],  patch[15],  patch[14], ~patch[13], ~patch[12],  patch[11], ~patch[10],  patch[9], 
+    ~patch[8],  patch[7], ~patch[6], ~patch[5], ~patch[4], ~patch[3], ~patch[2], ~patch[1], ~patch[0]
+  };
+  assign count_10 = 8'($countones(match_10));
+  assign sum_10 = (count_10 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[10] = ~sum_10[7];
+
+  // oc 11: 144'h7d50100289b3d1364ac308060187301089bc
+  logic [143:0] match_11;
+  logic [7:0] count_11, sum_11;
+  assign match_11 = {
+    ~patch[143],  patch[142],  patch[141],  patch[140],  patch[139],  patch[138], ~patch[137],  patch[136], ~patch[135], 
+     patch[134], ~patch[133],  patch[132], ~patch[131], ~patch[130], ~patch[129], ~patch[128], ~patch[127], ~patch[126], 
+    ~patch[125],  patch[124], ~patch[123], ~patch[122], ~patch[121], ~patch[120], ~patch[119], ~patch[118], ~patch[117], 
+    ~patch[116], ~patch[115], ~patch[114],  patch[113], ~patch[112],  patch[111], ~patch[110], ~patch[109], ~patch[108], 
+     patch[107], ~patch[106], ~patch[105],  patch[104],  patch[103], ~patch[102],  patch[101],  patch[100], ~patch[99], 
+    ~patch[98],  patch[97],  patch[96],  patch[95],  patch[94], ~patch[93],  patch[92], ~patch[91], ~patch[90], 
+    ~patch[89],  patch[88], ~patch[87], ~patch[86],  patch[85],  patch[84], ~patch[83],  patch[82],  patch[81], 
+    ~patch[80], ~patch[79],  patch[78], ~patch[77], ~patch[76],  patch[75], ~patch[74],  patch[73], ~patch[72], 
+     patch[71],  patch[70], ~patch[69], ~patch[68], ~patch[67], ~patch[66],  patch[65],  patch[64], ~patch[63], 
+    ~patch[62], ~patch[61], ~patch[60],  patch[59], ~patch[58], ~patch[57], ~patch[56], ~patch[55], ~patch[54], 
+    ~patch[53], ~patch[52], ~patch[51],  patch[50],  patch[49], ~patch[48], ~patch[47], ~patch[46], ~patch[45], 
+    ~patch[44], ~patch[43], ~patch[42], ~patch[41],  patch[40],  patch[39], ~patch[38], ~patch[37], ~patch[36], 
+    ~patch[35],  patch[34],  patch[33],  patch[32], ~patch[31], ~patch[30],  patch[29],  patch[28], ~patch[27], 
+    ~patch[26], ~patch[25], ~patch[24], ~patch[23], ~patch[22], ~patch[21],  patch[20], ~patch[19], ~patch[18], 
+    ~patch[17], ~patch[16],  patch[15], ~patch[14], ~patch[13], ~patch[12],  patch[11], ~patch[10], ~patch[9], 
+     patch[8],  patch[7], ~patch[6],  patch[5],  patch[4],  patch[3],  patch[2], ~patch[1], ~patch[0]
+  };
+  assign count_11 = 8'($countones(match_11));
+  assign sum_11 = (count_11 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[11] = ~sum_11[7];
+
+  // oc 12: 144'hf2ffd0a10994db50c104100d407520dea2f8
+  logic [143:0] match_12;
+  logic [7:0] count_12, sum_12;
+  assign match_12 = {
+     patch[143],  patch[142],  patch[141],  patch[140], ~patch[139], ~patch[138],  patch[137], ~patch[136],  patch[135], 
+     patch[134],  patch[133],  patch[132],  patch[131],  patch[130],  patch[129],  patch[128],  patch[127],  patch[126], 
+    ~patch[125],  patch[124], ~patch[123], ~patch[122], ~patch[121], ~patch[120],  patch[119], ~patch[118],  patch[117], 
+    ~patch[116], ~patch[115], ~patch[114], ~patch[113],  patch[112], ~patch[111], ~patch[110], ~patch[109], ~patch[108], 
+     patch[107], ~patch[106], ~patch[105],  patch[104],  patch[103], ~patch[102], ~patch[101],  patch[100], ~patch[99], 
+     patch[98], ~patch[97], ~patch[96],  patch[95],  patch[94], ~patch[93],  patch[92],  patch[91], ~patch[90], 
+     patch[89],  patch[88], ~patch[87],  patch[86], ~patch[85],  patch[84], ~patch[83], ~patch[82], ~patch[81], 
+    ~patch[80],  patch[79],  patch[78], ~patch[77], ~patch[76], ~patch[75], ~patch[74], ~patch[73],  patch[72], 
+    ~patch[71], ~patch[70], ~patch[69], ~patch[68], ~patch[67],  patch[66], ~patch[65], ~patch[64], ~patch[63], 
+    ~patch[62], ~patch[61],  patch[60], ~patch[59], ~patch[58], ~patch[57], ~patch[56], ~patch[55], ~patch[54], 
+    ~patch[53], ~patch[52],  patch[51],  patch[50], ~patch[49],  patch[48], ~patch[47],  patch[46], ~patch[45], 
+    ~patch[44], ~patch[43], ~patch[42], ~patch[41], ~patch[40], ~patch[39],  patch[38],  patch[37],  patch[36], 
+    ~patch[35],  patch[34], ~patch[33],  patch[32], ~patch[31], ~patch[30],  patch[29], ~patch[28], ~patch[27], 
+    ~patch[26], ~patch[25], ~patch[24],  patch[23],  patch[22], ~patch[21],  patch[20],  patch[19],  patch[18], 
+     patch[17], ~patch[16],  patch[15], ~patch[14],  patch[13], ~patch[12], ~patch[11], ~patch[10],  patch[9], 
+    ~patch[8],  patch[7],  patch[6],  patch[5],  patch[4],  patch[3], ~patch[2], ~patch[1], ~patch[0]
+  };
+  assign count_12 = 8'($countones(match_12));
+  assign sum_12 = (count_12 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[12] = ~sum_12[7];
+
+  // oc 13: 144'h00ba3e10666819e0c1f984803fd01ac69d02
+  logic [143:0] match_13;
+  logic [7:0] count_13, sum_13;
+  assign match_13 = {
+    ~patch[143], ~patch[142], ~patch[141], ~patch[140], ~patch[139], ~patch[138], ~patch[137], ~patch[136],  patch[135], 
+    ~patch[134],  patch[133],  patch[132],  patch[131], ~patch[130],  patch[129], ~patch[128], ~patch[127], ~patch[126], 
+     patch[125],  patch[124],  patch[123],  patch[122],  patch[121], ~patch[120], ~patch[119], ~patch[118], ~patch[117], 
+     patch[116], ~patch[115], ~patch[114], ~patch[113], ~patch[112], ~patch[111],  patch[110],  patch[109], ~patch[108], 
+    ~patch[107],  patch[106],  patch[105], ~patch[104], ~patch[103],  patch[102],  patch[101], ~patch[100],  patch[99], 
+    ~patch[98], ~patch[97], ~patch[96], ~patch[95], ~patch[94], ~patch[93],  patch[92],  patch[91], ~patch[90], 
+    ~patch[89],  patch[88],  patch[87],  patch[86],  patch[85], ~patch[84], ~patch[83], ~patch[82], ~patch[81], 
+    ~patch[80],  patch[79],  patch[78], ~patch[77], ~patch[76], ~patch[75], ~patch[74], ~patch[73],  patch[72], 
+     patch[71],  patch[70],  patch[69],  patch[68],  patch[67], ~patch[66], ~patch[65],  patch[64],  patch[63], 
+    ~patch[62], ~patch[61], ~patch[60], ~patch[59],  patch[58], ~patch[57], ~patch[56],  patch[55], ~patch[54], 
+    ~patch[53], ~patch[52], ~patch[51], ~patch[50], ~patch[49], ~patch[48], ~patch[47], ~patch[46],  patch[45], 
+     patch[44],  patch[43],  patch[42],  patch[41],  patch[40],  patch[39],  patch[38], ~patch[37],  patch[36], 
+    ~patch[35], ~patch[34], ~patch[33], ~patch[32], ~patch[31], ~patch[30], ~patch[29],  patch[28],  patch[27], 
+    ~patch[26],  patch[25], ~patch[24],  patch[23],  patch[22], ~patch[21], ~patch[20], ~patch[19],  patch[18], 
+     patch[17], ~patch[16],  patch[15], ~patch[14], ~patch[13],  patch[12],  patch[11],  patch[10], ~patch[9], 
+     patch[8], ~patch[7], ~patch[6], ~patch[5], ~patch[4], ~patch[3], ~patch[2],  patch[1], ~patch[0]
+  };
+  assign count_13 = 8'($countones(match_13));
+  assign sum_13 = (count_13 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[13] = ~sum_13[7];
+
+  // oc 14: 144'h09eb9a03a85d5a100d42254c10277183d062
+  logic [143:0] match_14;
+  logic [7:0] count_14, sum_14;
+  assign match_14 = {
+    ~patch[143], ~patch[142], ~patch[141], ~patch[140],  patch[139], ~patch[138], ~patch[137],  patch[136],  patch[135], 
+     patch[134],  patch[133], ~patch[132],  patch[131], ~patch[130],  patch[129],  patch[128],  patch[127], ~patch[126], 
+    ~patch[125],  patch[124],  patch[123], ~patch[122],  patch[121], ~patch[120], ~patch[119], ~patch[118], ~patch[117], 
+    ~patch[116], ~patch[115], ~patch[114],  patch[113],  patch[112],  patch[111], ~patch[110],  patch[109], ~patch[108], 
+     patch[107], ~patch[106], ~patch[105], ~patch[104], ~patch[103],  patch[102], ~patch[101],  patch[100],  patch[99], 
+     patch[98], ~patch[97],  patch[96], ~patch[95],  patch[94], ~patch[93],  patch[92],  patch[91], ~patch[90], 
+     patch[89], ~patch[88], ~patch[87], ~patch[86], ~patch[85],  patch[84], ~patch[83], ~patch[82], ~patch[81], 
+    ~patch[80], ~patch[79], ~patch[78], ~patch[77], ~patch[76],  patch[75],  patch[74], ~patch[73],  patch[72], 
+    ~patch[71],  patch[70], ~patch[69], ~patch[68], ~patch[67], ~patch[66],  patch[65], ~patch[64], ~patch[63], 
+    ~patch[62],  patch[61], ~patch[60], ~patch[59],  patch[58], ~patch[57],  patch[56], ~patch[55],  patch[54], 
+    ~patch[53], ~patch[52],  patch[51],  patch[50], ~patch[49], ~patch[48], ~patch[47], ~patch[46], ~patch[45], 
+     patch[44], ~patch[43], ~patch[42], ~patch[41], ~patch[40], ~patch[39], ~patch[38],  patch[37], ~patch[36], 
+    ~patch[35],  patch[34],  patch[33],  patch[32], ~patch[31],  patch[30],  patch[29],  patch[28], ~patch[27], 
+    ~patch[26], ~patch[25],  patch[24],  patch[23], ~patch[22], ~patch[21], ~patch[20], ~patch[19], ~patch[18], 
+     patch[17],  patch[16],  patch[15],  patch[14], ~patch[13],  patch[12], ~patch[11], ~patch[10], ~patch[9], 
+    ~patch[8], ~patch[7],  patch[6],  patch[5], ~patch[4], ~patch[3], ~patch[2],  patch[1], ~patch[0]
+  };
+  assign count_14 = 8'($countones(match_14));
+  assign sum_14 = (count_14 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[14] = ~sum_14[7];
+
+  // oc 15: 144'h87a21004884c742e41665be8521c90db00c3
+  logic [143:0] match_15;
+  logic [7:0] count_15, sum_15;
+  assign match_15 = {
+     patch[143], ~patch[142], ~patch[141], ~patch[140], ~patch[139],  patch[138],  patch[137],  patch[136],  patch[135], 
+    ~patch[134],  patch[133], ~patch[132], ~patch[131], ~patch[130],  patch[129], ~patch[128], ~patch[127], ~patch[126], 
+    ~patch[125],  patch[124], ~patch[123], ~patch[122], ~patch[121], ~patch[120], ~patch[119], ~patch[118], ~patch[117], 
+    ~patch[116], ~patch[115],  patch[114], ~patch[113], ~patch[112],  patch[111], ~patch[110], ~patch[109], ~patch[108], 
+     patch[107], ~patch[106], ~patch[105], ~patch[104], ~patch[103],  patch[102], ~patch[101], ~patch[100],  patch[99], 
+     patch[98], ~patch[97], ~patch[96], ~patch[95],  patch[94],  patch[93],  patch[92], ~patch[91],  patch[90], 
+    ~patch[89], ~patch[88], ~patch[87], ~patch[86],  patch[85], ~patch[84],  patch[83],  patch[82],  patch[81], 
+    ~patch[80], ~patch[79],  patch[78], ~patch[77], ~patch[76], ~patch[75], ~patch[74], ~patch[73],  patch[72], 
+    ~patch[71],  patch[70],  patch[69], ~patch[68], ~patch[67],  patch[66],  patch[65], ~patch[64], ~patch[63], 
+     patch[62], ~patch[61],  patch[60],  patch[59], ~patch[58],  patch[57],  patch[56],  patch[55],  patch[54], 
+     patch[53], ~patch[52],  patch[51], ~patch[50], ~patch[49], ~patch[48], ~patch[47],  patch[46], ~patch[45], 
+     patch[44], ~patch[43], ~patch[42],  patch[41], ~patch[40], ~patch[39], ~patch[38], ~patch[37],  patch[36], 
+     patch[35],  patch[34], ~patch[33], ~patch[32],  patch[31], ~patch[30], ~patch[29],  patch[28], ~patch[27], 
+    ~patch[26], ~patch[25], ~patch[24],  patch[23],  patch[22], ~patch[21],  patch[20],  patch[19], ~patch[18], 
+     patch[17],  patch[16], ~patch[15], ~patch[14], ~patch[13], ~patch[12], ~patch[11], ~patch[10], ~patch[9], 
+    ~patch[8],  patch[7],  patch[6], ~patch[5], ~patch[4], ~patch[3], ~patch[2],  patch[1],  patch[0]
+  };
+  assign count_15 = 8'($countones(match_15));
+  assign sum_15 = (count_15 << 1) - 8'd144;  // +/-1 sum, wraps like ConvPoolCore's popcount
+  assign fires[15] = ~sum_15[7];
+
+endmodule
+
+`endif
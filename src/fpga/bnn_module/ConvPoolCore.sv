@@ -0,0 +1,143 @@
+`ifndef CONVPOOLCORE_SV
+`define CONVPOOLCORE_SV
+/*
+    fused binary convolution + 2x2 max-pool module
+    accepts binary input, performs xnor with binary weights
+        kenel_size = 3x3
+        padding = 0
+        stride = 1
+        pool = 2x2, stride 2
+
+    conv pixels are visited in pooling-window order; since pooling a binary
+    image is an OR, a window is settled as soon as one of its four conv
+    pixels fires and the remaining pixels of that window are skipped.
+    only the pooled image is kept, there is no full-resolution conv output.
+
+    in incremental mode the core starts from img_prev (the previous run's
+    output) and only recomputes the windows flagged in dirty; the others
+    are skipped in a single cycle.
+
+    the input image is read one channel at a time, so it can sit in block
+    RAM: ic_next is the channel needed in the next cycle and img_ch must
+    hold it one clock later (a registered read)
+*/
+`timescale 1ns / 1ps
+
+module ConvPoolCore #(
+    parameter int IC = 8,
+    parameter int IMG_IN_SIZE = 30,
+    parameter int CONV_IMG_OUT_SIZE = IMG_IN_SIZE - 2,
+    parameter int IMG_OUT_SIZE = CONV_IMG_OUT_SIZE / 2
+) (
+    input logic clk,
+    input logic data_in_ready,
+    output integer ic_next,
+    input logic [IMG_IN_SIZE*IMG_IN_SIZE-1:0] img_ch,
+    input logic [IC*9-1:0] weights,  // 3x3 kernel
+    input logic incremental,
+    input logic [IMG_OUT_SIZE*IMG_OUT_SIZE-1:0] dirty,
+    input logic [IMG_OUT_SIZE*IMG_OUT_SIZE-1:0] img_prev,
+    output logic [IMG_OUT_SIZE*IMG_OUT_SIZE-1:0] img_out,
+    output logic data_out_ready
+);
+
+  logic signed [7:0] popcount;
+  integer cur_ic, pool_row, pool_col, adder_count;
+  logic [1:0] quad;  // conv pixel inside the 2x2 window: {row, col}
+
+  // top-left input pixel of the conv window currently being accumulated
+  integer win_base;
+  integer tap_offset;
+
+  assign win_base = (2 * pool_row + quad[1]) * IMG_IN_SIZE + (2 * pool_col + quad[0]);
+
+  always_comb begin
+    case (adder_count)
+      0: tap_offset = 0;
+      1: tap_offset = 1;
+      2: tap_offset = 2;
+      3: tap_offset = IMG_IN_SIZE;
+      4: tap_offset = IMG_IN_SIZE + 1;
+      5: tap_offset = IMG_IN_SIZE + 2;
+      6: tap_offset = IMG_IN_SIZE * 2;
+      7: tap_offset = IMG_IN_SIZE * 2 + 1;
+      8: tap_offset = IMG_IN_SIZE * 2 + 2;
+      default: tap_offset = 0;
+    endcase
+  end
+
+  logic signed [7:0] patch_val;
+  always_comb begin
+    if (adder_count < 9)
+      patch_val = (img_ch[win_base+tap_offset] == weights[cur_ic*9+adder_count]) ? 8'sh01 : 8'shFF;
+    else patch_val = 0;
+  end
+
+  // the conv pixel just accumulated fires (same sign test as ConvCore)
+  logic pixel_fires;
+  assign pixel_fires = ~popcount[7];
+
+  integer win_ind;
+  assign win_ind = pool_row * IMG_OUT_SIZE + pool_col;
+
+  // window settled: either a pixel fired (early-out) or all four were 0
+  logic settle;
+  assign settle = (adder_count == 9) && (cur_ic == IC - 1) && (pixel_fires || quad == 2'd3);
+
+  // clean window in incremental mode, keep the previous output
+  logic skip_window;
+  assign skip_window = incremental && !dirty[win_ind];
+
+  always_comb begin
+    ic_next = cur_ic;
+    if (!data_in_ready) ic_next = 0;
+    else if (data_out_ready) ic_next = cur_ic;
+    else if (skip_window || settle) ic_next = 0;
+    else if (adder_count == 9) ic_next = (cur_ic == IC - 1) ? 0 : cur_ic + 1;
+  end
+
+  always_ff @(posedge clk) begin
+    cur_ic <= ic_next;
+    if (!data_in_ready) begin
+      img_out <= incremental ? img_prev : 0;
+      data_out_ready <= 0;
+      pool_row <= 0;
+      pool_col <= 0;
+      quad <= 0;
+      popcount <= 0;
+      adder_count <= 0;
+    end else if (data_out_ready) begin
+      data_out_ready <= 0;
+    end else begin
+      if (skip_window || settle) begin
+        if (settle) img_out[win_ind] <= pixel_fires;
+        adder_count <= 0;
+        popcount <= 0;
+        quad <= 0;
+        if (pool_col == IMG_OUT_SIZE - 1) begin
+          pool_col <= 0;
+          if (pool_row == IMG_OUT_SIZE - 1) begin
+            pool_row <= 0;
+            data_out_ready <= 1;
+          end else begin
+            pool_row <= pool_row + 1;
+          end
+        end else begin
+          pool_col <= pool_col + 1;
+        end
+      end else if (adder_count == 9) begin
+        adder_count <= 0;
+        if (cur_ic == IC - 1) begin
+          popcount <= 0;
+          quad <= quad + 1;
+        end
+      end else begin
+        popcount <= popcount + patch_val;
+        adder_count <= adder_count + 1;
+      end
+    end
+  end
+
+endmodule
+
+`endif
@@ -0,0 +1,112 @@
+`ifndef CONVPOOLCOREFIXED_SV
+`define CONVPOOLCOREFIXED_SV
+
+`ifndef SYNTHESIS
+`include "ConvKernels.sv"
+`endif
+/*
+    fused conv + 2x2 max-pool with the weights baked in (define CONV_SPECIALIZED)
+    same window walk, early-out and incremental behaviour as ConvPoolCore,
+    but a whole conv pixel is evaluated per cycle: the 3x3xIC patch goes
+    through ConvKernel_conv<LAYER> (generated by src/host/conv_specialize.cpp),
+    which has every output channel's xnor taps hard-wired, and oc picks the
+    channel. there are no weight reads or tap counters.
+*/
+`timescale 1ns / 1ps
+
+module ConvPoolCoreFixed #(
+    parameter int LAYER = 1,  // which generated kernel, ConvKernel_conv1/2
+    parameter int IC = 8,
+    parameter int OC = 16,
+    parameter int IMG_IN_SIZE = 30,
+    parameter int CONV_IMG_OUT_SIZE = IMG_IN_SIZE - 2,
+    parameter int IMG_OUT_SIZE = CONV_IMG_OUT_SIZE / 2
+) (
+    input logic clk,
+    input logic data_in_ready,
+    input logic [IMG_IN_SIZE*IMG_IN_SIZE-1:0] img_in[0:IC-1],
+    input int oc,
+    input logic incremental,
+    input logic [IMG_OUT_SIZE*IMG_OUT_SIZE-1:0] dirty,
+    input logic [IMG_OUT_SIZE*IMG_OUT_SIZE-1:0] img_prev,
+    output logic [IMG_OUT_SIZE*IMG_OUT_SIZE-1:0] img_out,
+    output logic data_out_ready
+);
+
+  integer pool_row, pool_col;
+  logic [1:0] quad;  // conv pixel inside the 2x2 window: {row, col}
+
+  // top-left input pixel of the conv window being evaluated
+  integer win_base;
+  assign win_base = (2 * pool_row + quad[1]) * IMG_IN_SIZE + (2 * pool_col + quad[0]);
+
+  logic [IC*9-1:0] patch;
+  always_comb begin
+    for (int ic = 0; ic < IC; ic = ic + 1) begin
+      for (int k = 0; k < 9; k = k + 1) begin
+        patch[ic*9+k] = img_in[ic][win_base+(k/3)*IMG_IN_SIZE+(k%3)];
+      end
+    end
+  end
+
+  logic [OC-1:0] fires;
+  generate
+    if (LAYER == 1) begin : kernel_gen
+      ConvKernel_conv1 kernel (
+          .patch(patch),
+          .fires(fires)
+      );
+    end else begin : kernel_gen
+      ConvKernel_conv2 kernel (
+          .patch(patch),
+          .fires(fires)
+      );
+    end
+  endgenerate
+
+  logic pixel_fires;
+  assign pixel_fires = fires[oc];
+
+  integer win_ind;
+  assign win_ind = pool_row * IMG_OUT_SIZE + pool_col;
+
+  // window settled: a pixel fired (early-out) or this was the last of the four
+  logic settle;
+  assign settle = pixel_fires || quad == 2'd3;
+
+  logic skip_window;
+  assign skip_window = incremental && !dirty[win_ind];
+
+  always_ff @(posedge clk) begin
+    if (!data_in_ready) begin
+      img_out <= incremental ? img_prev : 0;
+      data_out_ready <= 0;
+      pool_row <= 0;
+      pool_col <= 0;
+      quad <= 0;
+    end else if (data_out_ready) begin
+      data_out_ready <= 0;
+    end else begin
+      if (skip_window || settle) begin
+        if (!skip_window) img_out[win_ind] <= pixel_fires;
+        quad <= 0;
+        if (pool_col == IMG_OUT_SIZE - 1) begin
+          pool_col <= 0;
+          if (pool_row == IMG_OUT_SIZE - 1) begin
+            pool_row <= 0;
+            data_out_ready <= 1;
+          end else begin
+            pool_row <= pool_row + 1;
+          end
+        end else begin
+          pool_col <= pool_col + 1;
+        end
+      end else begin
+        quad <= quad + 1;
+      end
+    end
+  end
+
+endmodule
+
+`endif
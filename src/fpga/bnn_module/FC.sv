@@ -5,51 +5,190 @@
     expects inputs to have values in range {-1, 1}
 
     this layer is intended to use as the last layer for image classification
+
+    the sums are double-buffered like Conv2d_MaxPool2d's maps: out[] is the
+    published bank, which stays put from out_valid until out_ready, and a
+    full run writes the other bank meanwhile. in holds still from in_valid
+    until in_ready, which pulses on the last cycle of the run.
+
+    in incremental mode out[] still holds the previous run's sums, and only
+    inputs that flipped since then are visited: each flip adds +/-2*weight
+    to every class (16-bit wrap-around makes this exact). such a run only
+    comes once out[] has been taken (bnn_top runs incremental jobs on their
+    own), so it updates the published bank in place; a full run writes every
+    class anyway
+
+    the weights are read one word per cycle from block RAM outside the
+    module: weight_addr is the index needed in the next cycle, and
+    weight_data must return that word one clock later (a registered read)
+
+    with EARLY_EXIT, bound[oc*BOUND_CHECKS + k] is the sum of |weight| of
+    class oc over inputs k*BOUND_STRIDE onwards (src/host/fc_bounds.cpp).
+    every BOUND_STRIDE inputs, a class whose sum can no longer exceed the
+    best finished class (without wrapping) stops there: its out[] gets that
+    upper bound, which is still no greater than the best, so Comparator
+    picks the same class as after a full pass. early_exit is low for
+    weights the bounds do not describe, and an incremental run after a run
+    that stopped classes early recomputes everything
 */
 `timescale 1ns / 1ps
 module FC#(
     parameter int IC = 288,
-    parameter int OC = 10
+    parameter int OC = 10,
+    parameter bit EARLY_EXIT = 0,
+    parameter int BOUND_STRIDE = 32,
+    parameter int BOUND_CHECKS = (IC + BOUND_STRIDE - 1) / BOUND_STRIDE
 )(
     input logic clk,
-    input logic data_in_ready,
+    input logic clear,
+    input logic in_valid,
+    output logic in_ready,
     input logic [IC-1:0] in,
-    input logic signed [15:0] weights [0:IC*OC-1],
+    input logic incremental,
+    output logic [$clog2(IC*OC)-1:0] weight_addr,
+    input logic signed [15:0] weight_data,
+    input logic early_exit,
+    input logic [31:0] bound [0:OC*BOUND_CHECKS-1],
     output logic signed [15:0] out [0:OC-1],
-    output logic data_out_ready
+    output logic out_valid,
+    input logic out_ready
 );
 
     integer cur_ic;
     integer cur_oc;
     integer weights_ind;
+    integer weights_ind_next;
     logic signed [15:0] temp_out;
+    logic [IC-1:0] prev_in;
+
+    integer part;                 // temp_out without the 16-bit wrap
+    integer part_bound;
+    logic signed [15:0] best;     // highest out[] of the classes finished so far
+    logic best_valid;
+    logic cut;                    // stop the current class here
+    logic cut_any;
+    logic out_cut = 1'b0;         // out[] holds bounds from the last run
+    logic incr_run;
+
+    assign incr_run = incremental && !(EARLY_EXIT && out_cut);
+
+    logic signed [15:0] sum0 [0:OC-1];
+    logic signed [15:0] sum1 [0:OC-1];
+    logic bank = 0;                // published bank, on out[]
+    logic running = 0;
+    logic pending = 0;             // finished full run waiting for out[] to be taken
+    logic start;
+    logic finish;
+    logic publish;
+
+    always_comb
+        for (int i = 0; i < OC; i = i + 1) out[i] = bank ? sum1[i] : sum0[i];
+
+    assign start = in_valid && !running && !pending && !clear;
+    assign finish = running && (incr_run ? cur_ic == IC : cur_oc == OC);
+    assign in_ready = finish;
+    assign publish = (finish || pending) && (!out_valid || out_ready);
+
+    always_comb begin
+        cut = 0;
+        part_bound = 0;
+        if (EARLY_EXIT && early_exit && running && !incr_run && best_valid
+                && cur_oc < OC && cur_ic < IC && cur_ic % BOUND_STRIDE == 0) begin
+            part_bound = part + int'(bound[cur_oc*BOUND_CHECKS + cur_ic/BOUND_STRIDE]);
+            cut = part_bound <= best
+                && part - int'(bound[cur_oc*BOUND_CHECKS + cur_ic/BOUND_STRIDE]) >= -32768;
+        end
+    end
+
+    // weights_ind of the next cycle, which is the word to prefetch
+    always_comb begin
+        weights_ind_next = weights_ind;
+        if (!running)
+            weights_ind_next = 0;
+        else if (incr_run) begin
+            if (cur_ic == IC) begin end
+            else if (in[cur_ic] == prev_in[cur_ic] || cur_oc == OC-1)
+                weights_ind_next = cur_ic + 1;
+            else
+                weights_ind_next = weights_ind + IC;
+        end
+        else if (cut || cur_ic == IC)
+            weights_ind_next = (cur_oc+1)*IC;
+        else
+            weights_ind_next = weights_ind + 1;
+    end
+
+    assign weight_addr = weights_ind_next[$clog2(IC*OC)-1:0];
 
     always_ff @(posedge clk) begin
-        if (!data_in_ready) begin
+        if (clear) begin
+            running <= 0;
+            pending <= 0;
+            out_valid <= 0;
+        end else begin
+            if (start) running <= 1;
+            else if (finish) running <= 0;
+            pending <= (finish || pending) && !publish;
+            if (publish) out_valid <= 1;
+            else if (out_ready) out_valid <= 0;
+            // an incremental run has already written the published bank
+            if (publish && !(finish && incr_run)) bank <= !bank;
+        end
+    end
+
+    always_ff @(posedge clk) begin
+        weights_ind <= weights_ind_next;
+        if (!running) begin
             cur_oc <= 0;
             cur_ic <= 0;
-            weights_ind <= 0;
             temp_out <= 0;
-            data_out_ready <= 0;
-            for (int i=0; i<OC; i=i+1) begin
-                out[i] <= 0;
+            part <= 0;
+            best_valid <= 0;
+            cut_any <= 0;
+        end
+        else if (incr_run) begin
+            if (cur_ic == IC) begin
+                prev_in <= in;
+            end else if (in[cur_ic] == prev_in[cur_ic]) begin
+                cur_ic <= cur_ic + 1;
+            end else begin
+                if (bank) sum1[cur_oc] <= out[cur_oc] + ((in[cur_ic])?(weight_data<<<1):-(weight_data<<<1));
+                else sum0[cur_oc] <= out[cur_oc] + ((in[cur_ic])?(weight_data<<<1):-(weight_data<<<1));
+                if (cur_oc == OC-1) begin
+                    cur_oc <= 0;
+                    cur_ic <= cur_ic + 1;
+                end else begin
+                    cur_oc <= cur_oc + 1;
+                end
             end
         end
-        else if (data_out_ready) begin end
         else begin
-            if (cur_ic == IC) begin
+            if (cut) begin
+                cur_ic <= 0;
+                cur_oc <= cur_oc + 1;
+                if (bank) sum0[cur_oc] <= part_bound[15:0];
+                else sum1[cur_oc] <= part_bound[15:0];
+                temp_out <= 0;
+                part <= 0;
+                cut_any <= 1;
+            end else if (cur_ic == IC) begin
                 cur_ic <= 0;
                 cur_oc <= cur_oc + 1;
-                weights_ind <= (cur_oc+1)*IC;
-                out[cur_oc] <= temp_out;
+                if (bank) sum0[cur_oc] <= temp_out;
+                else sum1[cur_oc] <= temp_out;
                 temp_out <= 0;
+                part <= 0;
+                if (!best_valid || temp_out > best)
+                    best <= temp_out;
+                best_valid <= 1;
             end else begin
                 cur_ic <= cur_ic + 1;
-                temp_out <= temp_out + ((in[cur_ic])?weights[weights_ind]:-weights[weights_ind]);
-                weights_ind <= weights_ind + 1;
+                temp_out <= temp_out + ((in[cur_ic])?weight_data:-weight_data);
+                part <= part + ((in[cur_ic])?weight_data:-weight_data);
             end
             if (cur_oc == OC) begin
-                data_out_ready <= 1;
+                prev_in <= in;
+                out_cut <= cut_any;
             end
         end
     end
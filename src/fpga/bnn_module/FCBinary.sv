@@ -0,0 +1,118 @@
+/*
+    binarized fully-connected layer, drop-in for FC (define FC_BINARY)
+    weights are 1 bit (the sign of the Q8.8 weight), packed WORD to an entry,
+    plus a per-class Q8.8 scale and a bias:
+
+        out[oc] = sat16(((scale[oc] * (2*agree - IC)) >>> 8) + bias[oc])
+
+    where agree counts the inputs that match their weight bit (xnor-popcount),
+    one WORD-wide slice per cycle. IC must be a multiple of WORD.
+
+    a full pass is only OC*(IC/WORD+1) cycles, so incremental re-runs simply
+    recompute everything. tables come from src/host/fc_binarize.cpp
+
+    same handshake and double-buffered out[] as FC
+*/
+`timescale 1ns / 1ps
+module FCBinary#(
+    parameter int IC = 288,
+    parameter int OC = 10,
+    parameter int WORD = 32,
+    parameter int WORDS = IC / WORD
+)(
+    input logic clk,
+    input logic clear,
+    input logic in_valid,
+    output logic in_ready,
+    input logic [IC-1:0] in,
+    input logic [WORD-1:0] weights [0:OC*WORDS-1],
+    input logic signed [15:0] scale [0:OC-1],
+    input logic signed [15:0] bias [0:OC-1],
+    output logic signed [15:0] out [0:OC-1],
+    output logic out_valid,
+    input logic out_ready
+);
+
+    integer cur_word;
+    integer cur_oc;
+    integer weights_ind;
+    integer agree;
+
+    logic [WORD-1:0] match;
+    integer match_count;
+    integer dot;
+    integer scaled;
+
+    assign match = ~(in[cur_word*WORD +: WORD] ^ weights[weights_ind]);
+
+    always_comb begin
+        match_count = 0;
+        for (int b = 0; b < WORD; b = b + 1) begin
+            match_count = match_count + match[b];
+        end
+    end
+
+    assign dot = 2 * agree - IC;
+    assign scaled = ((scale[cur_oc] * dot) >>> 8) + bias[cur_oc];
+
+    function automatic logic signed [15:0] sat16(input integer v);
+        if (v > 32767) return 16'sh7fff;
+        else if (v < -32768) return 16'sh8000;
+        else return v[15:0];
+    endfunction
+
+    logic signed [15:0] sum0 [0:OC-1];
+    logic signed [15:0] sum1 [0:OC-1];
+    logic bank = 0;                // published bank, on out[]
+    logic running = 0;
+    logic pending = 0;             // finished run waiting for out[] to be taken
+    logic start;
+    logic finish;
+    logic publish;
+
+    always_comb
+        for (int i = 0; i < OC; i = i + 1) out[i] = bank ? sum1[i] : sum0[i];
+
+    assign start = in_valid && !running && !pending && !clear;
+    assign finish = running && cur_oc == OC;
+    assign in_ready = finish;
+    assign publish = (finish || pending) && (!out_valid || out_ready);
+
+    always_ff @(posedge clk) begin
+        if (clear) begin
+            running <= 0;
+            pending <= 0;
+            out_valid <= 0;
+        end else begin
+            if (start) running <= 1;
+            else if (finish) running <= 0;
+            pending <= (finish || pending) && !publish;
+            if (publish) out_valid <= 1;
+            else if (out_ready) out_valid <= 0;
+            if (publish) bank <= !bank;
+        end
+    end
+
+    always_ff @(posedge clk) begin
+        if (!running) begin
+            cur_oc <= 0;
+            cur_word <= 0;
+            weights_ind <= 0;
+            agree <= 0;
+        end
+        else if (cur_oc == OC) begin end
+        else if (cur_word == WORDS) begin
+            if (bank) sum0[cur_oc] <= sat16(scaled);
+            else sum1[cur_oc] <= sat16(scaled);
+            agree <= 0;
+            cur_word <= 0;
+            cur_oc <= cur_oc + 1;
+        end
+        else begin
+            agree <= agree + match_count;
+            cur_word <= cur_word + 1;
+            weights_ind <= weights_ind + 1;
+        end
+    end
+
+endmodule
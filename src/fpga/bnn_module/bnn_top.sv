@@ -4,6 +4,7 @@
 `ifndef SYNTHESIS
 `include "Conv2d_MaxPool2d.sv"
 `include "FC.sv"
+`include "FCBinary.sv"
 `include "Comparator.sv"
 `endif
 `timescale 1ns / 1ps
@@ -23,12 +24,35 @@ module bnn_top #(
 ) (
     input logic [CONV1_IMG_IN_SIZE*CONV1_IMG_IN_SIZE-1:0] conv1_img_in[0:CONV1_IC-1],
     input logic clk,
-    input logic data_in_ready,
+    input logic clear,  // drop every job in the layers
+    // A job (conv1_img_in, incremental, dirty_in) stays put from in_valid
+    // until in_ready, which comes once conv1 is done with it; the layers
+    // behind it may still be working on earlier jobs. Results come out in
+    // order and stay on `result` from out_valid until out_ready.
+    input logic in_valid,
+    output logic in_ready,
+    // re-run on an image that differs from the previous one only at dirty_in
+    input logic incremental,
+    input logic [CONV1_IMG_IN_SIZE*CONV1_IMG_IN_SIZE-1:0] dirty_in,
     output logic [OUTPUT_BIT-1:0] result,
-    output logic data_out_ready
+    output logic out_valid,
+    input logic out_ready,
+    // Runtime weight upload (weight_loader): the BNN computes with
+    // weight_bank, writes go to the other bank
+    input logic weight_bank,
+    input logic weight_wr_en,
+    input logic [13:0] weight_wr_addr,
+    input logic [7:0] weight_wr_data,
+    // Simulation debug log: job events are logged only while this is high,
+    // like debug_module's records
+    input logic debug_enable
 );
   // assign conv1_img_in = img_in;
-  (* rom_style = "block" *)
+`ifdef BNN_WEIGHTS_FILE
+  // Weights for another network shape (bnn_sweep): same three arrays,
+  // sized from the parameters
+  `include `BNN_WEIGHTS_FILE
+`else
   logic [CONV1_IC*9-1:0] conv1_weights[0:CONV1_OC-1] = {
     9'h28,
     9'h1c4,
@@ -47,7 +71,6 @@ module bnn_top #(
     9'ha0,
     9'h11c
   };
-  (* rom_style = "block" *)
   logic [CONV1_OC*9-1:0] conv2_weights[0:CONV2_OC-1] = {
     144'h984335a06929ef25208409fdd624c6748e9b,
     144'h68108466d749bd0212f066503bb9ca085040,
@@ -66,7 +89,7 @@ module bnn_top #(
     144'h9eb9a03a85d5a100d42254c10277183d062,
     144'h87a21004884c742e41665be8521c90db00c3
   };
-  (* rom_style = "block" *)
+  (* ram_style = "block" *)
   logic signed [15:0] fc_weights[0:FC_IC*FC_OC-1] = {
     16'h0,
     16'hffe7,
@@ -5829,6 +5852,103 @@ module bnn_top #(
     16'hffe6,
     16'ha
   };
+`endif
+  // Second weight bank, filled by a runtime upload. The arrays above are
+  // bank 0 and hold the weights the bitstream boots with. The conv kernels
+  // of every channel are used in parallel through conv1_active and
+  // conv2_active, so those stay in registers; only FC's are block RAM.
+  logic [CONV1_IC*9-1:0] conv1_weights_b1[0:CONV1_OC-1];
+  logic [CONV1_OC*9-1:0] conv2_weights_b1[0:CONV2_OC-1];
+  (* ram_style = "block" *)
+  logic signed [15:0] fc_weights_b1[0:FC_IC*FC_OC-1];
+
+  logic [CONV1_IC*9-1:0] conv1_active[0:CONV1_OC-1];
+  logic [CONV1_OC*9-1:0] conv2_active[0:CONV2_OC-1];
+
+  always_comb begin
+    for (int i = 0; i < CONV1_OC; i++) conv1_active[i] = weight_bank ? conv1_weights_b1[i] : conv1_weights[i];
+    for (int i = 0; i < CONV2_OC; i++) conv2_active[i] = weight_bank ? conv2_weights_b1[i] : conv2_weights[i];
+  end
+
+`ifndef FC_BINARY
+  // FC reads one weight per cycle through its prefetching port, so both FC
+  // banks are block RAMs with a registered read and the bank mux sits after
+  // them
+  logic [$clog2(FC_IC*FC_OC)-1:0] fc_weight_addr;
+  logic signed [15:0] fc_weight_q0, fc_weight_q1, fc_weight_data;
+  logic fc_weight_bank;
+
+  always_ff @(posedge clk) begin
+    fc_weight_q0   <= fc_weights[fc_weight_addr];
+    fc_weight_q1   <= fc_weights_b1[fc_weight_addr];
+    fc_weight_bank <= weight_bank;
+  end
+
+  assign fc_weight_data = fc_weight_bank ? fc_weight_q1 : fc_weight_q0;
+
+  // Suffix bounds for FC's early exit (FC_EARLY_EXIT). They describe the
+  // built-in fc_weights only, so a bank that a weight upload has written
+  // runs every class to the end. The stride must match src/host/bnn_model.hpp
+  localparam int FC_BOUND_STRIDE = 32;
+  localparam int FC_BOUND_CHECKS = (FC_IC + FC_BOUND_STRIDE - 1) / FC_BOUND_STRIDE;
+`ifdef FC_EARLY_EXIT
+  localparam bit FC_EARLY_EXIT_EN = 1;
+`else
+  localparam bit FC_EARLY_EXIT_EN = 0;
+`endif
+`ifdef FC_EARLY_EXIT
+`ifndef BNN_WEIGHTS_FILE
+`define FC_HAS_BOUNDS
+`endif
+`endif
+`ifdef FC_HAS_BOUNDS
+  `include "fc_bounds.svh"
+  logic [1:0] fc_bounds_valid = 2'b01;
+`else
+  logic [31:0] fc_bounds[0:FC_OC*FC_BOUND_CHECKS-1];
+  logic [1:0] fc_bounds_valid = 2'b00;
+`endif
+`endif
+
+  // Weight image layout, see weight_loader
+  localparam int CONV1_BYTES = CONV1_OC * 2;
+  localparam int CONV2_ENTRY_BYTES = CONV1_OC * 9 / 8;
+  localparam int FC_BASE = CONV1_BYTES + CONV2_OC * CONV2_ENTRY_BYTES;
+
+  // entry (and byte within it) weight_wr_addr falls on in each layer
+  int conv1_wr_idx, conv2_wr_ofs, fc_wr_idx;
+  assign conv1_wr_idx = int'(weight_wr_addr) / 2;
+  assign conv2_wr_ofs = int'(weight_wr_addr) - CONV1_BYTES;
+  assign fc_wr_idx    = (int'(weight_wr_addr) - FC_BASE) / 2;
+
+  always_ff @(posedge clk) begin
+    if (weight_wr_en) begin
+      if (weight_wr_addr < 14'(CONV1_BYTES)) begin
+        if (!weight_wr_addr[0]) begin
+          if (weight_bank) conv1_weights[conv1_wr_idx][7:0] <= weight_wr_data;
+          else conv1_weights_b1[conv1_wr_idx][7:0] <= weight_wr_data;
+        end else begin
+          if (weight_bank) conv1_weights[conv1_wr_idx][8] <= weight_wr_data[0];
+          else conv1_weights_b1[conv1_wr_idx][8] <= weight_wr_data[0];
+        end
+      end else if (weight_wr_addr < 14'(FC_BASE)) begin
+        if (weight_bank)
+          conv2_weights[conv2_wr_ofs/CONV2_ENTRY_BYTES][(conv2_wr_ofs%CONV2_ENTRY_BYTES)*8+:8] <= weight_wr_data;
+        else conv2_weights_b1[conv2_wr_ofs/CONV2_ENTRY_BYTES][(conv2_wr_ofs%CONV2_ENTRY_BYTES)*8+:8] <= weight_wr_data;
+      end else if (weight_wr_addr < 14'(FC_BASE + FC_IC * FC_OC * 2)) begin
+        if (weight_bank) fc_weights[fc_wr_idx][weight_wr_addr[0]*8+:8] <= weight_wr_data;
+        else fc_weights_b1[fc_wr_idx][weight_wr_addr[0]*8+:8] <= weight_wr_data;
+`ifndef FC_BINARY
+        fc_bounds_valid[!weight_bank] <= 1'b0;
+`endif
+      end
+    end
+  end
+
+`ifdef FC_BINARY
+  // 1-bit FC weights with per-class scale/bias, generated from fc_weights above
+  `include "fc_binary_weights.svh"
+`endif
   // logic signed [15:0] threshold [0:OC-1] = {-16'd31, -16'd73, -16'd16, -16'd33, -16'd13, -16'd3, -16'd1543, -16'd4, -16'd8, -16'd14};
   // logic [CONV1_IMG_OUT_SIZE*CONV1_IMG_OUT_SIZE-1:0] conv1_img_out [0:CONV1_OC-1];
   logic [POOL1_IMG_OUT_SIZE*POOL1_IMG_OUT_SIZE-1:0] pool1_img_out[0:CONV1_OC-1];
@@ -5836,15 +5956,45 @@ module bnn_top #(
   logic [POOL2_IMG_OUT_SIZE*POOL2_IMG_OUT_SIZE-1:0] pool2_img_out[0:CONV2_OC-1];
   logic [FC_IC-1:0] fc_in;
   logic signed [15:0] fc_out[0:FC_OC-1];
-  logic conv1_data_ready;
-  // logic pool1_data_ready;
-  logic conv2_data_ready;
-  // logic pool2_data_ready;
-  logic fc_data_ready;
+  logic conv1_in_valid, conv1_out_valid;
+  logic conv2_in_ready, conv2_out_valid;
+  logic fc_in_ready, fc_out_valid;
+  logic compare_in_ready;
+  logic [POOL1_IMG_OUT_SIZE*POOL1_IMG_OUT_SIZE-1:0] pool1_dirty;
+`ifndef CONV_SPECIALIZED
+  // The conv layers read their input a channel at a time: conv2 straight
+  // from conv_pool1's activation RAM, conv1 from conv1_img_in, which stays
+  // put for the whole job (a register is only needed for several channels)
+  integer conv1_in_ch, conv2_in_ch;
+  logic [CONV1_IMG_IN_SIZE*CONV1_IMG_IN_SIZE-1:0] conv1_ch;
+  logic [POOL1_IMG_OUT_SIZE*POOL1_IMG_OUT_SIZE-1:0] pool1_ch;
+
+  generate
+    if (CONV1_IC == 1) begin : conv1_ch_gen
+      assign conv1_ch = conv1_img_in[0];
+    end else begin : conv1_ch_gen
+      always_ff @(posedge clk) conv1_ch <= conv1_img_in[conv1_in_ch];
+    end
+  endgenerate
+`endif
+
+`ifndef SYNTHESIS
+  // Debug log events at the start and end of every job (tests/debug_log.cpp)
+  // `bnn_cycle` counts this module's clock (clk/4 unless LOW_LATENCY); the
+  // log stamps the records with the main clock as well
+  import "DPI-C" function void debug_log_bnn_start(
+    input int bnn_cycle,
+    input int nonzero
+  );
+  import "DPI-C" function void debug_log_bnn_done(
+    input int bnn_cycle,
+    input int result
+  );
 
   logic conv1_img_in_nonzero;
-  logic data_in_ready_prev;  // Flag to track the previous state of data_in_ready
-  logic print_flag;  // Flag to ensure printing happens only once per high pulse
+  logic conv1_in_valid_prev;
+  logic out_held;  // result on `result` last cycle and not taken
+  int   bnn_cycle_cnt = 0;
 
   always_comb begin
     conv1_img_in_nonzero = 0;
@@ -5854,50 +6004,109 @@ module bnn_top #(
   end
 
   always_ff @(posedge clk) begin
-    if (data_in_ready && !data_in_ready_prev) begin  // Detect rising edge of data_in_ready
-      print_flag <= 1;  // Allow printing
-    end else if (!data_in_ready) begin
-      print_flag <= 0;  // Reset the flag when data_in_ready goes low
+    bnn_cycle_cnt <= bnn_cycle_cnt + 1;
+    conv1_in_valid_prev <= conv1_in_valid;
+    if (debug_enable && conv1_in_valid && !conv1_in_valid_prev) begin  // conv1 is given a job
+      debug_log_bnn_start(bnn_cycle_cnt, int'(conv1_img_in_nonzero));
     end
 
-    data_in_ready_prev <= data_in_ready;  // Update the previous state of data_in_ready
-
-    if (data_in_ready && print_flag) begin
-      if (conv1_img_in_nonzero) begin
-        $display("[BNN_TOP] Full Binary Array:");
-      end else begin
-        $display("[BNN_TOP] Binary Array is empty.");
-      end
-      print_flag <= 0;  // Ensure the message is printed only once
+    out_held <= out_valid && !out_ready;
+    if (debug_enable && out_valid && !out_held) begin  // a new result is on `result`
+      debug_log_bnn_done(bnn_cycle_cnt, int'(result));
     end
   end
+`endif
+
 
+  // The layers stream jobs with valid/ready: a layer runs as soon as the one
+  // before it has published its output, and gives that output back
+  // (in_ready) when it has read all of it. Each layer publishes into one of
+  // two banks, so it can start on the next job while the layer behind it
+  // still reads the last one.
+  //
+  // An incremental job needs every layer to still hold the previous job's
+  // activations, so it only enters an empty chain, and nothing follows it
+  // until its result has been taken.
+  logic [3:0] jobs_in_chain = 0;  // past conv1, result not yet taken
+  logic incr_job = 0;             // the job in the chain is incremental
 
+  assign conv1_in_valid = in_valid && !incr_job && (!incremental || jobs_in_chain == 0);
 
+  always_ff @(posedge clk) begin
+    if (clear) begin
+      jobs_in_chain <= 0;
+      incr_job <= 0;
+    end else begin
+      jobs_in_chain <= jobs_in_chain + 4'(in_valid && in_ready) - 4'(out_valid && out_ready);
+      if (in_valid && in_ready && incremental) incr_job <= 1;
+      else if (out_valid && out_ready) incr_job <= 0;
+    end
+  end
+
+  // pool1 lives in conv_pool1's ping-pong block RAM, except with the
+  // specialized kernels, which need every channel of it at once
   Conv2d_MaxPool2d #(
+      .LAYER(1),
+`ifndef CONV_SPECIALIZED
+      .ACT_RAM(1),
+`endif
       .IC(CONV1_IC),
       .OC(CONV1_OC),
       .CONV_IMG_IN_SIZE(CONV1_IMG_IN_SIZE)
   ) conv_pool1 (
       .clk(clk),
-      .data_in_ready(data_in_ready),  // from bnn_interface
+      .clear(clear),
+      .in_valid(conv1_in_valid),
+      .in_ready(in_ready),
+`ifdef CONV_SPECIALIZED
       .img_in(conv1_img_in),
-      .weights(conv1_weights),
+`else
+      .in_ch(conv1_in_ch),
+      .in_data(conv1_ch),
+`endif
+      .weights(conv1_active),
+      .incremental(incremental),
+      .dirty_in(dirty_in),
       .img_out(pool1_img_out),
-      .data_out_ready(conv1_data_ready)
+      .dirty_out(pool1_dirty),
+      .out_valid(conv1_out_valid),
+      .out_ready(conv2_in_ready),
+`ifdef CONV_SPECIALIZED
+      .rd_ch(0),
+      .rd_data()
+`else
+      .rd_ch(conv2_in_ch),
+      .rd_data(pool1_ch)
+`endif
   );
 
+  // pool2 stays in registers: FC takes all of it as one vector. Its incremental
+  // runs (and FC's) follow conv1's, flagged by incr_job.
   Conv2d_MaxPool2d #(
+      .LAYER(2),
       .IC(CONV1_OC),
       .OC(CONV2_OC),
       .CONV_IMG_IN_SIZE(POOL1_IMG_OUT_SIZE)
   ) conv_pool2 (
       .clk(clk),
-      .data_in_ready(conv1_data_ready),
+      .clear(clear),
+      .in_valid(conv1_out_valid),
+      .in_ready(conv2_in_ready),
+`ifdef CONV_SPECIALIZED
       .img_in(pool1_img_out),
-      .weights(conv2_weights),
+`else
+      .in_ch(conv2_in_ch),
+      .in_data(pool1_ch),
+`endif
+      .weights(conv2_active),
+      .incremental(incr_job),
+      .dirty_in(pool1_dirty),
       .img_out(pool2_img_out),
-      .data_out_ready(conv2_data_ready)
+      .dirty_out(),
+      .out_valid(conv2_out_valid),
+      .out_ready(fc_in_ready),
+      .rd_ch(0),
+      .rd_data()
   );
 
   genvar conv2_oc;
@@ -5908,27 +6117,107 @@ module bnn_top #(
   endgenerate
 
 
-  FC #(
+`ifdef FC_BINARY
+  FCBinary #(
       .IC(FC_IC),
       .OC(FC_OC)
   ) fc (
       .clk(clk),
-      .data_in_ready(conv2_data_ready),
+      .clear(clear),
+      .in_valid(conv2_out_valid),
+      .in_ready(fc_in_ready),
+      .in(fc_in),
+      .weights(fc_bin_weights),
+      .scale(fc_bin_scale),
+      .bias(fc_bin_bias),
+      .out(fc_out),
+      .out_valid(fc_out_valid),
+      .out_ready(compare_in_ready)
+  );
+`else
+  FC #(
+      .IC(FC_IC),
+      .OC(FC_OC),
+      .EARLY_EXIT(FC_EARLY_EXIT_EN),
+      .BOUND_STRIDE(FC_BOUND_STRIDE)
+  ) fc (
+      .clk(clk),
+      .clear(clear),
+      .in_valid(conv2_out_valid),
+      .in_ready(fc_in_ready),
       .in(fc_in),
-      .weights(fc_weights),
+      .incremental(incr_job),
+      .weight_addr(fc_weight_addr),
+      .weight_data(fc_weight_data),
+      .early_exit(fc_bounds_valid[weight_bank]),
+      .bound(fc_bounds),
       .out(fc_out),
-      .data_out_ready(fc_data_ready)
+      .out_valid(fc_out_valid),
+      .out_ready(compare_in_ready)
   );
+`endif
 
   Comparator #(
       .IC(FC_OC)
   ) compare (
       .clk(clk),
-      .data_in_ready(fc_data_ready),
+      .clear(clear),
+      .in_valid(fc_out_valid),
+      .in_ready(compare_in_ready),
       .in(fc_out),
       .out(result),
-      .data_out_ready(data_out_ready)
+      .out_valid(out_valid),
+      .out_ready(out_ready)
+  );
+
+`ifdef BNN_TAPS
+  // Per-layer taps: each stage's outputs are handed to the harness when it
+  // publishes them (tests/bnn_taps.cpp). %m tells the bnn_interface
+  // replicas apart.
+  import "DPI-C" function void bnn_tap_pool1(
+    input string scope,
+    input bit [CONV1_OC*POOL1_IMG_OUT_SIZE*POOL1_IMG_OUT_SIZE-1:0] bits
+  );
+  import "DPI-C" function void bnn_tap_fc_in(
+    input string scope,
+    input bit [FC_IC-1:0] bits
   );
+  import "DPI-C" function void bnn_tap_fc_out(
+    input string scope,
+    input bit [FC_OC*16-1:0] scores
+  );
+  import "DPI-C" function void bnn_tap_result(
+    input string scope,
+    input int result
+  );
+
+  logic [CONV1_OC*POOL1_IMG_OUT_SIZE*POOL1_IMG_OUT_SIZE-1:0] pool1_flat;
+  logic [FC_OC*16-1:0] fc_out_flat;
+  // stage output published last cycle and not taken: same job still there
+  logic conv1_tap_d, conv2_tap_d, fc_tap_d, result_tap_d;
+
+  genvar tap_i;
+  generate
+    for (tap_i = 0; tap_i < CONV1_OC; tap_i = tap_i + 1) begin
+      assign pool1_flat[tap_i*POOL1_IMG_OUT_SIZE*POOL1_IMG_OUT_SIZE +: POOL1_IMG_OUT_SIZE*POOL1_IMG_OUT_SIZE] = pool1_img_out[tap_i];
+    end
+    for (tap_i = 0; tap_i < FC_OC; tap_i = tap_i + 1) begin
+      assign fc_out_flat[tap_i*16 +: 16] = fc_out[tap_i];
+    end
+  endgenerate
+
+  always_ff @(posedge clk) begin
+    conv1_tap_d  <= conv1_out_valid && !conv2_in_ready;
+    conv2_tap_d  <= conv2_out_valid && !fc_in_ready;
+    fc_tap_d     <= fc_out_valid && !compare_in_ready;
+    result_tap_d <= out_valid && !out_ready;
+
+    if (conv1_out_valid && !conv1_tap_d) bnn_tap_pool1($sformatf("%m"), pool1_flat);
+    if (conv2_out_valid && !conv2_tap_d) bnn_tap_fc_in($sformatf("%m"), fc_in);
+    if (fc_out_valid && !fc_tap_d) bnn_tap_fc_out($sformatf("%m"), fc_out_flat);
+    if (out_valid && !result_tap_d) bnn_tap_result($sformatf("%m"), int'(result));
+  end
+`endif
 
   // wire _unused_ok = &{result};
 
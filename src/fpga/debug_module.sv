@@ -48,13 +48,51 @@ module debug_module (
     output logic [31:0] sclk_cycle_cnt
 );
 
-  logic [3:0] remaining_bits;  // Declare outside the procedural block
+  // Binary event sink (tests/debug_log.cpp); decode offline with debug_decode
+  import "DPI-C" function void debug_log_signals(
+    input int cycle,
+    input int sclk_cycle,
+    input int flags,
+    input int status,
+    input int result,
+    input int spi_rx_data,
+    input int data_in,
+    input int write_addr
+  );
+  import "DPI-C" function void debug_log_image(
+    input int cycle,
+    input bit [899:0] img
+  );
+
+  // Bit order matches debug_log::Flag
+  logic [13:0] flags;
+  assign flags = {
+    bnn_clear,
+    dst_pulse,
+    src_pulse,
+    spi_cs_n,
+    COPI,
+    SCLK,
+    result_ready,
+    buffer_empty,
+    buffer_full,
+    bnn_enable,
+    clear_internal,
+    byte_taken,
+    spi_rx_enable,
+    spi_byte_valid
+  };
+
+  // The image is only logged when it differs from the last one logged
+  logic [899:0] img_logged;
+  logic         img_logged_valid;
 
   always_ff @(posedge clk or negedge rst_n) begin
     if (!rst_n) begin
       // Reset logic
       main_cycle_cnt <= 32'd0;
       sclk_cycle_cnt <= 32'd0;
+      img_logged_valid <= 1'b0;
     end else if (debug_enable) begin
       // Main cycle counter
       main_cycle_cnt <= main_cycle_cnt + 1;
@@ -64,69 +102,14 @@ module debug_module (
         sclk_cycle_cnt <= sclk_cycle_cnt + 1;
       end
 
-      // Debug output
-      $display("========== DEBUG MODULE OUTPUT ==========");
-
-      // FSM Section
-      $display("[FSM][%0d] SPI RX Data: %h, SPI Byte Valid: %b, SPI RX Enable: %b, Byte Taken: %b",
-               main_cycle_cnt, spi_rx_data, spi_byte_valid, spi_rx_enable, byte_taken);
-      $display("[FSM][%0d] Status Code Register: %h, Clear Internal: %b, BNN Enable: %b",
-               main_cycle_cnt, status_code_reg, clear_internal, bnn_enable);
-
-      // $display(
-      //     "[FSM][%0d] Buffer Full: %b, Buffer Empty: %b, Buffer Write Data: %h, Buffer Write Address: %h",
-      //     main_cycle_cnt, buffer_full, buffer_empty, buffer_write_data,
-      //     buffer_write_addr);
-
-      // $display("[FSM][%0d] Result Ready: %b, Result Out: %h", main_cycle_cnt, result_ready,
-      //          result_out);
-
-      // SPI Section
-      $display("[SPI][%0d] SCLK: %b, COPI: %b, SPI CS_N: %b", sclk_cycle_cnt, SCLK, COPI, spi_cs_n);
-
-      // Sync Section
-      $display(
-          "[SYNC][%0d] Source Clock: %b, Source Pulse: %b, Destination Clock: %b, Destination Pulse: %b",
-          main_cycle_cnt, src_clk, src_pulse, dst_clk, dst_pulse);
-
-      // Image Buffer Section
-      $display("[IMAGE BUFFER][%0d] Clear Buffer: %b, Data In: %h", main_cycle_cnt, clear_buffer,
-               data_in);
-
-      if (|img_in) begin  // Check if any bit in img_in is set
-        $display("[IMAGE BUFFER][%0d] Full Binary Array:", main_cycle_cnt);
-        for (int i = 0; i < 904; i++) begin
-          if (i % 30 == 0) begin
-            // Start a new line every 30 bits for readability
-            if (i > 0) $display("");  // Print a newline after each row
-            $write("[%0d-%0d]: ", i, i + 29);
-          end
-          $write("%b", img_in[i]);
-        end
-        $display("");  // Final newline after printing all bits
-      end else begin
-        $display("[IMAGE BUFFER][%0d] Binary Array is empty.", main_cycle_cnt);
-      end
-
-      // // BNN Section
-      $display("[BNN][%0d] Image Buffer Full: %b, BNN Clear: %b", main_cycle_cnt, img_buffer_full,
-               bnn_clear);
-
-      // BNN Inference Section
-      $display("[BNN INFERENCE][%0d] Result Ready: %b, BNN Enable: %b", main_cycle_cnt,
-               result_ready, bnn_enable);
+      debug_log_signals(main_cycle_cnt, sclk_cycle_cnt, int'(flags), int'(status_code_reg),
+                        int'(result_out), int'(spi_rx_data), int'(data_in), int'(buffer_write_addr));
 
-      if (result_ready) begin
-        $display("[BNN INFERENCE][%0d] Result Output: %h", main_cycle_cnt, result_out);
-      end else begin
-        $display("[BNN INFERENCE][%0d] Result Output: Not Ready", main_cycle_cnt);
+      if (!img_logged_valid || img_in != img_logged) begin
+        debug_log_image(main_cycle_cnt, img_in);
+        img_logged <= img_in;
+        img_logged_valid <= 1'b1;
       end
-
-      // Cycle Counters
-      $display("[CYCLE COUNTERS][%0d] Main Cycle Count: %d, SCLK Cycle Count: %d", main_cycle_cnt,
-               main_cycle_cnt, sclk_cycle_cnt);
-
-      $display("=========================================");
     end
   end
 
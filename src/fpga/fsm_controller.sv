@@ -1,14 +1,21 @@
 `timescale 1ns / 1ps
 
-module controller_fsm (
+module controller_fsm #(
+    // 1: status_code_reg is the first status flop, one clock earlier
+    parameter bit LOW_LATENCY = 0,
+    // 0: the BNN cannot take new weights, CMD_LOAD_WEIGHTS is refused with
+    //    STATUS_ERROR (held until CMD_CLEAR) and the loader never starts
+    parameter bit WEIGHT_UPLOAD = 1
+) (
     input logic clk,
     input logic rst_n,
 
     // SPI interface
     input  logic [7:0] spi_rx_data,
     input  logic       spi_byte_valid,
-    output logic       byte_taken,
+    output logic       byte_ready,  // comb: spi_rx_data is taken this cycle
     output logic       rx_enable,
+    output logic       spi_quad,  // payload bytes arrive 4 bits per SCLK
 
     // Commands output signals
     output logic [3:0] status_code_reg,
@@ -18,20 +25,64 @@ module controller_fsm (
     input  logic buffer_empty,
     output logic clear,
 
-    output logic buffer_write_request,
+    output logic buffer_write_valid,
     input  logic buffer_write_ready,
-    input  logic write_ack,
 
     output logic [7:0] buffer_write_data,
     output logic [6:0] buffer_write_addr,
+    output logic       buffer_write_addressed,
+
+    // Compressed image decoder
+    output logic       rle_start,
+    output logic       rle_load,
+    input  logic       rle_in_ready,
+    input  logic [7:0] rle_out_byte,
+    input  logic       rle_out_valid,
+    output logic       rle_out_ready,
+
+    // Grayscale ingest (binarize + center)
+    output logic       gray_start,
+    output logic       gray_load,
+    input  logic       gray_in_ready,
+    input  logic [7:0] gray_out_byte,
+    input  logic       gray_out_valid,
+    output logic       gray_out_ready,
+
+    // Result cache
+    input  logic cache_hit,
+    output logic cache_lookup,
+
+    // Strip mode (four tiles per upload)
+    output logic       buffer_restart,  // empty the buffer for the next tile
+    output logic       strip_start,
+    output logic       strip_active,
+    output logic       strip_result,      // pulse: result_out belongs to tile strip_result_idx
+    output logic [1:0] strip_result_idx,
+
+    // Runtime weight upload (weight_loader)
+    output logic weight_start,
+    output logic weight_byte_valid,  // spi_rx_data, with weight_ready
+    input  logic weight_ready,
+    input  logic weight_done,
+    input  logic weight_ok,
 
     // BNN interface
     input  logic result_ready,
-    output logic bnn_enable
+    input  logic bnn_ready_for_input,
+    input  logic bnn_img_latched,
+    output logic bnn_enable,
+    output logic result_ack
 );
   // Receive codes
   parameter logic [7:0] CMD_IMG_SEND_REQUEST = 8'hFE;  // 11111101
   parameter logic [7:0] CMD_CLEAR = 8'hFD;  // 11111011
+  parameter logic [7:0] CMD_IMG_SEND_RLE = 8'hFC;  // 11111100
+  parameter logic [7:0] CMD_IMG_WRITE_AT = 8'hFB;  // 11111011, followed by address and data bytes
+  parameter logic [7:0] CMD_RERUN = 8'hFA;  // 11111010, infer again on the buffer as it is
+  parameter logic [7:0] CMD_IMG_SEND_STRIP = 8'hF9;  // 11111001, four 113-byte tiles follow
+  parameter logic [7:0] CMD_IMG_SEND_QUAD = 8'hF8;  // 11111000, 113 bytes follow on four data lanes
+  parameter logic [7:0] CMD_LOAD_WEIGHTS = 8'hF7;  // 11110111, weight image + CRC-32 follow
+  parameter logic [7:0] CMD_IMG_SEND_GRAY = 8'hF6;  // 11110110, mode, threshold and grayscale pixels follow
 
   // Status codes
   localparam logic [3:0] STATUS_IDLE = 4'b0000;  // 0 - FPGA idle, ready
@@ -42,14 +93,26 @@ module controller_fsm (
   localparam logic [3:0] STATUS_ERROR = 4'b1110;  // 14 - Error occurred
   localparam logic [3:0] STATUS_UNKNOWN = 4'b1111;  // 15- busy
 
-  // FSM states (now 4 bits)
-  typedef enum logic [2:0] {
+  // FSM states (now 5 bits)
+  typedef enum logic [4:0] {
     S_IDLE,
     S_WAIT_IMAGE,
     S_IMG_RX,
     S_WAIT_FOR_BNN,
     S_RESULT_RDY,
-    S_CLEAR
+    S_CLEAR,
+    S_RLE_RX,
+    S_DELTA,
+    S_DELTA_ADDR,
+    S_DELTA_DATA,
+    S_RERUN,
+    S_STRIP_RX,
+    S_STRIP_START,
+    S_STRIP_NEXT,
+    S_STRIP_WAIT,
+    S_WEIGHT_RX,
+    S_WEIGHT_ERR,
+    S_GRAY_RX
   } fsm_state_t;
 
   fsm_state_t current_state, next_state;
@@ -60,11 +123,12 @@ module controller_fsm (
 
   logic [6:0] buffer_write_addr_int;
 
-  logic byte_taken_comb;
-  logic prev_spi_byte_valid;
-  logic new_spi_byte;
+  logic spi_byte_fire;  // SPI byte handed over this cycle
   logic buffer_full_sync;
-  logic waiting_for_write_ack;
+  logic [6:0] delta_addr;
+  logic [1:0] strip_tile;  // tile being received
+  logic [2:0] strip_done;  // results collected so far
+  logic       quad_start;
 
   //===================================================
   // FSM Next, Status Code, Buffer Write Address Register
@@ -74,10 +138,12 @@ module controller_fsm (
       current_state <= S_IDLE;
       status_code_reg_ff1 <= STATUS_IDLE;
       buffer_write_addr_int <= 0;
-      byte_taken <= 0;
-      prev_spi_byte_valid <= 0;
       buffer_full_sync <= 0;
-      waiting_for_write_ack <= 0;
+      delta_addr <= 0;
+      strip_active <= 0;
+      strip_tile <= 0;
+      strip_done <= 0;
+      spi_quad <= 0;
 
     end else begin
       current_state       <= next_state;
@@ -85,45 +151,76 @@ module controller_fsm (
       status_code_reg_ff1 <= next_status_code_reg;
       status_code_reg_ff2 <= status_code_reg_ff1;
 
-      byte_taken          <= byte_taken_comb;
-      prev_spi_byte_valid <= spi_byte_valid;
       buffer_full_sync    <= buffer_full;
 
       if (current_state == S_IDLE && spi_byte_valid && spi_rx_data == CMD_CLEAR)
         buffer_write_addr_int <= 0;
 
-      else if (current_state == S_IMG_RX && new_spi_byte) begin
+      else if (current_state == S_IMG_RX && spi_byte_fire) begin
         buffer_write_addr_int <= buffer_write_addr_int + 1;
       end
 
-      if (current_state == S_WAIT_IMAGE || current_state == S_IMG_RX) begin
-        // Set the flag when a write is requested
-        if (buffer_write_request) waiting_for_write_ack <= 1'b1;
-        // Clear the flag when the write is acknowledged
-        else if (write_ack) waiting_for_write_ack <= 1'b0;
+      if (current_state == S_DELTA_ADDR && spi_byte_fire) delta_addr <= spi_rx_data[6:0];
+
+      if (strip_start) begin
+        strip_active <= 1'b1;
+        strip_tile   <= 0;
+        strip_done   <= 0;
+      end else if (clear || strip_done == 3'd4) begin
+        strip_active <= 1'b0;
       end else begin
-        waiting_for_write_ack <= 1'b0;  // Reset in all other states
+        if (current_state == S_STRIP_NEXT && next_state == S_STRIP_RX) strip_tile <= strip_tile + 1;
+        if (strip_result) strip_done <= strip_done + 1;
       end
+
+      // Quad lanes only for the payload of a CMD_IMG_SEND_QUAD upload
+      if (quad_start) spi_quad <= 1'b1;
+      else if (current_state != S_WAIT_IMAGE && current_state != S_IMG_RX) spi_quad <= 1'b0;
     end
   end
 
-  assign status_code_reg = status_code_reg_ff2;
-  assign new_spi_byte = spi_byte_valid && !prev_spi_byte_valid;
+  logic [3:0] status_code_q;
+  assign status_code_q   = LOW_LATENCY ? status_code_reg_ff1 : status_code_reg_ff2;
+  assign status_code_reg = status_code_q;
+  assign spi_byte_fire = spi_byte_valid && byte_ready;
 
   //===================================================
   // FSM State
   //===================================================
+  // Every byte stream is valid/ready: spi_byte_valid stays up until a state
+  // takes the byte with byte_ready, and a byte going to the image buffer is
+  // taken in the same cycle the buffer takes it
   always_comb begin
-    byte_taken_comb = 0;
+    byte_ready = 0;
     rx_enable = 0;
     buffer_write_data = 0;
     buffer_write_addr = buffer_write_addr_int;
+    buffer_write_addressed = 0;
     bnn_enable = 0;
+    result_ack = 0;
     clear = 0;
-    buffer_write_request = 0;
+    buffer_write_valid = 0;
+    rle_start = 0;
+    rle_load = 0;
+    rle_out_ready = 0;
+    gray_start = 0;
+    gray_load = 0;
+    gray_out_ready = 0;
+    cache_lookup = 0;
+    buffer_restart = 0;
+    strip_start = 0;
+    quad_start = 0;
+    weight_start = 0;
+    weight_byte_valid = 0;
 
     next_state = current_state;
-    next_status_code_reg = status_code_reg_ff2;
+    next_status_code_reg = status_code_q;
+
+    // Strip results arrive in tile order while later tiles are still being
+    // received; take each one and free the BNN for the next tile
+    strip_result = strip_active && result_ready && strip_done < 3'd4;
+    strip_result_idx = strip_done[1:0];
+    if (strip_result) result_ack = 1;
 
     case (current_state)
       S_IDLE: begin
@@ -134,21 +231,58 @@ module controller_fsm (
           next_state = S_WAIT_FOR_BNN;
           next_status_code_reg = STATUS_BNN_BUSY;
 
-        end else if (new_spi_byte) begin
+        end else if (spi_byte_valid) begin
           if (spi_rx_data == CMD_CLEAR) begin
             next_state = S_CLEAR;
             next_status_code_reg = STATUS_IDLE;
             clear = 1;
-            byte_taken_comb = 1;
+            byte_ready = 1;
 
           end else if (spi_rx_data == CMD_IMG_SEND_REQUEST) begin
             next_state = S_WAIT_IMAGE;
             next_status_code_reg = STATUS_RX_IMG_RDY;
-            byte_taken_comb = 1;
+            byte_ready = 1;
+
+          end else if (spi_rx_data == CMD_IMG_SEND_QUAD) begin
+            next_state = S_WAIT_IMAGE;
+            next_status_code_reg = STATUS_RX_IMG_RDY;
+            quad_start = 1;
+            byte_ready = 1;
+
+          end else if (spi_rx_data == CMD_LOAD_WEIGHTS && !WEIGHT_UPLOAD) begin
+            next_state = S_WEIGHT_ERR;
+            next_status_code_reg = STATUS_ERROR;
+            byte_ready = 1;
+
+          end else if (spi_rx_data == CMD_LOAD_WEIGHTS) begin
+            // The current image and result go, as after CMD_CLEAR
+            next_state = S_WEIGHT_RX;
+            next_status_code_reg = STATUS_RX_IMG;
+            clear = 1;
+            weight_start = 1;
+            byte_ready = 1;
+
+          end else if (spi_rx_data == CMD_IMG_SEND_RLE) begin
+            next_state = S_RLE_RX;
+            next_status_code_reg = STATUS_RX_IMG_RDY;
+            rle_start = 1;
+            byte_ready = 1;
+
+          end else if (spi_rx_data == CMD_IMG_SEND_GRAY) begin
+            next_state = S_GRAY_RX;
+            next_status_code_reg = STATUS_RX_IMG_RDY;
+            gray_start = 1;
+            byte_ready = 1;
+
+          end else if (spi_rx_data == CMD_IMG_SEND_STRIP) begin
+            next_state = S_STRIP_RX;
+            next_status_code_reg = STATUS_RX_IMG_RDY;
+            strip_start = 1;
+            byte_ready = 1;
 
           end else begin
             next_status_code_reg = STATUS_ERROR;
-            byte_taken_comb = 1;
+            byte_ready = 1;
           end
         end else begin
           next_status_code_reg = STATUS_IDLE;
@@ -159,18 +293,15 @@ module controller_fsm (
         rx_enable = 1;
         next_status_code_reg = STATUS_RX_IMG_RDY;
 
-        if (new_spi_byte) begin
-          if (spi_byte_valid && buffer_write_ready && !waiting_for_write_ack) begin
+        if (spi_byte_valid) begin
+          buffer_write_valid = 1;
+          buffer_write_data  = spi_rx_data;
+          byte_ready         = buffer_write_ready;
+          if (buffer_write_ready) begin
             next_state           = S_IMG_RX;
             next_status_code_reg = STATUS_RX_IMG;
-            buffer_write_request = 1;
-            buffer_write_data    = spi_rx_data;
           end
         end
-
-        if (write_ack) begin
-          byte_taken_comb = 1;  // Acknowledge only after write is committed
-        end
       end
 
       S_IMG_RX: begin
@@ -178,25 +309,85 @@ module controller_fsm (
         next_status_code_reg = STATUS_RX_IMG;
 
         if (buffer_full_sync) begin
-          bnn_enable = 1;
-          next_state = S_WAIT_FOR_BNN;
-          next_status_code_reg = STATUS_BNN_BUSY;
+          // Same image seen recently: report the cached result, skip the BNN
+          cache_lookup = 1;
+          if (cache_hit) begin
+            next_state = S_RESULT_RDY;
+            next_status_code_reg = STATUS_RESULT_RDY;
+          end else begin
+            bnn_enable = 1;
+            next_state = S_WAIT_FOR_BNN;
+            next_status_code_reg = STATUS_BNN_BUSY;
+          end
 
-        end else if (new_spi_byte && !waiting_for_write_ack) begin
+        end else if (spi_byte_valid) begin
           if (spi_rx_data == CMD_CLEAR) begin
             next_state = S_CLEAR;
             next_status_code_reg = STATUS_IDLE;
             clear = 1;
-            byte_taken_comb = 1;
+            byte_ready = 1;
 
-          end else if (buffer_write_ready) begin
-            buffer_write_request = 1;
+          end else begin
+            buffer_write_valid = 1;
             buffer_write_data = spi_rx_data;
-            next_status_code_reg = STATUS_RX_IMG;
+            byte_ready = buffer_write_ready;
           end
         end
-        if (write_ack) begin
-          byte_taken_comb = 1;
+      end
+
+      // Every byte is payload here (0xFD is a valid token pair), so a compressed
+      // upload can only be aborted by reset
+      S_RLE_RX: begin
+        rx_enable = 1;
+        next_status_code_reg = buffer_empty ? STATUS_RX_IMG_RDY : STATUS_RX_IMG;
+
+        if (buffer_full_sync) begin
+          cache_lookup = 1;
+          if (cache_hit) begin
+            next_state = S_RESULT_RDY;
+            next_status_code_reg = STATUS_RESULT_RDY;
+          end else begin
+            bnn_enable = 1;
+            next_state = S_WAIT_FOR_BNN;
+            next_status_code_reg = STATUS_BNN_BUSY;
+          end
+
+        end else begin
+          // Feed SPI bytes into the decoder
+          rle_load   = spi_byte_valid;
+          byte_ready = rle_in_ready;
+
+          // Drain decoded bytes into the image buffer
+          buffer_write_valid = rle_out_valid;
+          buffer_write_data  = rle_out_byte;
+          rle_out_ready      = buffer_write_ready;
+        end
+      end
+
+      // Same shape as S_RLE_RX: every byte goes to gray_ingest, which writes
+      // the binarized, centered image once all pixels are in
+      S_GRAY_RX: begin
+        rx_enable = 1;
+        next_status_code_reg = buffer_empty ? STATUS_RX_IMG_RDY : STATUS_RX_IMG;
+
+        if (buffer_full_sync) begin
+          cache_lookup = 1;
+          if (cache_hit) begin
+            next_state = S_RESULT_RDY;
+            next_status_code_reg = STATUS_RESULT_RDY;
+          end else begin
+            bnn_enable = 1;
+            next_state = S_WAIT_FOR_BNN;
+            next_status_code_reg = STATUS_BNN_BUSY;
+          end
+
+        end else begin
+          gray_load  = spi_byte_valid;
+          byte_ready = gray_in_ready;
+
+          buffer_write_valid = gray_out_valid;
+          buffer_write_data  = gray_out_byte;
+          gray_out_ready     = buffer_write_ready;
         end
       end
 
@@ -208,12 +399,12 @@ module controller_fsm (
           next_state = S_RESULT_RDY;
           next_status_code_reg = STATUS_RESULT_RDY;
 
-        end else if (new_spi_byte) begin
+        end else if (spi_byte_valid) begin
           if (spi_rx_data == CMD_CLEAR) begin
             next_state = S_CLEAR;
             next_status_code_reg = STATUS_IDLE;
             clear = 1;
-            byte_taken_comb = 1;
+            byte_ready = 1;
           end
         end
       end
@@ -222,10 +413,196 @@ module controller_fsm (
         rx_enable = 1;
         next_status_code_reg = STATUS_RESULT_RDY;
 
-        if (new_spi_byte && spi_rx_data == CMD_CLEAR) begin
+        if (spi_byte_valid) begin
+          if (spi_rx_data == CMD_CLEAR) begin
+            next_state = S_CLEAR;
+            next_status_code_reg = STATUS_IDLE;
+            byte_ready = 1;
+
+          end else if (spi_rx_data == CMD_IMG_WRITE_AT) begin
+            // The buffer is about to change, so the result is stale
+            result_ack = 1;
+            next_state = S_DELTA_ADDR;
+            next_status_code_reg = STATUS_RX_IMG;
+            byte_ready = 1;
+
+          end else if (spi_rx_data == CMD_RERUN) begin
+            result_ack = 1;
+            next_state = S_RERUN;
+            next_status_code_reg = STATUS_BNN_BUSY;
+            byte_ready = 1;
+          end
+        end
+      end
+
+      // Buffer edited in place, waiting for more edits or a re-run
+      S_DELTA: begin
+        rx_enable = 1;
+        next_status_code_reg = STATUS_RX_IMG_RDY;
+
+        if (spi_byte_valid) begin
+          byte_ready = 1;
+          if (spi_rx_data == CMD_CLEAR) begin
+            next_state = S_CLEAR;
+            next_status_code_reg = STATUS_IDLE;
+            clear = 1;
+
+          end else if (spi_rx_data == CMD_IMG_WRITE_AT) begin
+            next_state = S_DELTA_ADDR;
+            next_status_code_reg = STATUS_RX_IMG;
+
+          end else if (spi_rx_data == CMD_RERUN) begin
+            next_state = S_RERUN;
+            next_status_code_reg = STATUS_BNN_BUSY;
+
+          end else begin
+            next_status_code_reg = STATUS_ERROR;
+          end
+        end
+      end
+
+      S_DELTA_ADDR: begin
+        rx_enable = 1;
+        next_status_code_reg = STATUS_RX_IMG;
+
+        if (spi_byte_valid) begin
+          byte_ready = 1;
+          next_state = S_DELTA_DATA;
+        end
+      end
+
+      S_DELTA_DATA: begin
+        rx_enable = 1;
+        next_status_code_reg = STATUS_RX_IMG;
+        buffer_write_addr = delta_addr;
+        buffer_write_addressed = 1;
+
+        if (spi_byte_valid) begin
+          buffer_write_valid = 1;
+          buffer_write_data = spi_rx_data;
+          byte_ready = buffer_write_ready;
+          if (buffer_write_ready) begin
+            next_state = S_DELTA;
+            next_status_code_reg = STATUS_RX_IMG_RDY;
+          end
+        end
+      end
+
+      // Wait for the BNN to drain the previous run, then start on the current buffer
+      S_RERUN: begin
+        rx_enable = 1;
+        next_status_code_reg = STATUS_BNN_BUSY;
+
+        if (bnn_ready_for_input) begin
+          bnn_enable = 1;
+          next_state = S_WAIT_FOR_BNN;
+
+        end else if (spi_byte_valid && spi_rx_data == CMD_CLEAR) begin
+          next_state = S_CLEAR;
+          next_status_code_reg = STATUS_IDLE;
+          clear = 1;
+          byte_ready = 1;
+        end
+      end
+
+      // Receiving one 30x30 tile of a strip; RX_IMG_RDY tells the host the
+      // next tile may be sent
+      S_STRIP_RX: begin
+        rx_enable = 1;
+        next_status_code_reg = buffer_empty ? STATUS_RX_IMG_RDY : STATUS_RX_IMG;
+
+        if (buffer_full_sync) begin
+          next_state = S_STRIP_START;
+          next_status_code_reg = STATUS_BNN_BUSY;
+
+        end else if (spi_byte_valid) begin
+          if (spi_rx_data == CMD_CLEAR) begin
+            next_state = S_CLEAR;
+            next_status_code_reg = STATUS_IDLE;
+            clear = 1;
+            byte_ready = 1;
+
+          end else begin
+            buffer_write_valid = 1;
+            buffer_write_data = spi_rx_data;
+            byte_ready = buffer_write_ready;
+          end
+        end
+      end
+
+      // Hand the tile to the BNN as soon as it has taken the previous one
+      S_STRIP_START: begin
+        rx_enable = 1;
+        next_status_code_reg = STATUS_BNN_BUSY;
+        bnn_enable = bnn_ready_for_input;
+
+        if (bnn_img_latched) begin
+          next_state = (strip_tile == 2'd3) ? S_STRIP_WAIT : S_STRIP_NEXT;
+
+        end else if (spi_byte_valid && spi_rx_data == CMD_CLEAR) begin
+          next_state = S_CLEAR;
+          next_status_code_reg = STATUS_IDLE;
+          clear = 1;
+          byte_ready = 1;
+        end
+      end
+
+      // The BNN has its own copy of the tile, empty the buffer for the next one
+      S_STRIP_NEXT: begin
+        rx_enable = 1;
+        next_status_code_reg = STATUS_BNN_BUSY;
+        buffer_restart = 1;
+
+        if (buffer_empty && !buffer_full_sync) begin
+          next_state = S_STRIP_RX;
+          next_status_code_reg = STATUS_RX_IMG_RDY;
+        end
+      end
+
+      // All four tiles are in, wait for the remaining results
+      S_STRIP_WAIT: begin
+        rx_enable = 1;
+        next_status_code_reg = STATUS_BNN_BUSY;
+
+        if (!strip_active) begin
+          next_state = S_RESULT_RDY;
+          next_status_code_reg = STATUS_RESULT_RDY;
+
+        end else if (spi_byte_valid && spi_rx_data == CMD_CLEAR) begin
           next_state = S_CLEAR;
           next_status_code_reg = STATUS_IDLE;
-          byte_taken_comb = 1;
+          clear = 1;
+          byte_ready = 1;
+        end
+      end
+
+      // Every byte is payload; ends when the loader has checked the CRC
+      S_WEIGHT_RX: begin
+        rx_enable = 1;
+        next_status_code_reg = STATUS_RX_IMG;
+
+        weight_byte_valid = spi_byte_valid;
+        byte_ready = weight_ready;
+
+        if (weight_done) begin
+          next_state = weight_ok ? S_IDLE : S_WEIGHT_ERR;
+          next_status_code_reg = weight_ok ? STATUS_IDLE : STATUS_ERROR;
+        end
+      end
+
+      // CRC mismatch, or an upload this build refuses: the BNN kept its
+      // previous weights; held until cleared
+      S_WEIGHT_ERR: begin
+        rx_enable = 1;
+        next_status_code_reg = STATUS_ERROR;
+
+        if (spi_byte_valid) begin
+          byte_ready = 1;
+          if (spi_rx_data == CMD_CLEAR) begin
+            next_state = S_CLEAR;
+            next_status_code_reg = STATUS_IDLE;
+            clear = 1;
+          end
         end
       end
 
@@ -233,8 +610,8 @@ module controller_fsm (
         clear = 1;
         next_status_code_reg = STATUS_IDLE;
 
-        if (new_spi_byte) begin
-          byte_taken_comb = 1;
+        if (spi_byte_valid) begin
+          byte_ready = 1;
         end
 
         if (buffer_empty) begin
@@ -0,0 +1,381 @@
+`timescale 1ns / 1ps
+
+// Grayscale image ingest (CMD_IMG_SEND_GRAY). Takes a 30x30 grayscale crop,
+// binarizes it, moves the bounding box of the ink to the middle of the
+// frame and streams the 113 packed bytes into image_buffer, so the host
+// can send pixels as they come off the sensor.
+//
+// Payload: a mode byte, a threshold byte, then the pixels row by row.
+//   mode[0] : 4-bit pixels, two per byte, low nibble first (450 bytes);
+//             otherwise one 8-bit pixel per byte (900 bytes)
+//   mode[1] : light ink on a dark background (ink = pixel > threshold);
+//             otherwise dark ink (ink = pixel <= threshold)
+//   mode[2] : use the threshold byte. Otherwise it is ignored and the
+//             threshold comes from Otsu's method on a 16-bin histogram of
+//             the upper pixel nibble; {t, 4'hF} for the best bin t, 8'h7F
+//             if every pixel falls in one bin.
+// A 4-bit pixel p is treated as the 8-bit pixel {p, p}. Centering only
+// translates the box, it is not scaled. Every byte is payload, like an RLE
+// upload; bytes after the last pixel wait until the image has gone out.
+module gray_ingest #(
+    parameter int IMG_SIZE = 30
+) (
+    input logic clk,
+    input logic rst_n,
+    input logic clear,  // also starts a new upload
+
+    // Payload bytes in
+    input  logic [7:0] in_byte,
+    input  logic       in_valid,
+    output logic       in_ready,
+
+    // Packed image bytes out, pixels LSB first like a raw upload
+    output logic [7:0] out_byte,
+    output logic       out_valid,
+    input  logic       out_ready
+);
+  localparam int PIXELS = IMG_SIZE * IMG_SIZE;
+  localparam int AW = $clog2(PIXELS);
+  localparam int CW = $clog2(IMG_SIZE + 1);
+
+  typedef enum logic [2:0] {
+    G_MODE,
+    G_THRESH,
+    G_RX,
+    G_OTSU,
+    G_BBOX,
+    G_MAP,
+    G_DONE
+  } gray_state_t;
+
+  gray_state_t state;
+
+  logic mode_4bit, mode_light, mode_fixed;
+  logic [7:0] thresh_byte;
+
+  //===================================================
+  // Pixel store, one 8-bit pixel per entry
+  //===================================================
+  (* ram_style = "block" *)
+  logic [7:0] pix_ram[PIXELS];
+  logic [AW-1:0] rd_addr;
+  logic [7:0] rd_data;
+
+  logic px_we;
+  logic [7:0] px_val;
+  logic [AW-1:0] pix_cnt;
+
+  always_ff @(posedge clk) begin
+    if (px_we) pix_ram[pix_cnt] <= px_val;
+    rd_data <= pix_ram[rd_addr];
+  end
+
+  //===================================================
+  // Receive: one pixel written per cycle, so the high nibble of a 4-bit
+  // byte takes a second cycle
+  //===================================================
+  logic hi_pending;
+  logic [3:0] hi_nib;
+
+  logic [AW-1:0] hist[16];
+  logic [AW+3:0] sum_all;  // sum of the upper nibbles
+
+  always_comb begin
+    px_we  = 1'b0;
+    px_val = in_byte;
+    if (state == G_RX) begin
+      if (hi_pending) begin
+        px_we  = 1'b1;
+        px_val = {hi_nib, hi_nib};
+      end else if (in_valid) begin
+        px_we  = 1'b1;
+        px_val = mode_4bit ? {in_byte[3:0], in_byte[3:0]} : in_byte;
+      end
+    end
+  end
+
+  assign in_ready = (state == G_MODE || state == G_THRESH || state == G_RX) && !hi_pending;
+
+  //===================================================
+  // Otsu: one histogram bin per cycle. With w0 / s0 the pixel count and
+  // nibble sum at or below bin t, the between-class variance is
+  // (s0*N - S*w0)^2 / (w0*w1) up to a constant factor; candidates are
+  // compared by cross-multiplying, first maximum wins.
+  //===================================================
+  logic [4:0] otsu_t;
+  logic [3:0] cand_t;
+  logic cand_v;
+  logic [AW-1:0] w0;
+  logic [AW+3:0] s0;
+
+  logic [AW-1:0] w1;
+  logic signed [31:0] diff;
+  logic [63:0] num;
+  logic [2*AW-1:0] den;
+
+  logic [3:0] best_t;
+  logic best_v;
+  logic [63:0] best_num;
+  logic [2*AW-1:0] best_den;
+  logic cand_better;
+
+  assign w1 = AW'(PIXELS) - w0;
+  assign diff = $signed(32'(s0) * 32'(PIXELS) - 32'(sum_all) * 32'(w0));
+  assign num = 64'(diff) * 64'(diff);
+  assign den = (2 * AW)'(w0) * (2 * AW)'(w1);
+
+  // num / den > best_num / best_den, at full product width
+  logic [95:0] cand_cross, best_cross;
+  assign cand_cross = 96'(num) * 96'(best_den);
+  assign best_cross = 96'(best_num) * 96'(den);
+  assign cand_better = cand_v && w0 != 0 && w1 != 0 && (!best_v || cand_cross > best_cross);
+
+  logic [7:0] thresh;
+  assign thresh = mode_fixed ? thresh_byte : (best_v ? {best_t, 4'hF} : 8'h7F);
+
+  function automatic logic is_ink(input logic [7:0] px, input logic [7:0] t, input logic light);
+    return light ? (px > t) : (px <= t);
+  endfunction
+
+  //===================================================
+  // Bounding box of the ink, one pixel read per cycle
+  //===================================================
+  logic [CW-1:0] scan_r, scan_c;  // pixel being addressed
+  logic [CW-1:0] cap_r, cap_c;  // pixel on rd_data
+  logic scan_done, cap_v;
+
+  logic any_ink;
+  logic [CW-1:0] x0, x1, y0, y1;
+
+  // Placement: the box moves to (ox, oy)
+  logic [CW-1:0] bw, bh, ox, oy;
+  assign bw = x1 - x0 + 1'b1;
+  assign bh = y1 - y0 + 1'b1;
+  assign ox = CW'((IMG_SIZE - bw) >> 1);
+  assign oy = CW'((IMG_SIZE - bh) >> 1);
+
+  //===================================================
+  // Output: output pixel (map_r, map_c) reads the source pixel it maps
+  // to; a byte's last pixel is only read once the output register will
+  // be free to take the byte
+  //===================================================
+  logic [CW-1:0] map_r, map_c;
+  logic [AW-1:0] map_p;
+  logic map_in, map_last, map_issue, map_done;
+  logic [AW-1:0] map_src;
+
+  logic [2:0] cap_bit;
+  logic cap_in, cap_last, cap_end;
+  logic [7:0] acc;
+
+  assign map_in = any_ink && map_r >= oy && map_r < oy + bh && map_c >= ox && map_c < ox + bw;
+  assign map_src = AW'((map_r - oy + y0) * IMG_SIZE + (map_c - ox + x0));
+  assign map_last = map_p[2:0] == 3'd7 || map_p == AW'(PIXELS - 1);
+  assign map_issue = (state == G_MAP) && !map_done && (!map_last || !out_valid || out_ready);
+
+  always_comb begin
+    rd_addr = '0;
+    if (state == G_BBOX && !scan_done) rd_addr = AW'(scan_r * IMG_SIZE + scan_c);
+    else if (state == G_MAP && map_in) rd_addr = map_src;
+  end
+
+  //===================================================
+  // Control
+  //===================================================
+  always_ff @(posedge clk or negedge rst_n) begin
+    if (!rst_n) begin
+      state       <= G_MODE;
+      mode_4bit   <= 1'b0;
+      mode_light  <= 1'b0;
+      mode_fixed  <= 1'b0;
+      thresh_byte <= 8'd0;
+      pix_cnt     <= '0;
+      hi_pending  <= 1'b0;
+      hi_nib      <= 4'd0;
+      sum_all     <= '0;
+      for (int i = 0; i < 16; i++) hist[i] <= '0;
+      otsu_t      <= '0;
+      cand_t      <= '0;
+      cand_v      <= 1'b0;
+      w0          <= '0;
+      s0          <= '0;
+      best_t      <= '0;
+      best_v      <= 1'b0;
+      best_num    <= '0;
+      best_den    <= '0;
+      scan_r      <= '0;
+      scan_c      <= '0;
+      scan_done   <= 1'b0;
+      cap_r       <= '0;
+      cap_c       <= '0;
+      cap_v       <= 1'b0;
+      any_ink     <= 1'b0;
+      x0          <= '0;
+      x1          <= '0;
+      y0          <= '0;
+      y1          <= '0;
+      map_r       <= '0;
+      map_c       <= '0;
+      map_p       <= '0;
+      map_done    <= 1'b0;
+      cap_bit     <= '0;
+      cap_in      <= 1'b0;
+      cap_last    <= 1'b0;
+      cap_end     <= 1'b0;
+      acc         <= 8'd0;
+      out_byte    <= 8'd0;
+      out_valid   <= 1'b0;
+    end else if (clear) begin
+      state       <= G_MODE;
+      mode_4bit   <= 1'b0;
+      mode_light  <= 1'b0;
+      mode_fixed  <= 1'b0;
+      thresh_byte <= 8'd0;
+      pix_cnt     <= '0;
+      hi_pending  <= 1'b0;
+      hi_nib      <= 4'd0;
+      sum_all     <= '0;
+      for (int i = 0; i < 16; i++) hist[i] <= '0;
+      otsu_t      <= '0;
+      cand_t      <= '0;
+      cand_v      <= 1'b0;
+      w0          <= '0;
+      s0          <= '0;
+      best_t      <= '0;
+      best_v      <= 1'b0;
+      best_num    <= '0;
+      best_den    <= '0;
+      scan_r      <= '0;
+      scan_c      <= '0;
+      scan_done   <= 1'b0;
+      cap_r       <= '0;
+      cap_c       <= '0;
+      cap_v       <= 1'b0;
+      any_ink     <= 1'b0;
+      x0          <= '0;
+      x1          <= '0;
+      y0          <= '0;
+      y1          <= '0;
+      map_r       <= '0;
+      map_c       <= '0;
+      map_p       <= '0;
+      map_done    <= 1'b0;
+      cap_bit     <= '0;
+      cap_in      <= 1'b0;
+      cap_last    <= 1'b0;
+      cap_end     <= 1'b0;
+      acc         <= 8'd0;
+      out_byte    <= 8'd0;
+      out_valid   <= 1'b0;
+    end else begin
+      if (out_valid && out_ready) out_valid <= 1'b0;
+
+      case (state)
+        G_MODE:
+        if (in_valid) begin
+          mode_4bit  <= in_byte[0];
+          mode_light <= in_byte[1];
+          mode_fixed <= in_byte[2];
+          state      <= G_THRESH;
+        end
+
+        G_THRESH:
+        if (in_valid) begin
+          thresh_byte <= in_byte;
+          state       <= G_RX;
+        end
+
+        G_RX: begin
+          if (px_we) begin
+            pix_cnt           <= pix_cnt + 1'b1;
+            hist[px_val[7:4]] <= hist[px_val[7:4]] + 1'b1;
+            sum_all           <= sum_all + (AW + 4)'(px_val[7:4]);
+            if (pix_cnt == AW'(PIXELS - 1)) state <= mode_fixed ? G_BBOX : G_OTSU;
+          end
+          if (hi_pending) hi_pending <= 1'b0;
+          else if (in_valid && mode_4bit && pix_cnt != AW'(PIXELS - 1)) begin
+            hi_pending <= 1'b1;
+            hi_nib     <= in_byte[7:4];
+          end
+        end
+
+        G_OTSU: begin
+          // Bin otsu_t goes into w0 / s0 while bin otsu_t-1 is compared
+          if (otsu_t < 5'd15) begin
+            w0 <= w0 + hist[otsu_t[3:0]];
+            s0 <= s0 + (AW + 4)'(hist[otsu_t[3:0]]) * (AW + 4)'(otsu_t[3:0]);
+          end
+          cand_t <= otsu_t[3:0];
+          cand_v <= otsu_t < 5'd15;
+
+          if (cand_better) begin
+            best_t   <= cand_t;
+            best_v   <= 1'b1;
+            best_num <= num;
+            best_den <= den;
+          end
+
+          otsu_t <= otsu_t + 1'b1;
+          if (otsu_t == 5'd15) state <= G_BBOX;
+        end
+
+        G_BBOX: begin
+          if (!scan_done) begin
+            cap_r <= scan_r;
+            cap_c <= scan_c;
+            if (scan_c == CW'(IMG_SIZE - 1)) begin
+              scan_c <= '0;
+              scan_r <= scan_r + 1'b1;
+              if (scan_r == CW'(IMG_SIZE - 1)) scan_done <= 1'b1;
+            end else begin
+              scan_c <= scan_c + 1'b1;
+            end
+          end
+          cap_v <= !scan_done;
+
+          if (cap_v && is_ink(rd_data, thresh, mode_light)) begin
+            any_ink <= 1'b1;
+            if (!any_ink || cap_c < x0) x0 <= cap_c;
+            if (!any_ink || cap_c > x1) x1 <= cap_c;
+            if (!any_ink) y0 <= cap_r;
+            y1 <= cap_r;  // rows come in order
+          end
+
+          if (scan_done && !cap_v) state <= G_MAP;
+        end
+
+        G_MAP: begin
+          if (map_issue) begin
+            map_p <= map_p + 1'b1;
+            if (map_c == CW'(IMG_SIZE - 1)) begin
+              map_c <= '0;
+              map_r <= map_r + 1'b1;
+            end else begin
+              map_c <= map_c + 1'b1;
+            end
+            if (map_p == AW'(PIXELS - 1)) map_done <= 1'b1;
+          end
+          cap_v    <= map_issue;
+          cap_bit  <= map_p[2:0];
+          cap_in   <= map_in;
+          cap_last <= map_last;
+          cap_end  <= map_p == AW'(PIXELS - 1);
+
+          if (cap_v) begin
+            if (cap_last) begin
+              out_byte  <= acc | (8'(cap_in && is_ink(rd_data, thresh, mode_light)) << cap_bit);
+              out_valid <= 1'b1;
+              acc       <= 8'd0;
+              if (cap_end) state <= G_DONE;
+            end else begin
+              acc[cap_bit] <= cap_in && is_ink(rd_data, thresh, mode_light);
+            end
+          end
+        end
+
+        default: ;
+      endcase
+    end
+  end
+
+endmodule
@@ -10,9 +10,25 @@ module image_buffer (
 
     input logic [7:0] data_in,
 
+    // Addressed writes (delta updates) land at addr_in and leave the
+    // sequential write pointer alone
+    input logic       write_addressed,
+    input logic [6:0] addr_in,
+
+    // valid/ready: one byte per cycle with write_valid && write_ready
+    input  logic write_valid,
     output logic write_ready,
-    input  logic write_request,
-    output logic write_ack,
+
+    // Pixels changed by addressed writes since the BNN last took the image;
+    // dirty_all means the whole image is new (reset, clear)
+    input  logic         dirty_clear,
+    output logic [899:0] dirty_mask,
+    output logic         dirty_all,
+
+    // CRC-32 of the bytes written in order since the last clear; only valid
+    // once the whole image has arrived and no addressed write has touched it
+    output logic [31:0] img_hash,
+    output logic        hash_valid,
 
     output logic [899:0] img_out
 );
@@ -29,23 +45,22 @@ module image_buffer (
 
   logic buffer_empty_reg;
 
-  logic write_lock;
+  logic [IMG_BYTE_SIZE-1:0] dirty_bytes;
 
-  logic write_request_d;  // Delayed version of write_request
-  logic write_request_edge;  // Rising-edge detected signal
+  logic [31:0] crc_reg;
 
-  //===================================================
-  // Rising-Edge Detection for write_request
-  //===================================================
-  always_ff @(posedge clk or negedge rst_n) begin
-    if (!rst_n) begin
-      write_request_d <= 1'b0;
-    end else begin
-      write_request_d <= write_request;  // Delay the write_request signal
-    end
-  end
+  // Reflected CRC-32 (polynomial 0xEDB88320), one byte per call
+  function automatic logic [31:0] crc32_byte(input logic [31:0] crc, input logic [7:0] data);
+    logic [31:0] c;
+    c = crc ^ {24'd0, data};
+    for (int i = 0; i < 8; i++) c = c[0] ? ((c >> 1) ^ 32'hEDB88320) : (c >> 1);
+    return c;
+  endfunction
 
-  assign write_request_edge = write_request && !write_request_d;  // Detect rising edge
+  logic write_lock;
+  logic write_fire;
+
+  assign write_fire = write_valid && write_ready;
 
   //===================================================
   // Write Logic + next‐addr tracking
@@ -55,21 +70,45 @@ module image_buffer (
       write_addr_internal <= 7'd0;
       next_addr_ff        <= 7'd0;
       buffer_empty_reg    <= 1'b1;
-      write_ack           <= 1'b0;
       write_lock          <= 1'b0;
+      dirty_bytes         <= '0;
+      dirty_all           <= 1'b1;
+      crc_reg             <= 32'hFFFFFFFF;
+      hash_valid          <= 1'b0;
     end else if (clear_buffer) begin
       write_addr_internal <= 7'd0;
       next_addr_ff        <= 7'd0;
       buffer_empty_reg    <= 1'b1;
-      write_ack           <= 1'b0;
       write_lock          <= 1'b0;
+      dirty_bytes         <= '0;
+      dirty_all           <= 1'b1;
+      crc_reg             <= 32'hFFFFFFFF;
+      hash_valid          <= 1'b0;
     end else begin
-      if (!write_lock && write_request_edge && (write_addr_internal < IMG_BYTE_SIZE)) begin
+      if (dirty_clear) begin
+        dirty_bytes <= '0;
+        dirty_all   <= 1'b0;
+      end
+
+      if (write_fire && write_addressed) begin
+
+        if (addr_in == IMG_BYTE_SIZE - 1) begin
+          internal_image_buffer[TOTAL_BITS-8+:4] <= data_in[3:0];
+          if (internal_image_buffer[TOTAL_BITS-8+:4] != data_in[3:0]) dirty_bytes[addr_in] <= 1'b1;
+        end else if (addr_in < IMG_BYTE_SIZE) begin
+          internal_image_buffer[addr_in*8+:8] <= data_in;
+          if (internal_image_buffer[addr_in*8+:8] != data_in) dirty_bytes[addr_in] <= 1'b1;
+        end
+
+        hash_valid <= 1'b0;  // the buffer no longer matches the streamed bytes
+      end else if (write_fire) begin
 
         if (write_addr_internal == IMG_BYTE_SIZE - 1) begin
           internal_image_buffer[TOTAL_BITS-8+:4] <= data_in[3:0]; // Only the lower four bits on the last byte
+          crc_reg <= crc32_byte(crc_reg, {4'd0, data_in[3:0]});
         end else begin
           internal_image_buffer[write_addr_internal*8+:8] <= data_in; // Writing the data to the image buffer
+          crc_reg <= crc32_byte(crc_reg, data_in);
         end
 
         write_addr_internal <= write_addr_internal + 1;  // Advancing the write address
@@ -77,11 +116,8 @@ module image_buffer (
 
         if (write_addr_internal + 1 == IMG_BYTE_SIZE) begin
           write_lock <= 1'b1;  // Lock writes when the buffer is full
+          hash_valid <= 1'b1;
         end
-
-        write_ack <= 1'b1;
-      end else begin
-        write_ack <= 1'b0;
       end
 
       buffer_empty_reg <= (write_addr_internal == 0);
@@ -91,9 +127,18 @@ module image_buffer (
   //===================================================
   // Status Flag and outputs
   //===================================================
-  assign write_ready = !write_lock && (write_addr_internal < IMG_BYTE_SIZE);
+  // Addressed writes are always taken; out-of-range addresses are dropped
+  assign write_ready = write_addressed || (!write_lock && (write_addr_internal < IMG_BYTE_SIZE));
   assign buffer_full = (write_addr_internal >= IMG_BYTE_SIZE);
   assign buffer_empty = buffer_empty_reg;
   assign img_out = internal_image_buffer;
+  assign img_hash = ~crc_reg;
+
+  genvar px;
+  generate
+    for (px = 0; px < IMG_BITS; px = px + 1) begin : dirty_px_gen
+      assign dirty_mask[px] = dirty_bytes[px/8];
+    end
+  endgenerate
 
 endmodule
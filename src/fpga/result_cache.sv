@@ -0,0 +1,78 @@
+`timescale 1ns / 1ps
+
+// Small fully-associative cache of recent results, keyed by the CRC-32 of
+// the uploaded image (see image_buffer). A hit lets the FSM report the
+// cached digit without running the BNN. Entries are replaced round-robin.
+module result_cache #(
+    parameter int ENTRIES = 4  // power of two, the victim pointer wraps
+) (
+    input logic clk,
+    input logic rst_n,
+    input logic flush,  // drop every entry, e.g. when the weights change
+
+    // Lookup
+    input  logic [31:0] lookup_hash,
+    input  logic        lookup,      // pulse: count this lookup as a hit or miss
+    output logic        hit,
+    output logic [ 3:0] hit_result,
+
+    // Fill with a freshly computed result
+    input logic        fill,
+    input logic [31:0] fill_hash,
+    input logic [ 3:0] fill_result,
+
+    output logic [15:0] hit_count,
+    output logic [15:0] miss_count
+);
+
+  logic [31:0] tag    [ENTRIES];
+  logic [ 3:0] result [ENTRIES];
+  logic        valid  [ENTRIES];
+
+  logic [$clog2(ENTRIES)-1:0] victim;
+
+  logic fill_present;
+
+  always_comb begin
+    hit = 1'b0;
+    hit_result = 4'd0;
+    fill_present = 1'b0;
+    for (int i = 0; i < ENTRIES; i++) begin
+      if (valid[i] && tag[i] == lookup_hash) begin
+        hit = 1'b1;
+        hit_result = result[i];
+      end
+      if (valid[i] && tag[i] == fill_hash) fill_present = 1'b1;
+    end
+  end
+
+  always_ff @(posedge clk or negedge rst_n) begin
+    if (!rst_n) begin
+      for (int i = 0; i < ENTRIES; i++) begin
+        tag[i]    <= 32'd0;
+        result[i] <= 4'd0;
+        valid[i]  <= 1'b0;
+      end
+      victim     <= '0;
+      hit_count  <= 16'd0;
+      miss_count <= 16'd0;
+    end else if (flush) begin
+      for (int i = 0; i < ENTRIES; i++) valid[i] <= 1'b0;
+      victim <= '0;
+    end else begin
+      if (lookup) begin
+        if (hit) hit_count <= hit_count + 1;
+        else miss_count <= miss_count + 1;
+      end
+
+      // A re-run of an image that is already cached must not take a second entry
+      if (fill && !fill_present) begin
+        tag[victim]    <= fill_hash;
+        result[victim] <= fill_result;
+        valid[victim]  <= 1'b1;
+        victim         <= victim + 1;
+      end
+    end
+  end
+
+endmodule
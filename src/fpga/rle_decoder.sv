@@ -0,0 +1,111 @@
+`timescale 1ns / 1ps
+
+// Run-length decoder for compressed image uploads (CMD_IMG_SEND_RLE).
+//
+// The payload describes the same 904-bit stream as a raw upload (900 pixels
+// LSB-first, padded with 4 zero bits) as alternating runs, starting with a
+// run of 0s. Each byte holds two 4-bit tokens, low nibble first:
+//   n = 0..14 : emit n bits of the current value, then toggle the value
+//   n = 15    : emit 15 bits of the current value, the run continues
+// Decoding stops once TOTAL_BITS bits have been produced; any tokens after
+// that are consumed and ignored.
+module rle_decoder (
+    input logic clk,
+    input logic rst_n,
+    input logic clear,
+
+    // Compressed bytes in
+    input  logic [7:0] in_byte,
+    input  logic       in_valid,
+    output logic       in_ready,
+
+    // Decoded image bytes out (held until out_valid && out_ready)
+    output logic [7:0] out_byte,
+    output logic       out_valid,
+    input  logic       out_ready,
+
+    output logic done
+);
+  parameter int TOTAL_BITS = 904;
+
+  logic [7:0] token_byte;
+  logic       have_byte;
+  logic       nibble_sel;  // 0 = low nibble next
+
+  logic [3:0] run_left;
+  logic       run_val;
+  logic       run_cont;
+
+  logic [7:0] byte_sr;
+  logic [2:0] bit_pos;
+  logic [9:0] bits_total;
+
+  logic [3:0] token;
+  assign token = nibble_sel ? token_byte[7:4] : token_byte[3:0];
+
+  assign in_ready = !have_byte;
+  assign done = (bits_total == TOTAL_BITS);
+
+  always_ff @(posedge clk or negedge rst_n) begin
+    if (!rst_n) begin
+      token_byte <= 8'd0;
+      have_byte  <= 1'b0;
+      nibble_sel <= 1'b0;
+      run_left   <= 4'd0;
+      run_val    <= 1'b0;
+      run_cont   <= 1'b0;
+      byte_sr    <= 8'd0;
+      bit_pos    <= 3'd0;
+      bits_total <= 10'd0;
+      out_byte   <= 8'd0;
+      out_valid  <= 1'b0;
+    end else if (clear) begin
+      token_byte <= 8'd0;
+      have_byte  <= 1'b0;
+      nibble_sel <= 1'b0;
+      run_left   <= 4'd0;
+      run_val    <= 1'b0;
+      run_cont   <= 1'b0;
+      byte_sr    <= 8'd0;
+      bit_pos    <= 3'd0;
+      bits_total <= 10'd0;
+      out_byte   <= 8'd0;
+      out_valid  <= 1'b0;
+    end else begin
+      if (out_ready) out_valid <= 1'b0;
+
+      if (in_valid && !have_byte) begin
+        token_byte <= in_byte;
+        have_byte  <= 1'b1;
+        nibble_sel <= 1'b0;
+      end
+
+      if (!out_valid && run_left != 0 && !done) begin
+        // Expand one bit per cycle into the output byte
+        byte_sr[bit_pos] <= run_val;
+        bit_pos          <= bit_pos + 1;
+        bits_total       <= bits_total + 1;
+        run_left         <= run_left - 1;
+
+        if (run_left == 4'd1 && !run_cont) run_val <= ~run_val;
+
+        if (bit_pos == 3'd7) begin
+          out_byte  <= {run_val, byte_sr[6:0]};
+          out_valid <= 1'b1;
+          byte_sr   <= 8'd0;
+        end
+      end else if (run_left == 0 && have_byte) begin
+        // Load the next token
+        nibble_sel <= ~nibble_sel;
+        if (nibble_sel) have_byte <= 1'b0;
+
+        if (!done) begin
+          run_left <= token;
+          run_cont <= (token == 4'd15);
+          if (token == 4'd0) run_val <= ~run_val;
+        end
+      end
+    end
+  end
+
+endmodule
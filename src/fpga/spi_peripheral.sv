@@ -7,6 +7,7 @@ module spi_peripheral (
     // SPI pins (asynchronous domain)
     input logic SCLK,
     input logic COPI,
+    input logic [3:1] copi_quad,  // lanes 1-3, only sampled in quad_mode
     input logic spi_cs_n,
 
     // Data interface
@@ -15,8 +16,14 @@ module spi_peripheral (
 
     // Control Signals
     input  logic rx_enable,
+    input  logic quad_mode,  // 4 bits per SCLK, {copi_quad, COPI} MSB nibble first
     output logic byte_valid,
-    input  logic byte_taken
+    input  logic byte_ready
+`ifndef SYNTHESIS
+    ,
+    // bytes completed while the previous one was still waiting
+    output logic [15:0] dropped_bytes
+`endif
 );
   // -------------------- Local Parameters
   localparam logic CPOL = 0;
@@ -27,8 +34,7 @@ module spi_peripheral (
   // -------- FSM States
   typedef enum logic [1:0] {
     SPI_IDLE,
-    SPI_RX,
-    SPI_BYTE_READY
+    SPI_RX
   } spi_state_t;
 
   spi_state_t spi_state, spi_next_state;
@@ -46,6 +52,7 @@ module spi_peripheral (
   logic sclk_sync_1, sclk_sync_2, sclk_sync_3;
   logic copi_sync_1, copi_sync_2, copi_sync_3;
   logic cs_sync_1, cs_sync_2, cs_sync_3;
+  logic [3:1] quad_sync_1, quad_sync_2, quad_sync_3;
 
   logic sclk_filt, sclk_filt_prev;
 
@@ -62,6 +69,10 @@ module spi_peripheral (
       cs_sync_1   <= 1;
       cs_sync_2   <= 1;
       cs_sync_3   <= 1;
+
+      quad_sync_1 <= 0;
+      quad_sync_2 <= 0;
+      quad_sync_3 <= 0;
     end else begin
       sclk_sync_1 <= SCLK;
       sclk_sync_2 <= sclk_sync_1;
@@ -74,6 +85,10 @@ module spi_peripheral (
       cs_sync_1   <= spi_cs_n;
       cs_sync_2   <= cs_sync_1;
       cs_sync_3   <= cs_sync_2;
+
+      quad_sync_1 <= copi_quad;
+      quad_sync_2 <= quad_sync_1;
+      quad_sync_3 <= quad_sync_2;
     end
   end
 
@@ -87,6 +102,15 @@ module spi_peripheral (
   end
 
   logic [3:0] bit_cnt;
+  logic byte_last_edge;
+  logic byte_done;  // the shift register completes a byte this cycle
+  logic [7:0] shift_reg;
+  logic [7:0] shift_next;
+
+  // The rising edge that completes a byte: 8th bit, or 2nd nibble in quad mode
+  assign byte_last_edge = quad_mode ? (bit_cnt == 4'd4) : (bit_cnt == 4'd7);
+  assign byte_done = (spi_state == SPI_RX) && !cs_sync_3 && byte_last_edge && sclk_rising;
+  assign shift_next = quad_mode ? {shift_reg[3:0], quad_sync_3, copi_sync_3} : {shift_reg[6:0], copi_sync_3};
 
   always_comb begin
     spi_next_state = spi_state;
@@ -97,17 +121,8 @@ module spi_peripheral (
       end
 
       SPI_RX: begin
-        if (cs_sync_3) begin
-          // Transition to SPI_IDLE if CS is de-asserted mid-frame
-          spi_next_state = SPI_IDLE;
-        end else if (bit_cnt == 4'd7 && sclk_rising) begin
-          spi_next_state = SPI_BYTE_READY;
-        end
-      end
-
-      SPI_BYTE_READY: begin
-        if (cs_sync_2) spi_next_state = SPI_IDLE;
-        else if (byte_taken) spi_next_state = SPI_IDLE;
+        // Transition to SPI_IDLE if CS is de-asserted mid-frame
+        if (cs_sync_3) spi_next_state = SPI_IDLE;
       end
 
       default: spi_next_state = SPI_IDLE;
@@ -117,9 +132,7 @@ module spi_peripheral (
   //-----------------------------------------
   // Shift Register and Bit Counter
   //-----------------------------------------
-  logic [7:0] shift_reg;
-  logic [7:0] shift_reg_stable;
-
+  // Keeps receiving while the previous byte waits in the output register
   always_ff @(posedge clk or negedge rst_n) begin
     if (!rst_n) begin
       bit_cnt   <= 0;
@@ -134,42 +147,49 @@ module spi_peripheral (
         end
 
         SPI_RX: begin
-          if (cs_sync_3) begin
+          if (cs_sync_3 || byte_done) begin
             bit_cnt   <= 0;
             shift_reg <= 0;
+          end else if (sclk_rising && quad_mode) begin
+            shift_reg <= shift_next;
+            bit_cnt   <= bit_cnt + 4;
           end else if (sclk_rising) begin
-            shift_reg <= {shift_reg[6:0], copi_sync_3};
+            shift_reg <= shift_next;
             bit_cnt   <= bit_cnt + 1;
           end
         end
 
-        SPI_BYTE_READY: begin
-          if (byte_taken) begin
-            bit_cnt   <= 0;
-            shift_reg <= 0;
-          end
-        end
-
         default: ;
       endcase
     end
   end
 
-  // ====== Output Latching ======
-  always_ff @(posedge clk or negedge rst_n) begin
-    if (!rst_n) shift_reg_stable <= 0;
-    else if (spi_state == SPI_BYTE_READY) shift_reg_stable <= shift_reg;
-  end
+  // ====== Output Register ======
+  // valid/ready: the byte is held until byte_valid && byte_ready. A byte
+  // completed while rx_enable is low, or while the previous one is still
+  // held, is dropped, and so is a held byte when CS rises.
+  logic [7:0] shift_reg_stable;
 
   always_ff @(posedge clk or negedge rst_n) begin
-    if (!rst_n) byte_valid <= 0;
-    else byte_valid <= (spi_state == SPI_BYTE_READY);
+    if (!rst_n) begin
+      byte_valid       <= 1'b0;
+      shift_reg_stable <= 8'd0;
+      rx_data_is_zero  <= 1'b0;
+    end else if (byte_done && rx_enable && (!byte_valid || byte_ready)) begin
+      byte_valid       <= 1'b1;
+      shift_reg_stable <= shift_next;
+      rx_data_is_zero  <= (shift_next == 8'd0);
+    end else if (byte_ready || cs_sync_2) begin
+      byte_valid <= 1'b0;
+    end
   end
 
+`ifndef SYNTHESIS
   always_ff @(posedge clk or negedge rst_n) begin
-    if (!rst_n) rx_data_is_zero <= 0;
-    else if (spi_state == SPI_BYTE_READY) rx_data_is_zero <= (shift_reg_stable == 8'd0);
+    if (!rst_n) dropped_bytes <= '0;
+    else if (byte_done && rx_enable && byte_valid && !byte_ready) dropped_bytes <= dropped_bytes + 1'b1;
   end
+`endif
 
   assign spi_rx_data = shift_reg_stable;
 
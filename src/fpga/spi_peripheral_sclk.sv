@@ -0,0 +1,122 @@
+`timescale 1ns / 1ps
+
+// Drop-in alternative to spi_peripheral (mode 0) that shifts COPI on SCLK
+// itself instead of oversampling the pins on clk. Each completed byte is
+// written into an async_fifo on its 8th SCLK rising edge; the clk side
+// presents the FIFO head on spi_rx_data / byte_valid with the same
+// valid/ready handshake as spi_peripheral. SCLK is then limited by the pad
+// timing and the FIFO drain rate rather than by the synchronizers.
+//
+// Differences from spi_peripheral: bytes are kept until taken even if CS
+// rises first, and bytes that arrive while rx_enable is low are discarded
+// when they reach the clk side instead of at CS assertion.
+module spi_peripheral_sclk #(
+    parameter int FIFO_ADDR_BITS = 3
+) (
+    input logic rst_n,
+    input logic clk,
+
+    // SPI pins (asynchronous domain)
+    input logic SCLK,
+    input logic COPI,
+    input logic [3:1] copi_quad,
+    input logic spi_cs_n,
+
+    // Data interface
+    output logic [7:0] spi_rx_data,
+    output logic rx_data_is_zero,
+
+    // Control Signals
+    input  logic rx_enable,
+    input  logic quad_mode,  // quasi-static: set before the frame starts
+    output logic byte_valid,
+    input  logic byte_ready
+`ifndef SYNTHESIS
+    ,
+    // bytes that found the receive FIFO full
+    output logic [15:0] dropped_bytes
+`endif
+);
+
+  //===================================================
+  // SCLK domain: shift register, reset by CS between frames
+  //===================================================
+  logic       frame_rst_n;
+  logic [2:0] bit_cnt;
+  logic [6:0] shift_reg;
+
+  logic       fifo_wr_en;
+  logic [7:0] fifo_wr_data;
+  logic       fifo_full;
+
+  assign frame_rst_n  = rst_n && !spi_cs_n;
+  assign fifo_wr_en   = quad_mode ? bit_cnt == 3'd4 : bit_cnt == 3'd7;
+  assign fifo_wr_data = quad_mode ? {shift_reg[3:0], copi_quad, COPI} : {shift_reg, COPI};
+
+  always_ff @(posedge SCLK or negedge frame_rst_n) begin
+    if (!frame_rst_n) begin
+      bit_cnt   <= '0;
+      shift_reg <= '0;
+    end else begin
+      if (quad_mode) begin
+        bit_cnt   <= bit_cnt + 3'd4;
+        shift_reg <= {shift_reg[2:0], copi_quad, COPI};
+      end else begin
+        bit_cnt   <= bit_cnt + 1'b1;
+        shift_reg <= {shift_reg[5:0], COPI};
+      end
+    end
+  end
+
+`ifndef SYNTHESIS
+  // SCLK domain too, but only read by the testbench
+  always_ff @(posedge SCLK or negedge rst_n) begin
+    if (!rst_n) dropped_bytes <= '0;
+    else if (!spi_cs_n && fifo_wr_en && fifo_full) dropped_bytes <= dropped_bytes + 1'b1;
+  end
+`endif
+
+  //===================================================
+  // Clock domain crossing
+  //===================================================
+  logic       fifo_rd_en;
+  logic [7:0] fifo_rd_data;
+  logic       fifo_empty;
+
+  async_fifo #(
+      .WIDTH    (8),
+      .ADDR_BITS(FIFO_ADDR_BITS)
+  ) rx_fifo (
+      .rst_n  (rst_n),
+      .wclk   (SCLK),
+      .wr_en  (fifo_wr_en),
+      .wr_data(fifo_wr_data),
+      .full   (fifo_full),
+      .rclk   (clk),
+      .rd_en  (fifo_rd_en),
+      .rd_data(fifo_rd_data),
+      .empty  (fifo_empty)
+  );
+
+  //===================================================
+  // clk domain: present one byte at a time
+  //===================================================
+  // valid/ready: the FIFO head moves into the output register whenever it is
+  // empty or being taken, so bytes can be handed over on consecutive cycles
+  assign fifo_rd_en = (!byte_valid || byte_ready) && !fifo_empty;
+
+  always_ff @(posedge clk or negedge rst_n) begin
+    if (!rst_n) begin
+      byte_valid      <= 1'b0;
+      spi_rx_data     <= 8'd0;
+      rx_data_is_zero <= 1'b0;
+    end else if (fifo_rd_en) begin
+      byte_valid      <= rx_enable;
+      spi_rx_data     <= fifo_rd_data;
+      rx_data_is_zero <= fifo_rd_data == 8'd0;
+    end else if (byte_ready) begin
+      byte_valid <= 1'b0;
+    end
+  end
+
+endmodule
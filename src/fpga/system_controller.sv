@@ -1,19 +1,37 @@
 `ifndef SYNTHESIS
 `include "spi_peripheral.sv"
+`include "spi_peripheral_sclk.sv"
+`include "async_fifo.sv"
 `include "bnn_interface.sv"
 `include "debug_module.sv"
 `include "fsm_controller.sv"
 `include "image_buffer.sv"
+`include "result_cache.sv"
+`include "rle_decoder.sv"
+`include "gray_ingest.sv"
+`include "weight_loader.sv"
 `include "seven_seg_display.sv"
 `endif`timescale 1ns / 1ps
 
-module system_controller (
+module system_controller #(
+    // Display refresh: each digit is lit for 2^(REFRESH_BITS-2) clocks
+    parameter int REFRESH_BITS = 18,
+    // bnn_top replicas behind the bnn_interface dispatcher
+    parameter int NUM_BNN_CORES = 1,
+    // 1: receive on SCLK and cross to clk through a FIFO (spi_peripheral_sclk)
+    //    instead of oversampling the SPI pins on clk
+    parameter bit SPI_SCLK_DOMAIN = 0,
+    // 1: bnn_top shares clk and the result reaches status_code_reg and the
+    //    display without the clock-crossing and extra register stages
+    parameter bit LOW_LATENCY = 0
+) (
     input logic clk,
     input logic rst_n_pin,
 
     // SPI
     input logic SCLK,
     input logic COPI,
+    input logic [3:1] copi_quad,  // extra data lanes for CMD_IMG_SEND_QUAD; COPI is lane 0
     input logic spi_cs_n,
 
     // System Outputs
@@ -27,12 +45,46 @@ module system_controller (
     // `ifndef SYNTHESIS
     input logic debug_trigger
     // `endif
+`ifndef SYNTHESIS
+    ,
+    // Result cache statistics
+    output logic [15:0] cache_hit_count,
+    output logic [15:0] cache_miss_count,
+    // Bytes the SPI receiver had to drop (0 on a healthy link)
+    output logic [15:0] spi_drop_count,
+    // bnn_top's out_valid, to time the result path
+    output logic bnn_out_valid
+`endif
 );
   //===================================================
   // Internal Signals
   //===================================================
   logic result_ready;
 
+  // Result served from the cache instead of the BNN
+  logic       cached_result_valid;
+  logic [3:0] cached_result;
+
+  // Strip mode: one result per tile, tile 0 on the leftmost digit (an[3])
+  logic       strip_start;
+  logic       strip_active;
+  logic       strip_result;
+  logic [1:0] strip_result_idx;
+  logic       strip_mode;
+  logic [3:0] strip_valid;
+  logic [3:0] strip_digits[0:3];
+
+  // Runtime weight upload
+  logic        weight_start;
+  logic        weight_byte_valid;
+  logic        weight_ready;
+  logic        weight_done;
+  logic        weight_ok;
+  logic        weight_bank;
+  logic        weight_wr_en;
+  logic [13:0] weight_wr_addr;
+  logic [ 7:0] weight_wr_data;
+
   // ----------------- Synchronous Reset -----------------
   logic rst_sync_ff1;
   logic rst_sync_ff2;
@@ -165,13 +217,43 @@ module system_controller (
   logic [6:0] seg_reg_stage1;
   logic [6:0] seg_reg_stage2;
 
+  logic [REFRESH_BITS-1:0] refresh_cnt;
+  logic [1:0] digit_sel;
+  logic       shown_valid;
+  logic [3:0] shown_digit;
+
+  // A cache hit is shown the same way as a BNN result
   always_ff @(posedge clk or negedge rst_n) begin
     if (!rst_n) begin
       result_reg       <= 4'd0;
       result_reg_valid <= 1'b0;
     end else begin
-      result_reg_valid <= result_ready;
-      if (result_ready) result_reg <= result_out;
+      result_reg_valid <= result_ready || cached_result_valid;
+      if (cached_result_valid) result_reg <= cached_result;
+      else if (result_ready) result_reg <= result_out;
+    end
+  end
+
+  // Digit multiplexing
+  always_ff @(posedge clk or negedge rst_n) begin
+    if (!rst_n) refresh_cnt <= '0;
+    else refresh_cnt <= refresh_cnt + 1;
+  end
+
+  assign digit_sel = refresh_cnt[REFRESH_BITS-1-:2];
+
+  // Digit an[i] shows tile 3-i in strip mode, the single result otherwise
+  always_comb begin
+    if (strip_mode) begin
+      shown_valid = strip_valid[~digit_sel];
+      shown_digit = strip_digits[~digit_sel];
+    end else if (LOW_LATENCY) begin
+      // result_reg only delays result_out by a clock; skip it
+      shown_valid = result_ready || cached_result_valid;
+      shown_digit = cached_result_valid ? cached_result : result_out;
+    end else begin
+      shown_valid = result_reg_valid;
+      shown_digit = result_reg;
     end
   end
 
@@ -179,11 +261,11 @@ module system_controller (
     seg_reg_stage1 = 7'b111_1111;  // blank when no result
     decimalPoint   = 1'b0;
 
-    if (!result_reg_valid) begin
+    if (!shown_valid) begin
       seg_reg_stage1 = 7'b111_1111;  // blank when no result
       decimalPoint   = 1'b0;
     end else begin
-      case (result_reg)
+      case (shown_digit)
         4'b0000: begin
           seg_reg_stage1 = 7'b100_0000;  // Display 0
           decimalPoint   = 1'b1;
@@ -239,9 +321,15 @@ module system_controller (
     end
   end
 
+  // Anodes are registered with the segments so they switch together
   always_ff @(posedge clk or negedge rst_n) begin
-    if (!rst_n) seg_reg_stage2 <= 7'b111_1111;
-    else seg_reg_stage2 <= seg_reg_stage1;
+    if (!rst_n) begin
+      seg_reg_stage2 <= 7'b111_1111;
+      an             <= 4'b1111;
+    end else begin
+      seg_reg_stage2 <= seg_reg_stage1;
+      an             <= ~(4'b0001 << digit_sel);  // active-low
+    end
   end
 
   assign seg = seg_reg_stage2;
@@ -250,26 +338,63 @@ module system_controller (
   // FSM Controller
   //===================================================
   logic spi_rx_enable;
+  logic spi_quad;
   logic buffer_full, buffer_empty, clear_internal;
   logic [6:0] buffer_write_addr;
   logic [7:0] buffer_write_data;
+  logic       buffer_write_addressed;
   logic       bnn_enable;
-  logic       buffer_write_request;
+  logic       bnn_result_ack;
+  logic       bnn_ready_for_input;
+  logic       buffer_write_valid;
   logic       buffer_write_ready;
   logic [7:0] spi_rx_data;
   logic       spi_byte_valid;
-  logic       byte_taken;
-  logic       buffer_write_ack;
+  logic       spi_byte_ready;
+
+  logic       rle_start;
+  logic       rle_load;
+  logic       rle_in_ready;
+  logic [7:0] rle_out_byte;
+  logic       rle_out_valid;
+  logic       rle_out_ready;
+
+  logic       gray_start;
+  logic       gray_load;
+  logic       gray_in_ready;
+  logic [7:0] gray_out_byte;
+  logic       gray_out_valid;
+  logic       gray_out_ready;
+
+  logic       cache_hit;
+  logic       cache_lookup;
+
+  logic       buffer_restart;
+  logic       bnn_img_latched;
+
+  // FC_BINARY and CONV_SPECIALIZED compute with weights fixed at synthesis
+  // time, so an upload could only change part of the network
+`ifdef FC_BINARY
+  localparam bit WEIGHT_UPLOAD = 0;
+`elsif CONV_SPECIALIZED
+  localparam bit WEIGHT_UPLOAD = 0;
+`else
+  localparam bit WEIGHT_UPLOAD = 1;
+`endif
 
-  controller_fsm u_controller_fsm (
+  controller_fsm #(
+      .LOW_LATENCY  (LOW_LATENCY),
+      .WEIGHT_UPLOAD(WEIGHT_UPLOAD)
+  ) u_controller_fsm (
       .clk  (clk),
       .rst_n(rst_n),
 
       // SPI
       .spi_rx_data(spi_rx_data),
       .spi_byte_valid(spi_byte_valid),
-      .byte_taken(byte_taken),
+      .byte_ready(spi_byte_ready),
       .rx_enable(spi_rx_enable),
+      .spi_quad(spi_quad),
 
       // Commands
       .status_code_reg(status_code_reg),
@@ -279,16 +404,53 @@ module system_controller (
       .buffer_full (buffer_full),
       .buffer_empty(buffer_empty),
 
-      .buffer_write_request(buffer_write_request),
-      .buffer_write_ready  (buffer_write_ready),
-      .write_ack           (buffer_write_ack),
+      .buffer_write_valid(buffer_write_valid),
+      .buffer_write_ready(buffer_write_ready),
 
       .buffer_write_data(buffer_write_data),
       .buffer_write_addr(buffer_write_addr),
+      .buffer_write_addressed(buffer_write_addressed),
+
+      // Compressed image decoder
+      .rle_start    (rle_start),
+      .rle_load     (rle_load),
+      .rle_in_ready (rle_in_ready),
+      .rle_out_byte (rle_out_byte),
+      .rle_out_valid(rle_out_valid),
+      .rle_out_ready(rle_out_ready),
+
+      // Grayscale ingest
+      .gray_start    (gray_start),
+      .gray_load     (gray_load),
+      .gray_in_ready (gray_in_ready),
+      .gray_out_byte (gray_out_byte),
+      .gray_out_valid(gray_out_valid),
+      .gray_out_ready(gray_out_ready),
+
+      // Result cache
+      .cache_hit   (cache_hit),
+      .cache_lookup(cache_lookup),
+
+      // Strip mode
+      .buffer_restart  (buffer_restart),
+      .strip_start     (strip_start),
+      .strip_active    (strip_active),
+      .strip_result    (strip_result),
+      .strip_result_idx(strip_result_idx),
+
+      // Weight upload
+      .weight_start     (weight_start),
+      .weight_byte_valid(weight_byte_valid),
+      .weight_ready     (weight_ready),
+      .weight_done      (weight_done),
+      .weight_ok        (weight_ok),
 
       // BNN Interface
       .result_ready(result_ready),
-      .bnn_enable  (bnn_enable)
+      .bnn_ready_for_input(bnn_ready_for_input),
+      .bnn_img_latched(bnn_img_latched),
+      .bnn_enable(bnn_enable),
+      .result_ack(bnn_result_ack)
   );
 
   //===================================================
@@ -296,29 +458,104 @@ module system_controller (
   //===================================================
   logic spi_rx_data_is_zero;
 
-  spi_peripheral spi_peripheral_inst (
-      .rst_n(rst_n),
+  generate
+    if (SPI_SCLK_DOMAIN) begin : g_spi_sclk
+      spi_peripheral_sclk spi_peripheral_inst (
+          .rst_n(rst_n),
+          .clk  (clk),
+
+          // SPI Pins
+          .SCLK(SCLK),
+          .COPI(COPI),
+          .copi_quad(copi_quad),
+          .spi_cs_n(spi_cs_n),
+
+          // Data Interface
+          .spi_rx_data(spi_rx_data),
+          .rx_data_is_zero(spi_rx_data_is_zero),
+
+          // Control Signals
+          .rx_enable (spi_rx_enable),
+          .quad_mode (spi_quad),
+          .byte_valid(spi_byte_valid),
+          .byte_ready(spi_byte_ready)
+`ifndef SYNTHESIS
+          ,
+          .dropped_bytes(spi_drop_count)
+`endif
+      );
+    end else begin : g_spi_sync
+      spi_peripheral spi_peripheral_inst (
+          .rst_n(rst_n),
+          .clk  (clk),
+
+          // SPI Pins
+          .SCLK(SCLK),
+          .COPI(COPI),
+          .copi_quad(copi_quad),
+          .spi_cs_n(spi_cs_n),
+
+          // Data Interface
+          .spi_rx_data(spi_rx_data),
+          .rx_data_is_zero(spi_rx_data_is_zero),
+
+          // Control Signals
+          .rx_enable (spi_rx_enable),
+          .quad_mode (spi_quad),
+          .byte_valid(spi_byte_valid),
+          .byte_ready(spi_byte_ready)
+`ifndef SYNTHESIS
+          ,
+          .dropped_bytes(spi_drop_count)
+`endif
+      );
+    end
+  endgenerate
+
+  //===================================================
+  // Compressed Image Decoder
+  //===================================================
+  rle_decoder u_rle_decoder (
       .clk  (clk),
+      .rst_n(rst_n),
+      .clear(clear_internal || rle_start),
 
-      // SPI Pins
-      .SCLK(SCLK),
-      .COPI(COPI),
-      .spi_cs_n(spi_cs_n),
+      .in_byte (spi_rx_data),
+      .in_valid(rle_load),
+      .in_ready(rle_in_ready),
 
-      // Data Interface
-      .spi_rx_data(spi_rx_data),
-      .rx_data_is_zero(spi_rx_data_is_zero),
+      .out_byte (rle_out_byte),
+      .out_valid(rle_out_valid),
+      .out_ready(rle_out_ready),
 
-      // Control Signals
-      .rx_enable (spi_rx_enable),
-      .byte_valid(spi_byte_valid),
-      .byte_taken(byte_taken)
+      .done()
+  );
+
+  //===================================================
+  // Grayscale Ingest
+  //===================================================
+  gray_ingest u_gray_ingest (
+      .clk  (clk),
+      .rst_n(rst_n),
+      .clear(clear_internal || gray_start),
+
+      .in_byte (spi_rx_data),
+      .in_valid(gray_load),
+      .in_ready(gray_in_ready),
+
+      .out_byte (gray_out_byte),
+      .out_valid(gray_out_valid),
+      .out_ready(gray_out_ready)
   );
 
   //===================================================
   // Image Buffer
   //===================================================
   logic [899:0] image_buffer_internal;
+  logic [899:0] image_dirty_mask;
+  logic image_dirty_all;
+  logic [31:0] image_hash;
+  logic image_hash_valid;
   logic clear_done;
 
 
@@ -327,26 +564,38 @@ module system_controller (
       .rst_n(rst_n),
 
       // inputs
-      .write_request(buffer_write_request),
-      .write_ready  (buffer_write_ready),
-      .write_ack    (buffer_write_ack),
+      .write_valid(buffer_write_valid),
+      .write_ready(buffer_write_ready),
 
-      .clear_buffer(clear_internal),
+      .clear_buffer(clear_internal || buffer_restart),
       .clear_done  (clear_done),
       .data_in     (buffer_write_data),
 
+      .write_addressed(buffer_write_addressed),
+      .addr_in        (buffer_write_addr),
+
       //outputs
       .buffer_full (buffer_full),
       .buffer_empty(buffer_empty),
-      .img_out     (image_buffer_internal)
+
+      .dirty_clear(bnn_img_latched),
+      .dirty_mask (image_dirty_mask),
+      .dirty_all  (image_dirty_all),
+
+      .img_hash  (image_hash),
+      .hash_valid(image_hash_valid),
+
+      .img_out(image_buffer_internal)
   );
 
   //===================================================
   // BNN Interface 
   //===================================================
-  logic bnn_ready_for_input;
 
-  bnn_interface u_bnn_interface (
+  bnn_interface #(
+      .NUM_BNN_CORES(NUM_BNN_CORES),
+      .LOW_LATENCY  (LOW_LATENCY)
+  ) u_bnn_interface (
       .clk  (clk),
       .rst_n(rst_n),
 
@@ -354,13 +603,125 @@ module system_controller (
       .img_in(image_buffer_internal),  // Packed vector matches declaration
       .result_out(result_out),  // Match 4-bit width
 
+      .dirty_in(image_dirty_mask),
+      .dirty_all(image_dirty_all),
+      .img_latched(bnn_img_latched),
+
       // Control signals
       .result_ready(result_ready),
       .bnn_enable(bnn_enable),
       .bnn_ready_for_input(bnn_ready_for_input),
-      .bnn_clear(clear_internal)
+      .bnn_clear(clear_internal),
+      .result_ack(bnn_result_ack),
+
+      // Weight upload
+      .weight_bank   (weight_bank),
+      .weight_wr_en  (weight_wr_en),
+      .weight_wr_addr(weight_wr_addr),
+      .weight_wr_data(weight_wr_data),
+
+      // Debug log
+      .debug_enable(debug_trigger)
+`ifndef SYNTHESIS
+      ,
+      .bnn_done(bnn_out_valid)
+`endif
+  );
+
+  //===================================================
+  // Weight Loader
+  //===================================================
+  weight_loader u_weight_loader (
+      .clk  (clk),
+      .rst_n(rst_n),
+
+      .start     (weight_start),
+      .data_in   (spi_rx_data),
+      .data_valid(weight_byte_valid),
+      .ready     (weight_ready),
+      .done      (weight_done),
+      .crc_ok    (weight_ok),
+
+      .wr_en  (weight_wr_en),
+      .wr_addr(weight_wr_addr),
+      .wr_data(weight_wr_data),
+      .bank   (weight_bank)
   );
 
+  //===================================================
+  // Result Cache
+  //===================================================
+  logic       cache_raw_hit;
+  logic [3:0] cache_hit_result;
+  logic       cache_fill;
+  logic       result_ready_d;
+  logic [15:0] cache_hits, cache_misses;
+
+  assign cache_hit = cache_raw_hit && image_hash_valid;
+
+  // Remember every BNN result computed on a fully streamed image; strip
+  // tiles bypass the cache
+  always_ff @(posedge clk or negedge rst_n) begin
+    if (!rst_n) result_ready_d <= 1'b0;
+    else result_ready_d <= result_ready;
+  end
+
+  assign cache_fill = result_ready && !result_ready_d && image_hash_valid && !strip_active;
+
+  result_cache u_result_cache (
+      .clk  (clk),
+      .rst_n(rst_n),
+      .flush(weight_done && weight_ok),  // cached digits came from the old weights
+
+      .lookup_hash(image_hash),
+      .lookup     (cache_lookup && image_hash_valid),
+      .hit        (cache_raw_hit),
+      .hit_result (cache_hit_result),
+
+      .fill       (cache_fill),
+      .fill_hash  (image_hash),
+      .fill_result(result_out),
+
+      .hit_count (cache_hits),
+      .miss_count(cache_misses)
+  );
+
+  // Hold a cached result on the display until the FSM leaves S_RESULT_RDY
+  always_ff @(posedge clk or negedge rst_n) begin
+    if (!rst_n) begin
+      cached_result_valid <= 1'b0;
+      cached_result       <= 4'd0;
+    end else if (clear_internal || bnn_result_ack || bnn_enable) begin
+      cached_result_valid <= 1'b0;
+    end else if (cache_lookup && cache_hit) begin
+      cached_result_valid <= 1'b1;
+      cached_result       <= cache_hit_result;
+    end
+  end
+
+  // Strip results are latched per tile as the FSM collects them; any
+  // single-image job (BNN run or cache hit) goes back to one result
+  always_ff @(posedge clk or negedge rst_n) begin
+    if (!rst_n) begin
+      strip_mode  <= 1'b0;
+      strip_valid <= 4'b0000;
+    end else if (clear_internal || (bnn_enable && !strip_active) || (cache_lookup && cache_hit)) begin
+      strip_mode  <= 1'b0;
+      strip_valid <= 4'b0000;
+    end else if (strip_start) begin
+      strip_mode  <= 1'b1;
+      strip_valid <= 4'b0000;
+    end else if (strip_result) begin
+      strip_valid[strip_result_idx]  <= 1'b1;
+      strip_digits[strip_result_idx] <= result_out;
+    end
+  end
+
+`ifndef SYNTHESIS
+  assign cache_hit_count  = cache_hits;
+  assign cache_miss_count = cache_misses;
+`endif
+
   //===================================================
   // Seven Segment Display
   //===================================================
@@ -386,7 +747,7 @@ module system_controller (
       // FSM
       .spi_rx_data(spi_rx_data),
       .spi_byte_valid(spi_byte_valid),
-      .byte_taken(byte_taken),
+      .byte_taken(spi_byte_valid && spi_byte_ready),
       .spi_rx_enable(spi_rx_enable),
       .status_code_reg(status_code_reg),
       .clear_internal(clear_internal),
@@ -418,7 +779,7 @@ module system_controller (
       .src_clk  (SCLK),
       .src_pulse(spi_byte_valid),
       .dst_clk  (clk),
-      .dst_pulse(byte_taken),
+      .dst_pulse(spi_byte_valid && spi_byte_ready),
 
       // Cycles
       .main_cycle_cnt(main_cycle_cnt),
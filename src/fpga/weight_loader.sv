@@ -0,0 +1,111 @@
+`timescale 1ns / 1ps
+
+// Runtime weight upload (CMD_LOAD_WEIGHTS). Streams a weight image into the
+// inactive bank of every bnn_top and switches banks only if the CRC-32 that
+// follows the image matches, so a bad upload never reaches the BNN.
+//
+// Weight image, WEIGHT_BYTES bytes, then the CRC-32 of those bytes LSB first:
+//   0   ..  31     conv1_weights: 2 bytes per output channel, bits [8:0] used
+//   32  ..  319    conv2_weights: 18 bytes per output channel (144 bits)
+//   320 .. 11839   fc_weights: Q8.8 words, low byte first, [oc*FC_IC + ic]
+// Bytes are LSB first within each weight word, like image uploads.
+module weight_loader #(
+    parameter int WEIGHT_BYTES = 11840,
+    // clk cycles each write is held: more than one BNN clock period (clk/4),
+    // so every core sees it; a repeated write is harmless
+    parameter int WRITE_HOLD   = 5
+) (
+    input logic clk,
+    input logic rst_n,
+
+    // From controller_fsm
+    input  logic       start,       // pulse: CMD_LOAD_WEIGHTS received
+    input  logic [7:0] data_in,
+    input  logic       data_valid,  // byte taken with data_valid && ready
+    output logic       ready,
+    output logic       done,        // pulse after the last CRC byte
+    output logic       crc_ok,      // with done: banks were switched
+
+    // To every bnn_top (through bnn_interface)
+    output logic        wr_en,
+    output logic [13:0] wr_addr,
+    output logic [ 7:0] wr_data,
+    output logic        bank       // bank the BNN computes with
+);
+
+  logic [13:0] byte_cnt;  // payload and CRC bytes received
+  logic [ 2:0] hold_cnt;
+  logic [31:0] crc_reg;
+  logic [31:0] crc_rx;
+  logic        active;
+  logic        commit;  // pulse: the received CRC matched
+
+  // The bank survives reset like the weights themselves; it only changes
+  // when an upload has been verified
+  logic bank_reg = 1'b0;
+
+  // Reflected CRC-32 (polynomial 0xEDB88320), same as image_buffer
+  function automatic logic [31:0] crc32_byte(input logic [31:0] crc, input logic [7:0] data);
+    logic [31:0] c;
+    c = crc ^ {24'd0, data};
+    for (int i = 0; i < 8; i++) c = c[0] ? ((c >> 1) ^ 32'hEDB88320) : (c >> 1);
+    return c;
+  endfunction
+
+  assign ready = active && hold_cnt == 0;
+  assign bank  = bank_reg;
+
+  always_ff @(posedge clk) begin
+    if (commit) bank_reg <= ~bank_reg;
+  end
+
+  always_ff @(posedge clk or negedge rst_n) begin
+    if (!rst_n) begin
+      byte_cnt <= '0;
+      hold_cnt <= '0;
+      crc_reg  <= 32'hFFFFFFFF;
+      crc_rx   <= '0;
+      active   <= 1'b0;
+      done     <= 1'b0;
+      crc_ok   <= 1'b0;
+      commit   <= 1'b0;
+      wr_en    <= 1'b0;
+      wr_addr  <= '0;
+      wr_data  <= '0;
+    end else begin
+      done   <= 1'b0;
+      commit <= 1'b0;
+
+      if (hold_cnt != 0) begin
+        hold_cnt <= hold_cnt - 1'b1;
+        if (hold_cnt == 3'd1) wr_en <= 1'b0;
+      end
+
+      if (start) begin
+        byte_cnt <= '0;
+        crc_reg  <= 32'hFFFFFFFF;
+        active   <= 1'b1;
+        crc_ok   <= 1'b0;
+      end else if (ready && data_valid) begin
+        byte_cnt <= byte_cnt + 1'b1;
+
+        if (byte_cnt < 14'(WEIGHT_BYTES)) begin
+          crc_reg  <= crc32_byte(crc_reg, data_in);
+          wr_en    <= 1'b1;
+          wr_addr  <= byte_cnt;
+          wr_data  <= data_in;
+          hold_cnt <= 3'(WRITE_HOLD);
+        end else begin
+          crc_rx <= {data_in, crc_rx[31:8]};
+          if (byte_cnt == 14'(WEIGHT_BYTES + 3)) begin
+            active <= 1'b0;
+            done   <= 1'b1;
+            crc_ok <= {data_in, crc_rx[31:8]} == ~crc_reg;
+            commit <= {data_in, crc_rx[31:8]} == ~crc_reg;
+          end
+        end
+      end
+    end
+  end
+
+endmodule
@@ -0,0 +1,143 @@
+// Classifies images offline with the bit-sliced batch engine (bnn_batch),
+// or benchmarks it against the scalar reference model.
+//
+// usage: batch_classify <bnn_top.sv> <images.txt> [threads]
+//        batch_classify <bnn_top.sv> --bench <count> [threads]
+//
+// images.txt holds one 900-character '0'/'1' image per line; the digit the
+// FPGA would show (10 for a blank image) is printed for each, in order.
+// A malformed line is reported with its line number and nothing is printed.
+// --bench classifies <count> noisy copies of the digit set, reports the
+// throughput, and exits non-zero if any result differs from bnn::classify.
+
+#include "bnn_batch.hpp"
+#include "digits.h"
+
+#include <chrono>
+#include <exception>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Every digit with a few random pixels flipped, as fc_binarize's noisy set
+std::vector<std::string> noisy_digits(size_t count)
+{
+    const std::vector<std::string> clean = {
+        bnn::flatten(digit_0), bnn::flatten(digit_1), bnn::flatten(digit_2),
+        bnn::flatten(digit_3), bnn::flatten(digit_4), bnn::flatten(digit_5),
+        bnn::flatten(digit_6), bnn::flatten(digit_8), bnn::flatten(digit_9)};
+
+    std::vector<std::string> out;
+    out.reserve(count);
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<int> px_dist{0, bnn::IMG_SIZE * bnn::IMG_SIZE - 1};
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string flat = clean[i % clean.size()];
+        for (int f = 0; f < 12; ++f)
+        {
+            char &px = flat[px_dist(rng)];
+            px = (px == '1') ? '0' : '1';
+        }
+        out.push_back(flat);
+    }
+    return out;
+}
+
+int bench(const bnn::Weights &w, size_t count, unsigned threads)
+{
+    std::vector<std::string> images = noisy_digits(count);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<int> batch = bnn::classify_batch(w, images, threads);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "[BATCH] " << count << " images, " << bnn::BATCH_LANES << " per word, "
+              << (threads ? std::to_string(threads) : std::string("all")) << " threads: " << std::fixed
+              << std::setprecision(3) << seconds << " s, " << std::setprecision(0) << count / seconds
+              << " images/s\n"
+              << std::defaultfloat;
+
+    // The scalar model is much slower; compare at most 20000 images
+    size_t step = std::max<size_t>(1, count / 20000);
+    size_t checked = 0, mismatches = 0;
+    for (size_t i = 0; i < count; i += step, ++checked)
+    {
+        int expected = bnn::classify(w, images[i]);
+        if (batch[i] != expected)
+        {
+            if (mismatches++ < 10)
+                std::cerr << "[BATCH] Image " << i << ": batch " << batch[i] << ", model " << expected << "\n";
+        }
+    }
+    std::cout << "[BATCH] " << checked << " results checked against bnn::classify, " << mismatches
+              << " mismatches\n";
+    return mismatches ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int run(int argc, char **argv)
+{
+    bool bench_mode = argc > 2 && std::string(argv[2]) == "--bench";
+    int args = bench_mode ? 4 : 3;
+    if (argc != args && argc != args + 1)
+    {
+        std::cerr << "usage: " << argv[0] << " <bnn_top.sv> <images.txt> [threads]\n"
+                  << "       " << argv[0] << " <bnn_top.sv> --bench <count> [threads]\n";
+        return EXIT_FAILURE;
+    }
+
+    bnn::Weights w = bnn::load_weights(argv[1]);
+    unsigned threads = argc > args ? static_cast<unsigned>(std::stoul(argv[args])) : 0;
+
+    if (bench_mode)
+        return bench(w, std::stoull(argv[3]), threads);
+
+    std::ifstream in(argv[2]);
+    if (!in)
+    {
+        std::cerr << "cannot open " << argv[2] << "\n";
+        return EXIT_FAILURE;
+    }
+    std::vector<std::string> images;
+    size_t line_no = 0;
+    for (std::string line; std::getline(in, line);)
+    {
+        ++line_no;
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty())
+            continue;
+        if (line.size() != bnn::IMG_SIZE * bnn::IMG_SIZE || line.find_first_not_of("01") != std::string::npos)
+        {
+            std::cerr << argv[2] << ":" << line_no << ": not a 900-character '0'/'1' image\n";
+            return EXIT_FAILURE;
+        }
+        images.push_back(line);
+    }
+
+    for (int digit : bnn::classify_batch(w, images, threads))
+        std::cout << digit << "\n";
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        return run(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << argv[0] << ": " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,373 @@
+#include "bnn_batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+namespace bnn
+{
+
+namespace
+{
+
+// One bit per image; GCC/Clang vector extension so the bitwise operators
+// map to AVX2 registers when available
+#if defined(__AVX2__)
+typedef uint64_t Word __attribute__((vector_size(32)));
+#else
+typedef uint64_t Word __attribute__((vector_size(8)));
+#endif
+constexpr int WORD_U64 = BATCH_LANES / 64;
+
+constexpr int CONV1_TAPS = 9;
+constexpr int CONV2_TAPS = CONV1_OC * 9;
+constexpr int CONV1_SUM_BITS = 4; // 0..9 matching taps
+constexpr int CONV2_SUM_BITS = 8; // 0..144 matching taps
+constexpr int FC_BITS = 16;
+constexpr int CLASS_BITS = 4;
+
+const Word ZERO = {};
+const Word ONES = ~ZERO;
+
+inline bool all_set(const Word &w)
+{
+    for (int i = 0; i < WORD_U64; ++i)
+        if (w[i] != ~uint64_t{0})
+            return false;
+    return true;
+}
+
+inline bool lane_bit(const Word &w, int lane)
+{
+    return (w[lane >> 6] >> (lane & 63)) & 1;
+}
+
+// Range of matching-tap counts for which ConvPoolCore fires
+struct Range
+{
+    int lo, hi;
+};
+
+// The conv sum is 2 * matches - taps, wrapped to 8 bits, and fires when
+// non-negative. Expressed as ranges of `matches` so no wrap is needed in
+// the bit-sliced domain.
+std::vector<Range> fire_ranges(int taps)
+{
+    std::vector<Range> out;
+    for (int m = 0; m <= taps; ++m)
+    {
+        bool fires = static_cast<int8_t>(2 * m - taps) >= 0;
+        if (!fires)
+            continue;
+        if (!out.empty() && out.back().hi == m - 1)
+            out.back().hi = m;
+        else
+            out.push_back({m, m});
+    }
+    return out;
+}
+
+inline void csa(Word &carry, Word &sum, Word a, Word b, Word c)
+{
+    Word u = a ^ b;
+    carry = (a & b) | (u & c);
+    sum = u ^ c;
+}
+
+// Per-lane count of the N bits bit(0..N-1) as P bit-planes, LSB first.
+// Harley-Seal: blocks of eight go through a carry-save tree into the
+// ones/twos/fours planes, about five operations per bit; only the carry
+// out of a block ripples through the upper planes.
+template <int P, int N, typename Bit>
+void count_ones(Bit bit, Word (&sum)[P])
+{
+    static_assert(P > 3 && N < (1 << P), "count does not fit");
+    Word ones = ZERO, twos = ZERO, fours = ZERO;
+    std::fill(sum, sum + P, ZERO);
+
+    auto ripple = [&sum](Word c, int from)
+    {
+        for (int k = from; k < P; ++k)
+        {
+            Word t = sum[k] & c;
+            sum[k] ^= c;
+            c = t;
+        }
+    };
+
+    int i = 0;
+    for (; i + 8 <= N; i += 8)
+    {
+        Word twos_a, twos_b, fours_a, fours_b, eights;
+        csa(twos_a, ones, ones, bit(i), bit(i + 1));
+        csa(twos_b, ones, ones, bit(i + 2), bit(i + 3));
+        csa(fours_a, twos, twos, twos_a, twos_b);
+        csa(twos_a, ones, ones, bit(i + 4), bit(i + 5));
+        csa(twos_b, ones, ones, bit(i + 6), bit(i + 7));
+        csa(fours_b, twos, twos, twos_a, twos_b);
+        csa(eights, fours, fours, fours_a, fours_b);
+        ripple(eights, 3);
+    }
+    for (; i < N; ++i)
+    {
+        Word c = ones & bit(i);
+        ones ^= bit(i);
+        Word c2 = twos & c;
+        twos ^= c;
+        Word c4 = fours & c2;
+        fours ^= c2;
+        ripple(c4, 3);
+    }
+
+    sum[0] = ones;
+    sum[1] = twos;
+    sum[2] = fours;
+}
+
+// Lanes whose P-bit value is >= k
+template <int P>
+Word at_least(const Word (&v)[P], int k)
+{
+    if (k <= 0)
+        return ONES;
+    if (k >= (1 << P))
+        return ZERO;
+    Word ge = ONES;
+    for (int i = 0; i < P; ++i)
+        ge = ((k >> i) & 1) ? (v[i] & ge) : (v[i] | ge);
+    return ge;
+}
+
+template <int P>
+Word in_ranges(const Word (&v)[P], const std::vector<Range> &ranges)
+{
+    Word hit = ZERO;
+    for (const Range &r : ranges)
+        hit |= at_least(v, r.lo) & ~at_least(v, r.hi + 1);
+    return hit;
+}
+
+// Weights as XOR masks: pixel ^ mask is the XNOR of pixel and weight
+struct Tables
+{
+    std::vector<Word> conv1; // [oc*9 + tap]
+    std::vector<Word> conv2; // [oc*144 + ic*9 + tap]
+    std::vector<uint16_t> fc;
+    std::vector<uint16_t> fc_neg_sum; // per class, -(sum of weights) mod 2^16
+    std::vector<Range> conv1_fire;
+    std::vector<Range> conv2_fire;
+
+    explicit Tables(const Weights &w)
+        : conv1_fire(fire_ranges(CONV1_TAPS)), conv2_fire(fire_ranges(CONV2_TAPS))
+    {
+        for (const auto &oc : w.conv1)
+            for (int t = 0; t < CONV1_TAPS; ++t)
+                conv1.push_back(oc[t] ? ZERO : ONES);
+        for (const auto &oc : w.conv2)
+            for (int t = 0; t < CONV2_TAPS; ++t)
+                conv2.push_back(oc[t] ? ZERO : ONES);
+        for (int oc = 0; oc < FC_OC; ++oc)
+        {
+            uint16_t sum = 0;
+            for (int ic = 0; ic < FC_IC; ++ic)
+            {
+                uint16_t wt = static_cast<uint16_t>(w.fc[oc * FC_IC + ic]);
+                fc.push_back(wt);
+                sum = static_cast<uint16_t>(sum + wt);
+            }
+            fc_neg_sum.push_back(static_cast<uint16_t>(-sum));
+        }
+    }
+};
+
+struct Scratch
+{
+    std::vector<Word> img = std::vector<Word>(IMG_SIZE * IMG_SIZE);
+    std::vector<Word> pool1 = std::vector<Word>(CONV1_OC * POOL1_SIZE * POOL1_SIZE);
+    std::vector<Word> fc_in = std::vector<Word>(FC_IC);
+};
+
+// ConvPoolCore over all lanes: in[ic][in_size^2] -> out[oc][out_size^2]
+template <int TAPS, int P>
+void conv_pool(const Word *in, int in_size, const std::vector<Word> &masks, const std::vector<Range> &fire,
+               Word *out)
+{
+    constexpr int IC = TAPS / 9;
+    int out_size = (in_size - 2) / 2;
+    int oc_count = static_cast<int>(masks.size()) / TAPS;
+    Word sum[P];
+
+    // Offset of every tap from the window's top-left pixel
+    int offset[TAPS];
+    for (int ic = 0; ic < IC; ++ic)
+        for (int tap = 0; tap < 9; ++tap)
+            offset[ic * 9 + tap] = ic * in_size * in_size + (tap / 3) * in_size + tap % 3;
+
+    for (int oc = 0; oc < oc_count; ++oc)
+    {
+        const Word *m = &masks[oc * TAPS];
+        for (int pr = 0; pr < out_size; ++pr)
+            for (int pc = 0; pc < out_size; ++pc)
+            {
+                Word fired = ZERO;
+                for (int quad = 0; quad < 4 && !all_set(fired); ++quad)
+                {
+                    const Word *window = in + (2 * pr + (quad >> 1)) * in_size + 2 * pc + (quad & 1);
+                    count_ones<P, TAPS>([&](int i) { return window[offset[i]] ^ m[i]; }, sum);
+                    fired |= in_ranges(sum, fire);
+                }
+                out[oc * out_size * out_size + pr * out_size + pc] = fired;
+            }
+    }
+}
+
+// FC.sv per lane: sum of (x ? w : -w) mod 2^16 = 2 * sum(x ? w : 0) - sum(w)
+void fc_q88(const Tables &t, const Word *fc_in, Word (&out)[FC_OC][FC_BITS])
+{
+    for (int oc = 0; oc < FC_OC; ++oc)
+    {
+        Word acc[FC_BITS];
+        std::fill(acc, acc + FC_BITS, ZERO);
+        for (int ic = 0; ic < FC_IC; ++ic)
+        {
+            uint16_t wt = t.fc[oc * FC_IC + ic];
+            if (!wt)
+                continue;
+            Word x = fc_in[ic];
+            Word carry = ZERO;
+            for (int k = 0; k < FC_BITS; ++k)
+            {
+                if ((wt >> k) & 1)
+                {
+                    Word ax = acc[k] ^ x;
+                    Word s = ax ^ carry;
+                    carry = (acc[k] & x) | (carry & ax);
+                    acc[k] = s;
+                }
+                else
+                {
+                    Word s = acc[k] ^ carry;
+                    carry = acc[k] & carry;
+                    acc[k] = s;
+                }
+            }
+        }
+
+        // Double, then add the constant -sum(w)
+        uint16_t c = t.fc_neg_sum[oc];
+        Word carry = ZERO;
+        for (int k = 0; k < FC_BITS; ++k)
+        {
+            Word a = k ? acc[k - 1] : ZERO;
+            if ((c >> k) & 1)
+            {
+                out[oc][k] = ~(a ^ carry);
+                carry = a | carry;
+            }
+            else
+            {
+                out[oc][k] = a ^ carry;
+                carry = a & carry;
+            }
+        }
+    }
+}
+
+// Comparator.sv: first strict maximum of the signed scores, as 4 bit-planes
+void argmax(const Word (&scores)[FC_OC][FC_BITS], Word (&idx)[CLASS_BITS])
+{
+    Word best[FC_BITS];
+    std::copy(scores[0], scores[0] + FC_BITS, best);
+    std::fill(idx, idx + CLASS_BITS, ZERO);
+
+    for (int oc = 1; oc < FC_OC; ++oc)
+    {
+        const Word *v = scores[oc];
+        Word gt = ZERO;
+        for (int k = 0; k < FC_BITS - 1; ++k)
+            gt = (v[k] & ~best[k]) | (~(v[k] ^ best[k]) & gt);
+        // Sign bit: the negative side is the smaller one
+        Word vs = v[FC_BITS - 1], bs = best[FC_BITS - 1];
+        gt = (bs & ~vs) | (~(vs ^ bs) & gt);
+
+        for (int k = 0; k < FC_BITS; ++k)
+            best[k] ^= (best[k] ^ v[k]) & gt;
+        for (int b = 0; b < CLASS_BITS; ++b)
+            idx[b] ^= (idx[b] ^ (((oc >> b) & 1) ? ONES : ZERO)) & gt;
+    }
+}
+
+void run_batch(const Tables &t, const std::string *flats, int count, int *out, Scratch &s)
+{
+    // Transpose into one word per pixel
+    std::fill(s.img.begin(), s.img.end(), ZERO);
+    for (int lane = 0; lane < count; ++lane)
+    {
+        const std::string &flat = flats[lane];
+        uint64_t bit = uint64_t{1} << (lane & 63);
+        for (int px = 0; px < IMG_SIZE * IMG_SIZE; ++px)
+            if (flat[px] == '1')
+                s.img[px][lane >> 6] |= bit;
+    }
+
+    Word any = ZERO;
+    for (const Word &px : s.img)
+        any |= px;
+
+    conv_pool<CONV1_TAPS, CONV1_SUM_BITS>(s.img.data(), IMG_SIZE, t.conv1, t.conv1_fire, s.pool1.data());
+    conv_pool<CONV2_TAPS, CONV2_SUM_BITS>(s.pool1.data(), POOL1_SIZE, t.conv2, t.conv2_fire, s.fc_in.data());
+
+    Word scores[FC_OC][FC_BITS];
+    Word idx[CLASS_BITS];
+    fc_q88(t, s.fc_in.data(), scores);
+    argmax(scores, idx);
+
+    for (int lane = 0; lane < count; ++lane)
+    {
+        int cls = 0;
+        for (int b = 0; b < CLASS_BITS; ++b)
+            cls |= lane_bit(idx[b], lane) << b;
+        out[lane] = lane_bit(any, lane) ? cls : BLANK_RESULT;
+    }
+}
+
+} // namespace
+
+std::vector<int> classify_batch(const Weights &w, const std::vector<std::string> &flats, unsigned threads)
+{
+    for (const auto &flat : flats)
+        if (flat.size() != IMG_SIZE * IMG_SIZE)
+            throw std::invalid_argument("classify_batch: image is not 900 pixels");
+
+    const Tables tables(w);
+    std::vector<int> out(flats.size());
+    size_t batches = (flats.size() + BATCH_LANES - 1) / BATCH_LANES;
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, batches));
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]()
+    {
+        Scratch scratch;
+        for (size_t b = next++; b < batches; b = next++)
+        {
+            size_t first = b * BATCH_LANES;
+            int count = static_cast<int>(std::min<size_t>(BATCH_LANES, flats.size() - first));
+            run_batch(tables, &flats[first], count, &out[first], scratch);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i)
+        pool.emplace_back(worker);
+    if (batches)
+        worker();
+    for (auto &th : pool)
+        th.join();
+    return out;
+}
+
+} // namespace bnn
@@ -0,0 +1,29 @@
+#pragma once
+
+// Bit-sliced batch version of bnn::classify for offline rescoring. Images
+// are transposed so that bit `lane` of every machine word belongs to one
+// image; each XNOR / popcount / OR / add of the network is then a handful
+// of word operations covering BATCH_LANES images at once. Results are
+// identical to the scalar model, including the 8-bit conv and 16-bit FC
+// wrap-around.
+
+#include "bnn_model.hpp"
+
+#include <string>
+#include <vector>
+
+namespace bnn
+{
+
+// Images per word: 256 when built for AVX2, 64 otherwise
+#if defined(__AVX2__)
+constexpr int BATCH_LANES = 256;
+#else
+constexpr int BATCH_LANES = 64;
+#endif
+
+// classify() for every image in `flats` (900-character '0'/'1' strings),
+// spread over `threads` worker threads (0: one per hardware thread)
+std::vector<int> classify_batch(const Weights &w, const std::vector<std::string> &flats, unsigned threads = 0);
+
+} // namespace bnn
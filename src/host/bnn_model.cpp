@@ -0,0 +1,418 @@
+#include "bnn_model.hpp"
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace bnn
+{
+
+namespace
+{
+
+std::string read_file(const std::string &path)
+{
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error("cannot open " + path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+// Hex digits of every sized literal (e.g. 9'h1c4) in the `= { ... }`
+// initializer that follows `name[`
+std::vector<std::string> array_literals(const std::string &src, const std::string &name)
+{
+    size_t pos = src.find(name + "[");
+    if (pos == std::string::npos)
+        throw std::runtime_error("array " + name + " not found");
+    size_t open = src.find('{', pos);
+    size_t close = src.find('}', open);
+    if (open == std::string::npos || close == std::string::npos)
+        throw std::runtime_error("no initializer for " + name);
+
+    std::vector<std::string> out;
+    std::stringstream body(src.substr(open + 1, close - open - 1));
+    std::string tok;
+    while (std::getline(body, tok, ','))
+    {
+        size_t h = tok.find("'h");
+        if (h == std::string::npos)
+            continue;
+        std::string hex;
+        for (size_t i = h + 2; i < tok.size() && std::isxdigit(static_cast<unsigned char>(tok[i])); ++i)
+            hex += tok[i];
+        out.push_back(hex);
+    }
+    return out;
+}
+
+// Bits of a hex literal, LSB first
+std::vector<uint8_t> hex_bits(const std::string &hex, int width)
+{
+    std::vector<uint8_t> bits(width, 0);
+    for (int i = 0; i < width; ++i)
+    {
+        size_t nib = i / 4;
+        if (nib >= hex.size())
+            break;
+        int v = std::stoi(std::string(1, hex[hex.size() - 1 - nib]), nullptr, 16);
+        bits[i] = (v >> (i % 4)) & 1;
+    }
+    return bits;
+}
+
+std::vector<std::vector<uint8_t>> pool1_maps(const Weights &w, const std::string &flat)
+{
+    std::vector<std::vector<uint8_t>> img(1, std::vector<uint8_t>(IMG_SIZE * IMG_SIZE));
+    for (int i = 0; i < IMG_SIZE * IMG_SIZE; ++i)
+        img[0][i] = flat[i] == '1';
+    return conv_pool(img, IMG_SIZE, w.conv1);
+}
+
+} // namespace
+
+// ConvPoolCore: a pooled pixel is the OR of its four conv pixels, and a conv
+// pixel fires when the 8-bit wrapping +/-1 sum over all taps is non-negative
+std::vector<std::vector<uint8_t>> conv_pool(const std::vector<std::vector<uint8_t>> &img, int in_size,
+                                            const std::vector<std::vector<uint8_t>> &weights)
+{
+    int out_size = (in_size - 2) / 2;
+    std::vector<std::vector<uint8_t>> out(weights.size(), std::vector<uint8_t>(out_size * out_size, 0));
+
+    for (size_t oc = 0; oc < weights.size(); ++oc)
+        for (int pr = 0; pr < out_size; ++pr)
+            for (int pc = 0; pc < out_size; ++pc)
+            {
+                uint8_t fired = 0;
+                for (int quad = 0; quad < 4 && !fired; ++quad)
+                {
+                    int base = (2 * pr + (quad >> 1)) * in_size + 2 * pc + (quad & 1);
+                    int8_t popcount = 0;
+                    for (size_t ic = 0; ic < img.size(); ++ic)
+                        for (int tap = 0; tap < 9; ++tap)
+                        {
+                            int px = base + (tap / 3) * in_size + tap % 3;
+                            bool match = img[ic][px] == weights[oc][ic * 9 + tap];
+                            popcount = static_cast<int8_t>(popcount + (match ? 1 : -1));
+                        }
+                    fired = popcount >= 0;
+                }
+                out[oc][pr * out_size + pc] = fired;
+            }
+    return out;
+}
+
+Weights load_weights(const std::string &bnn_top_sv)
+{
+    std::string src = read_file(bnn_top_sv);
+    Weights w;
+
+    for (const auto &hex : array_literals(src, "conv1_weights"))
+        w.conv1.push_back(hex_bits(hex, 9));
+    for (const auto &hex : array_literals(src, "conv2_weights"))
+        w.conv2.push_back(hex_bits(hex, CONV1_OC * 9));
+    for (const auto &hex : array_literals(src, "fc_weights"))
+        w.fc.push_back(static_cast<int16_t>(std::stoul(hex, nullptr, 16)));
+
+    if (w.conv1.size() != CONV1_OC || w.conv2.size() != CONV2_OC || w.fc.size() != FC_IC * FC_OC)
+        throw std::runtime_error("unexpected weight table sizes in " + bnn_top_sv);
+    return w;
+}
+
+void write_weights(const std::string &svh, const Weights &w)
+{
+    std::ofstream out(svh);
+    if (!out)
+        throw std::runtime_error("cannot write " + svh);
+
+    // Bits LSB first -> sized hex literal
+    auto literal = [](const std::vector<uint8_t> &bits)
+    {
+        std::string hex;
+        for (int nib = (static_cast<int>(bits.size()) + 3) / 4 - 1; nib >= 0; --nib)
+        {
+            int v = 0;
+            for (int b = 0; b < 4; ++b)
+                if (nib * 4 + b < static_cast<int>(bits.size()) && bits[nib * 4 + b])
+                    v |= 1 << b;
+            hex += "0123456789abcdef"[v];
+        }
+        return std::to_string(bits.size()) + "'h" + hex;
+    };
+
+    auto array = [&](const std::string &decl, const std::vector<std::vector<uint8_t>> &rows)
+    {
+        out << decl << " = {\n";
+        for (size_t i = 0; i < rows.size(); ++i)
+            out << "    " << literal(rows[i]) << (i + 1 < rows.size() ? ",\n" : "\n");
+        out << "  };\n";
+    };
+
+    out << "  // Generated by src/host/bnn_sweep.cpp for CONV1_OC=" << w.conv1.size()
+        << ", CONV2_OC=" << w.conv2.size() << ". Do not edit by hand.\n";
+    array("  logic [CONV1_IC*9-1:0] conv1_weights[0:CONV1_OC-1]", w.conv1);
+    array("  logic [CONV1_OC*9-1:0] conv2_weights[0:CONV2_OC-1]", w.conv2);
+
+    out << "  (* ram_style = \"block\" *)\n  logic signed [15:0] fc_weights[0:FC_IC*FC_OC-1] = {\n";
+    for (size_t i = 0; i < w.fc.size(); ++i)
+        out << "    16'h" << std::hex << static_cast<uint16_t>(w.fc[i]) << std::dec
+            << (i + 1 < w.fc.size() ? ",\n" : "\n");
+    out << "  };\n";
+}
+
+std::vector<uint8_t> weight_image(const Weights &w)
+{
+    std::vector<uint8_t> out;
+    out.reserve(WEIGHT_BYTES);
+
+    auto pack = [&out](const std::vector<uint8_t> &bits, int bytes)
+    {
+        for (int b = 0; b < bytes; ++b)
+        {
+            uint8_t v = 0;
+            for (int i = 0; i < 8 && b * 8 + i < static_cast<int>(bits.size()); ++i)
+                v |= bits[b * 8 + i] << i;
+            out.push_back(v);
+        }
+    };
+
+    for (const auto &oc : w.conv1)
+        pack(oc, CONV1_WEIGHT_BYTES);
+    for (const auto &oc : w.conv2)
+        pack(oc, CONV2_WEIGHT_BYTES);
+    for (int16_t v : w.fc)
+    {
+        out.push_back(static_cast<uint16_t>(v) & 0xFF);
+        out.push_back(static_cast<uint16_t>(v) >> 8);
+    }
+    return out;
+}
+
+uint32_t crc32(const std::vector<uint8_t> &bytes)
+{
+    uint32_t c = 0xFFFFFFFF;
+    for (uint8_t b : bytes)
+    {
+        c ^= b;
+        for (int i = 0; i < 8; ++i)
+            c = (c & 1) ? (c >> 1) ^ 0xEDB88320 : c >> 1;
+    }
+    return ~c;
+}
+
+BinaryFC load_binary_fc(const std::string &svh)
+{
+    std::string src = read_file(svh);
+    BinaryFC fc;
+
+    for (const auto &hex : array_literals(src, "fc_bin_weights"))
+        fc.words.push_back(static_cast<uint32_t>(std::stoul(hex, nullptr, 16)));
+    for (const auto &hex : array_literals(src, "fc_bin_scale"))
+        fc.scale.push_back(static_cast<int16_t>(std::stoul(hex, nullptr, 16)));
+    for (const auto &hex : array_literals(src, "fc_bin_bias"))
+        fc.bias.push_back(static_cast<int16_t>(std::stoul(hex, nullptr, 16)));
+
+    if (fc.words.size() != FC_OC * FC_WORDS || fc.scale.size() != FC_OC || fc.bias.size() != FC_OC)
+        throw std::runtime_error("unexpected table sizes in " + svh);
+    return fc;
+}
+
+void write_binary_fc(const std::string &svh, const BinaryFC &fc)
+{
+    std::ofstream out(svh);
+    if (!out)
+        throw std::runtime_error("cannot write " + svh);
+
+    auto hex16 = [](int16_t v)
+    {
+        std::stringstream ss;
+        ss << "16'h" << std::hex << static_cast<uint16_t>(v);
+        return ss.str();
+    };
+
+    out << "// Binarized FC weights for FCBinary.sv, generated by src/host/fc_binarize.cpp\n"
+        << "// from fc_weights in bnn_top.sv. Do not edit by hand.\n"
+        << "(* rom_style = \"block\" *)\n"
+        << "logic [" << FC_WORD - 1 << ":0] fc_bin_weights[0:" << FC_OC * FC_WORDS - 1 << "] = {\n";
+    for (size_t i = 0; i < fc.words.size(); ++i)
+        out << "  " << FC_WORD << "'h" << std::hex << std::setw(8) << std::setfill('0') << fc.words[i]
+            << std::dec << (i + 1 < fc.words.size() ? ",\n" : "\n");
+    out << "};\n";
+
+    out << "logic signed [15:0] fc_bin_scale[0:" << FC_OC - 1 << "] = {";
+    for (size_t i = 0; i < fc.scale.size(); ++i)
+        out << (i ? ", " : "") << hex16(fc.scale[i]);
+    out << "};\n";
+
+    out << "logic signed [15:0] fc_bin_bias[0:" << FC_OC - 1 << "] = {";
+    for (size_t i = 0; i < fc.bias.size(); ++i)
+        out << (i ? ", " : "") << hex16(fc.bias[i]);
+    out << "};\n";
+}
+
+std::vector<uint8_t> pool1(const Weights &w, const std::string &flat)
+{
+    std::vector<uint8_t> bits;
+    for (const auto &ch : pool1_maps(w, flat))
+        bits.insert(bits.end(), ch.begin(), ch.end());
+    return bits;
+}
+
+std::string flatten(const std::vector<std::string> &rows)
+{
+    std::string flat;
+    for (const auto &row : rows)
+        flat += row;
+    return flat;
+}
+
+std::vector<uint8_t> features(const Weights &w, const std::string &flat)
+{
+    auto pool2 = conv_pool(pool1_maps(w, flat), POOL1_SIZE, w.conv2);
+
+    std::vector<uint8_t> fc_in;
+    for (const auto &ch : pool2)
+        fc_in.insert(fc_in.end(), ch.begin(), ch.end());
+    return fc_in;
+}
+
+std::vector<int16_t> fc_q88(const Weights &w, const std::vector<uint8_t> &fc_in)
+{
+    std::vector<int16_t> out(FC_OC, 0);
+    for (int oc = 0; oc < FC_OC; ++oc)
+    {
+        uint16_t acc = 0;
+        for (int ic = 0; ic < FC_IC; ++ic)
+        {
+            int16_t wt = w.fc[oc * FC_IC + ic];
+            acc = static_cast<uint16_t>(acc + (fc_in[ic] ? wt : -wt));
+        }
+        out[oc] = static_cast<int16_t>(acc);
+    }
+    return out;
+}
+
+std::vector<int32_t> fc_bounds(const Weights &w)
+{
+    std::vector<int32_t> bounds(FC_OC * FC_BOUND_CHECKS, 0);
+    for (int oc = 0; oc < FC_OC; ++oc)
+    {
+        int32_t suffix = 0;
+        for (int ic = FC_IC - 1; ic >= 0; --ic)
+        {
+            suffix += std::abs(w.fc[oc * FC_IC + ic]);
+            if (ic % FC_BOUND_STRIDE == 0)
+                bounds[oc * FC_BOUND_CHECKS + ic / FC_BOUND_STRIDE] = suffix;
+        }
+    }
+    return bounds;
+}
+
+void write_fc_bounds(const std::string &svh, const std::vector<int32_t> &bounds)
+{
+    std::ofstream out(svh);
+    if (!out)
+        throw std::runtime_error("cannot write " + svh);
+
+    out << "// Suffix bounds for FC's early exit, generated by src/host/fc_bounds.cpp\n"
+        << "// from fc_weights in bnn_top.sv. Do not edit by hand.\n"
+        << "// fc_bounds[oc*" << FC_BOUND_CHECKS << " + k] = sum of |fc_weights| of class oc, inputs "
+        << FC_BOUND_STRIDE << "*k onwards\n"
+        << "(* rom_style = \"distributed\" *)\n"
+        << "logic [31:0] fc_bounds[0:" << FC_OC * FC_BOUND_CHECKS - 1 << "] = {\n";
+    for (size_t i = 0; i < bounds.size(); ++i)
+        out << "  32'd" << bounds[i] << (i + 1 < bounds.size() ? ",\n" : "\n");
+    out << "};\n";
+}
+
+std::vector<int16_t> fc_q88_early_exit(const Weights &w, const std::vector<int32_t> &bounds,
+                                       const std::vector<uint8_t> &fc_in, int *cycles)
+{
+    std::vector<int16_t> out(FC_OC, 0);
+    int16_t best = 0;
+    bool best_valid = false;
+    int n = 2; // the cycles that take the job and publish the sums
+    for (int oc = 0; oc < FC_OC; ++oc)
+    {
+        int32_t part = 0;
+        bool cut = false;
+        for (int ic = 0; ic < FC_IC; ++ic)
+        {
+            if (best_valid && ic % FC_BOUND_STRIDE == 0)
+            {
+                int32_t bound = bounds[oc * FC_BOUND_CHECKS + ic / FC_BOUND_STRIDE];
+                if (part + bound <= best && part - bound >= INT16_MIN)
+                {
+                    out[oc] = static_cast<int16_t>(part + bound);
+                    n += ic + 1;
+                    cut = true;
+                    break;
+                }
+            }
+            int16_t wt = w.fc[oc * FC_IC + ic];
+            part += fc_in[ic] ? wt : -wt;
+        }
+        if (cut)
+            continue;
+
+        out[oc] = static_cast<int16_t>(static_cast<uint16_t>(part));
+        n += FC_IC + 1;
+        if (!best_valid || out[oc] > best)
+            best = out[oc];
+        best_valid = true;
+    }
+    if (cycles)
+        *cycles = n;
+    return out;
+}
+
+std::vector<int16_t> fc_binary(const BinaryFC &fc, const std::vector<uint8_t> &fc_in)
+{
+    std::vector<int16_t> out(FC_OC, 0);
+    for (int oc = 0; oc < FC_OC; ++oc)
+    {
+        int agree = 0;
+        for (int wd = 0; wd < FC_WORDS; ++wd)
+            for (int b = 0; b < FC_WORD; ++b)
+                agree += fc_in[wd * FC_WORD + b] == ((fc.words[oc * FC_WORDS + wd] >> b) & 1);
+
+        int32_t dot = 2 * agree - FC_IC;
+        int32_t v = ((static_cast<int32_t>(fc.scale[oc]) * dot) >> 8) + fc.bias[oc];
+        if (v > INT16_MAX)
+            v = INT16_MAX;
+        if (v < INT16_MIN)
+            v = INT16_MIN;
+        out[oc] = static_cast<int16_t>(v);
+    }
+    return out;
+}
+
+int argmax(const std::vector<int16_t> &scores)
+{
+    int best = 0;
+    for (size_t i = 1; i < scores.size(); ++i)
+        if (scores[best] < scores[i])
+            best = static_cast<int>(i);
+    return best;
+}
+
+int classify(const Weights &w, const std::string &flat)
+{
+    if (flat.find('1') == std::string::npos)
+        return BLANK_RESULT;
+    return argmax(fc_q88(w, features(w, flat)));
+}
+
+int classify_binary(const Weights &w, const BinaryFC &fc, const std::string &flat)
+{
+    if (flat.find('1') == std::string::npos)
+        return BLANK_RESULT;
+    return argmax(fc_binary(fc, features(w, flat)));
+}
+
+} // namespace bnn
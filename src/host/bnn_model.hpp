@@ -0,0 +1,111 @@
+#pragma once
+
+// Bit-exact C++ model of bnn_top, used by the host tools and the harness.
+// Weights are read straight from the RTL sources so the model can never
+// drift from what the FPGA runs.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bnn
+{
+
+constexpr int IMG_SIZE = 30;
+constexpr int CONV1_OC = 16;
+constexpr int CONV2_OC = 16;
+constexpr int POOL1_SIZE = (IMG_SIZE - 2) / 2;   // 14
+constexpr int POOL2_SIZE = (POOL1_SIZE - 2) / 2; // 6
+constexpr int FC_IC = POOL2_SIZE * POOL2_SIZE * CONV2_OC;
+constexpr int FC_OC = 10;
+constexpr int BLANK_RESULT = 10; // bnn_interface reports 10 for an empty image
+
+// Binarized FC layout (FCBinary.sv)
+constexpr int FC_WORD = 32;
+constexpr int FC_WORDS = FC_IC / FC_WORD;
+
+// FC early exit (FC.sv with EARLY_EXIT): a bound every FC_BOUND_STRIDE inputs
+constexpr int FC_BOUND_STRIDE = 32;
+constexpr int FC_BOUND_CHECKS = FC_IC / FC_BOUND_STRIDE;
+
+struct Weights
+{
+    std::vector<std::vector<uint8_t>> conv1; // [oc][ic*9 + tap]
+    std::vector<std::vector<uint8_t>> conv2; // [oc][ic*9 + tap]
+    std::vector<int16_t> fc;                 // [oc*FC_IC + ic], Q8.8
+};
+
+struct BinaryFC
+{
+    std::vector<uint32_t> words; // [oc*FC_WORDS + w], bit b = weight w*FC_WORD+b is >= 0
+    std::vector<int16_t> scale;  // per class, Q8.8 multiplier of the +/-1 dot product
+    std::vector<int16_t> bias;   // per class, same units as the Q8.8 FC outputs
+};
+
+// Parse conv1_weights / conv2_weights / fc_weights out of bnn_top.sv
+Weights load_weights(const std::string &bnn_top_sv);
+
+// Emit conv1_weights / conv2_weights / fc_weights declarations for any
+// network shape, for bnn_top.sv to include under BNN_WEIGHTS_FILE
+void write_weights(const std::string &svh, const Weights &w);
+
+// Parse / emit fc_binary_weights.svh
+BinaryFC load_binary_fc(const std::string &svh);
+void write_binary_fc(const std::string &svh, const BinaryFC &fc);
+
+// ConvPoolCore / Conv2d_MaxPool2d for any shape: img[ic][in_size^2],
+// weights[oc][ic*9 + tap]; returns [oc][pooled pixels]
+std::vector<std::vector<uint8_t>> conv_pool(const std::vector<std::vector<uint8_t>> &img, int in_size,
+                                            const std::vector<std::vector<uint8_t>> &weights);
+
+// conv1 + pool; returns the 16x14x14 pool1 bits, channel-major like
+// bnn_top's pool1 maps
+std::vector<uint8_t> pool1(const Weights &w, const std::string &flat);
+
+// Rows of '0'/'1' characters (digits.h) joined into one row-major string
+std::string flatten(const std::vector<std::string> &rows);
+
+// conv1 + pool + conv2 + pool; returns the 576 FC input bits.
+// `flat` is a 900-character '0'/'1' string, row-major.
+std::vector<uint8_t> features(const Weights &w, const std::string &flat);
+
+// FC.sv: 16-bit wrap-around sums of +/-weight
+std::vector<int16_t> fc_q88(const Weights &w, const std::vector<uint8_t> &fc_in);
+
+// Suffix bounds for FC's early exit: [oc*FC_BOUND_CHECKS + k] is the sum of
+// |weight| of class oc over inputs k*FC_BOUND_STRIDE onwards
+std::vector<int32_t> fc_bounds(const Weights &w);
+void write_fc_bounds(const std::string &svh, const std::vector<int32_t> &bounds);
+
+// FC.sv with EARLY_EXIT: a class that can no longer beat the best finished
+// one stops at a bound checkpoint and reports the bound instead of its sum,
+// so argmax() matches fc_q88(). `cycles` is FC's cycle count for the run.
+std::vector<int16_t> fc_q88_early_exit(const Weights &w, const std::vector<int32_t> &bounds,
+                                       const std::vector<uint8_t> &fc_in, int *cycles = nullptr);
+
+// FCBinary.sv: xnor-popcount, then scale and bias, saturated to 16 bits
+std::vector<int16_t> fc_binary(const BinaryFC &fc, const std::vector<uint8_t> &fc_in);
+
+// Comparator.sv: index of the first strict maximum
+int argmax(const std::vector<int16_t> &scores);
+
+// Digit shown by the FPGA for `flat`, with either FC variant
+int classify(const Weights &w, const std::string &flat);
+int classify_binary(const Weights &w, const BinaryFC &fc, const std::string &flat);
+
+// Runtime weight upload (weight_loader.sv): the image streamed after
+// CMD_LOAD_WEIGHTS, followed on the wire by its crc32, LSB first
+constexpr int CONV1_WEIGHT_BYTES = 2;                // per output channel
+constexpr int CONV2_WEIGHT_BYTES = CONV1_OC * 9 / 8; // per output channel
+constexpr int WEIGHT_BYTES = CONV1_OC * CONV1_WEIGHT_BYTES + CONV2_OC * CONV2_WEIGHT_BYTES + FC_IC * FC_OC * 2;
+std::vector<uint8_t> weight_image(const Weights &w);
+
+// Reflected CRC-32 (0xEDB88320), as image_buffer and weight_loader compute it
+uint32_t crc32(const std::vector<uint8_t> &bytes);
+
+// Cycle counts of the FC stage in BNN clock cycles (clk/4), from the clock
+// that takes the job to the one that publishes the sums
+constexpr int fc_q88_cycles() { return FC_OC * (FC_IC + 1) + 2; }
+constexpr int fc_binary_cycles() { return FC_OC * (FC_WORDS + 1) + 2; }
+
+} // namespace bnn
@@ -0,0 +1,438 @@
+// Design-space sweep over bnn_top's shape parameters. For every point of
+// the grid it synthesizes weights, verilates bnn_top with them
+// (tests/bench_bnn_top.cpp), runs a held-out digit set through it and
+// tabulates cycles per inference, size proxies and accuracy.
+//
+// usage: bnn_sweep [--conv1 4,8,16] [--conv2 8,16] [--img 30,22] [--images N]
+//                  [--src DIR] [--out DIR] [--verilator PATH] [--model-only]
+//
+// Weights: conv1 / conv2 reuse the trained bnn_top kernels where the shape
+// allows and are padded with random ones beyond that; the FC layer is
+// retrained for the variant's feature count with an integer perceptron on
+// noisy copies of the digit set. Images smaller than 30x30 are box-sampled
+// from the 30x30 digits.
+//
+// The proxies are analytic: weight bits is the size of the three weight
+// arrays, ops is the binary MACs of one inference, and mux bits is the
+// width of everything the layers index into per cycle, which is where
+// bnn_top's LUTs go. Accuracy comes from the C++ model; the RTL results must
+// match it. --model-only skips Verilator and leaves cycles empty.
+//
+// Writes <out>/sweep.csv and prints the same table as markdown.
+
+#include "bnn_model.hpp"
+#include "digits.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct Point
+{
+    int img;
+    int conv1_oc;
+    int conv2_oc;
+
+    int pool1() const { return (img - 2) / 2; }
+    int pool2() const { return (pool1() - 2) / 2; }
+    int fc_ic() const { return pool2() * pool2() * conv2_oc; }
+    std::string tag() const
+    {
+        return "img" + std::to_string(img) + "_c" + std::to_string(conv1_oc) + "_c" + std::to_string(conv2_oc);
+    }
+};
+
+struct Sample
+{
+    std::string flat; // img x img
+    int label;
+};
+
+struct Result
+{
+    Point p;
+    double accuracy = 0;
+    double cycles = -1; // per inference, -1 if not simulated
+    int rtl_mismatches = 0;
+    long weight_bits = 0;
+    long ops = 0;
+    long mux_bits = 0;
+    std::string error;
+};
+
+std::vector<int> parse_list(const std::string &s)
+{
+    std::vector<int> out;
+    std::stringstream ss(s);
+    for (std::string item; std::getline(ss, item, ',');)
+        out.push_back(std::stoi(item));
+    return out;
+}
+
+// Noisy, shifted copies of the digit set, box-sampled down to size x size:
+// an output pixel is set when a quarter of its source box is ink
+std::vector<Sample> digit_set(int size, int count, uint32_t seed)
+{
+    const std::vector<std::pair<const std::vector<std::string> *, int>> digits = {
+        {&digit_0, 0}, {&digit_1, 1}, {&digit_2, 2}, {&digit_3, 3}, {&digit_4, 4},
+        {&digit_5, 5}, {&digit_6, 6}, {&digit_8, 8}, {&digit_9, 9}};
+    const int src = bnn::IMG_SIZE;
+
+    std::mt19937 rng{seed};
+    std::uniform_int_distribution<int> shift{-2, 2};
+    std::uniform_int_distribution<int> px{0, src * src - 1};
+
+    std::vector<Sample> out;
+    for (int i = 0; i < count; ++i)
+    {
+        const auto &d = digits[i % digits.size()];
+        std::string clean = bnn::flatten(*d.first);
+        std::string big(src * src, '0');
+        int dy = shift(rng), dx = shift(rng);
+        for (int y = 0; y < src; ++y)
+            for (int x = 0; x < src; ++x)
+            {
+                int sy = y - dy, sx = x - dx;
+                if (sy >= 0 && sy < src && sx >= 0 && sx < src)
+                    big[y * src + x] = clean[sy * src + sx];
+            }
+        for (int f = 0; f < 12; ++f)
+        {
+            char &c = big[px(rng)];
+            c = c == '1' ? '0' : '1';
+        }
+
+        std::string flat(size * size, '0');
+        for (int r = 0; r < size; ++r)
+            for (int c = 0; c < size; ++c)
+            {
+                int y0 = r * src / size, y1 = std::max(y0 + 1, (r + 1) * src / size);
+                int x0 = c * src / size, x1 = std::max(x0 + 1, (c + 1) * src / size);
+                int ink = 0;
+                for (int y = y0; y < y1; ++y)
+                    for (int x = x0; x < x1; ++x)
+                        ink += big[y * src + x] == '1';
+                if (4 * ink >= (y1 - y0) * (x1 - x0))
+                    flat[r * size + c] = '1';
+            }
+        if (flat.find('1') == std::string::npos)
+            flat[(size / 2) * size + size / 2] = '1'; // bnn_top has no blank-image shortcut
+        out.push_back({flat, d.second});
+    }
+    return out;
+}
+
+// Conv kernels for the point: trained ones where they exist, random beyond
+void conv_weights(const bnn::Weights &trained, const Point &p, std::mt19937 &rng, bnn::Weights &w)
+{
+    std::bernoulli_distribution bit{0.5};
+    w.conv1.assign(p.conv1_oc, std::vector<uint8_t>(9));
+    for (int oc = 0; oc < p.conv1_oc; ++oc)
+        for (int tap = 0; tap < 9; ++tap)
+            w.conv1[oc][tap] = oc < bnn::CONV1_OC ? trained.conv1[oc][tap] : bit(rng);
+
+    w.conv2.assign(p.conv2_oc, std::vector<uint8_t>(p.conv1_oc * 9));
+    for (int oc = 0; oc < p.conv2_oc; ++oc)
+        for (int i = 0; i < p.conv1_oc * 9; ++i)
+            w.conv2[oc][i] = oc < bnn::CONV2_OC && i < bnn::CONV1_OC * 9 ? trained.conv2[oc][i] : bit(rng);
+}
+
+std::vector<uint8_t> features(const bnn::Weights &w, const Point &p, const std::string &flat)
+{
+    std::vector<std::vector<uint8_t>> img(1, std::vector<uint8_t>(flat.size()));
+    for (size_t i = 0; i < flat.size(); ++i)
+        img[0][i] = flat[i] == '1';
+    auto pool1 = bnn::conv_pool(img, p.img, w.conv1);
+    auto pool2 = bnn::conv_pool(pool1, p.pool1(), w.conv2);
+
+    std::vector<uint8_t> fc_in;
+    for (const auto &ch : pool2)
+        fc_in.insert(fc_in.end(), ch.begin(), ch.end());
+    return fc_in;
+}
+
+// FC.sv for any input count: 16-bit wrap-around sums of +/-weight, then the
+// Comparator's first strict maximum
+int classify(const bnn::Weights &w, const std::vector<uint8_t> &fc_in)
+{
+    int ic_count = static_cast<int>(fc_in.size());
+    std::vector<int16_t> scores(bnn::FC_OC);
+    for (int oc = 0; oc < bnn::FC_OC; ++oc)
+    {
+        uint16_t acc = 0;
+        for (int ic = 0; ic < ic_count; ++ic)
+        {
+            int16_t wt = w.fc[oc * ic_count + ic];
+            acc = static_cast<uint16_t>(acc + (fc_in[ic] ? wt : -wt));
+        }
+        scores[oc] = static_cast<int16_t>(acc);
+    }
+    return bnn::argmax(scores);
+}
+
+// Multiclass perceptron on +/-1 features. Weights stay within
+// 32767 / FC_IC so no 16-bit sum can wrap.
+void train_fc(const std::vector<std::vector<uint8_t>> &x, const std::vector<Sample> &train, int fc_ic,
+              bnn::Weights &w)
+{
+    const int limit = std::max(1, 32767 / fc_ic);
+    w.fc.assign(static_cast<size_t>(fc_ic) * bnn::FC_OC, 0);
+
+    for (int epoch = 0; epoch < 30; ++epoch)
+    {
+        int errors = 0;
+        for (size_t s = 0; s < x.size(); ++s)
+        {
+            int pred = classify(w, x[s]);
+            int label = train[s].label;
+            if (pred == label)
+                continue;
+            ++errors;
+            for (int ic = 0; ic < fc_ic; ++ic)
+            {
+                int sign = x[s][ic] ? 1 : -1;
+                int16_t &up = w.fc[label * fc_ic + ic];
+                int16_t &down = w.fc[pred * fc_ic + ic];
+                up = static_cast<int16_t>(std::clamp(up + sign, -limit, limit));
+                down = static_cast<int16_t>(std::clamp(down - sign, -limit, limit));
+            }
+        }
+        if (errors == 0)
+            break;
+    }
+}
+
+void analytic_proxies(Result &r)
+{
+    const Point &p = r.p;
+    long conv1_out = p.img - 2, conv2_out = p.pool1() - 2;
+    r.weight_bits = 9L * p.conv1_oc + 9L * p.conv1_oc * p.conv2_oc + 16L * p.fc_ic() * bnn::FC_OC;
+    r.ops = conv1_out * conv1_out * p.conv1_oc * 9 + conv2_out * conv2_out * p.conv2_oc * p.conv1_oc * 9 +
+            static_cast<long>(p.fc_ic()) * bnn::FC_OC;
+    // Conv window selects from the input image of each layer, FC from its
+    // weights and inputs
+    r.mux_bits = static_cast<long>(p.img) * p.img + static_cast<long>(p.pool1()) * p.pool1() * p.conv1_oc +
+                 16L * p.fc_ic() * bnn::FC_OC + p.fc_ic();
+}
+
+// Verilates bnn_top for the point and runs the test set through it
+bool simulate(const Point &p, const std::vector<Sample> &test, const std::string &src, const std::string &dir,
+              const std::string &verilator, std::vector<int> &results, double &cycles, std::string &error)
+{
+    std::string images = dir + "/images.txt";
+    {
+        std::ofstream out(images);
+        for (const auto &s : test)
+            out << s.flat << "\n";
+    }
+
+    std::string exe = dir + "/bench_bnn_top";
+    std::string cflags = "-I" + src + "/tests -I" + src + "/src/host -I" + src + "/include -DBENCH_IMG=" +
+                         std::to_string(p.img);
+    // Other shapes can trip width lint warnings the default one does not
+    std::string cmd = verilator + " -cc --exe --build -j 0 -Wno-fatal --top-module bnn_top" +
+                      " -GCONV1_IMG_IN_SIZE=" + std::to_string(p.img) +
+                      " -GCONV1_OC=" + std::to_string(p.conv1_oc) +
+                      " -GCONV2_OC=" + std::to_string(p.conv2_oc) + " -I" + src + "/src/fpga/bnn_module" +
+                      " '+define+BNN_WEIGHTS_FILE=\"" + dir + "/weights.svh\"'" + " --Mdir " + dir + "/obj" +
+                      " -CFLAGS '" + cflags + "' -o " + exe + " " + src + "/tests/bench_bnn_top.cpp " + src +
+                      "/src/fpga/bnn_module/bnn_top.sv > " + dir + "/verilator.log 2>&1";
+    if (std::system(cmd.c_str()) != 0)
+    {
+        error = "verilator failed, see " + dir + "/verilator.log";
+        return false;
+    }
+
+    std::string out = dir + "/results.txt";
+    if (std::system((exe + " " + images + " > " + out).c_str()) != 0)
+    {
+        error = exe + " failed";
+        return false;
+    }
+
+    std::ifstream in(out);
+    uint64_t total = 0;
+    uint64_t c;
+    int result;
+    results.clear();
+    while (in >> c >> result)
+    {
+        if (c == 0)
+        {
+            error = "bnn_top did not finish an image";
+            return false;
+        }
+        total += c;
+        results.push_back(result);
+    }
+    if (results.size() != test.size())
+    {
+        error = "expected " + std::to_string(test.size()) + " results, got " + std::to_string(results.size());
+        return false;
+    }
+    cycles = static_cast<double>(total) / results.size();
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::vector<int> conv1_list = {4, 8, 16}, conv2_list = {8, 16}, img_list = {30, 22};
+    int image_count = 450;
+    std::string src = ".", out_dir = "sweep", verilator = "verilator";
+    bool model_only = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--conv1" && has_value)
+            conv1_list = parse_list(argv[++i]);
+        else if (arg == "--conv2" && has_value)
+            conv2_list = parse_list(argv[++i]);
+        else if (arg == "--img" && has_value)
+            img_list = parse_list(argv[++i]);
+        else if (arg == "--images" && has_value)
+            image_count = std::stoi(argv[++i]);
+        else if (arg == "--src" && has_value)
+            src = argv[++i];
+        else if (arg == "--out" && has_value)
+            out_dir = argv[++i];
+        else if (arg == "--verilator" && has_value)
+            verilator = argv[++i];
+        else if (arg == "--model-only")
+            model_only = true;
+        else
+        {
+            std::cerr << "usage: " << argv[0]
+                      << " [--conv1 4,8,16] [--conv2 8,16] [--img 30,22] [--images N]\n"
+                         "       [--src DIR] [--out DIR] [--verilator PATH] [--model-only]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (int img : img_list)
+        if (img < 10 || img > bnn::IMG_SIZE || (img - 2) % 4 != 0)
+        {
+            std::cerr << "image size " << img << ": both pooling stages need an even input, use 30, 26, 22, ...\n";
+            return EXIT_FAILURE;
+        }
+    for (int oc : conv1_list)
+        if (oc < 1 || oc > 64)
+        {
+            std::cerr << "conv1 channel count " << oc << " out of range\n";
+            return EXIT_FAILURE;
+        }
+    for (int oc : conv2_list)
+        if (oc < 1 || oc > 64)
+        {
+            std::cerr << "conv2 channel count " << oc << " out of range\n";
+            return EXIT_FAILURE;
+        }
+
+    bnn::Weights trained = bnn::load_weights(src + "/src/fpga/bnn_module/bnn_top.sv");
+    if (std::system(("mkdir -p '" + out_dir + "'").c_str()) != 0)
+    {
+        std::cerr << "cannot create " << out_dir << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Result> results;
+    for (int img : img_list)
+    {
+        std::vector<Sample> train = digit_set(img, 900, 11);
+        std::vector<Sample> test = digit_set(img, image_count, 23);
+
+        for (int c1 : conv1_list)
+            for (int c2 : conv2_list)
+            {
+                Result r;
+                r.p = {img, c1, c2};
+                analytic_proxies(r);
+                std::cerr << "[SWEEP] " << r.p.tag() << "\n";
+
+                std::mt19937 rng{static_cast<uint32_t>(img * 10007 + c1 * 101 + c2)};
+                bnn::Weights w;
+                conv_weights(trained, r.p, rng, w);
+
+                std::vector<std::vector<uint8_t>> x;
+                for (const auto &s : train)
+                    x.push_back(features(w, r.p, s.flat));
+                train_fc(x, train, r.p.fc_ic(), w);
+
+                std::vector<int> expected;
+                int correct = 0;
+                for (const auto &s : test)
+                {
+                    expected.push_back(classify(w, features(w, r.p, s.flat)));
+                    correct += expected.back() == s.label;
+                }
+                r.accuracy = 100.0 * correct / test.size();
+
+                if (!model_only)
+                {
+                    std::string dir = out_dir + "/" + r.p.tag();
+                    std::vector<int> rtl;
+                    if (std::system(("mkdir -p '" + dir + "'").c_str()) != 0)
+                        r.error = "cannot create " + dir;
+                    else
+                    {
+                        bnn::write_weights(dir + "/weights.svh", w);
+                        if (simulate(r.p, test, src, dir, verilator, rtl, r.cycles, r.error))
+                            for (size_t i = 0; i < rtl.size(); ++i)
+                                r.rtl_mismatches += rtl[i] != expected[i];
+                    }
+                    if (!r.error.empty())
+                        std::cerr << "[SWEEP] " << r.p.tag() << ": " << r.error << "\n";
+                }
+                results.push_back(r);
+            }
+    }
+
+    std::ofstream csv(out_dir + "/sweep.csv");
+    csv << "img,conv1_oc,conv2_oc,fc_ic,cycles,accuracy,rtl_mismatches,weight_bits,ops,mux_bits\n";
+    std::cout << "| img | conv1 | conv2 | FC in | cycles/inf | accuracy % | RTL mismatches | weight bits | ops | mux bits |\n"
+              << "|----:|------:|------:|------:|-----------:|-----------:|---------------:|------------:|----:|---------:|\n";
+    int status = EXIT_SUCCESS;
+    for (const auto &r : results)
+    {
+        std::ostringstream cycles;
+        if (r.cycles >= 0)
+            cycles << std::fixed << std::setprecision(0) << r.cycles;
+        bool failed = !r.error.empty() || r.rtl_mismatches;
+        if (failed)
+            status = EXIT_FAILURE;
+
+        csv << r.p.img << "," << r.p.conv1_oc << "," << r.p.conv2_oc << "," << r.p.fc_ic() << "," << cycles.str()
+            << "," << std::fixed << std::setprecision(1) << r.accuracy << "," << r.rtl_mismatches << ","
+            << r.weight_bits << "," << r.ops << "," << r.mux_bits << "\n";
+        std::cout << "| " << r.p.img << " | " << r.p.conv1_oc << " | " << r.p.conv2_oc << " | " << r.p.fc_ic()
+                  << " | " << (r.error.empty() ? cycles.str() : "failed") << " | " << std::fixed
+                  << std::setprecision(1) << r.accuracy << " | "
+                  << (model_only || !r.error.empty() ? "" : std::to_string(r.rtl_mismatches)) << " | "
+                  << r.weight_bits << " | " << r.ops << " | " << r.mux_bits << " |\n";
+    }
+
+    // Smallest variant that gives up at most two points of accuracy
+    double best = 0;
+    for (const auto &r : results)
+        best = std::max(best, r.accuracy);
+    const Result *pick = nullptr;
+    for (const auto &r : results)
+        if (r.accuracy >= best - 2.0 && (!pick || r.weight_bits < pick->weight_bits))
+            pick = &r;
+    if (pick)
+        std::cout << "\nSmallest within 2 points of the best accuracy (" << std::setprecision(1) << best
+                  << "%): " << pick->p.tag() << "\n";
+    return status;
+}
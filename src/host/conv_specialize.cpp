@@ -0,0 +1,104 @@
+// Generates ConvKernels.sv: one combinational module per conv layer with the
+// weights of bnn_top.sv baked in. Every XNOR against a constant weight bit
+// becomes a plain wire (weight 1) or an inverter (weight 0), and each output
+// channel gets its own popcount feeding the same 8-bit wrapping sign test as
+// ConvPoolCore.
+//
+// usage: conv_specialize <bnn_top.sv> <ConvKernels.sv>
+
+#include "bnn_model.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+std::string hex_literal(const std::vector<uint8_t> &bits)
+{
+    std::string hex;
+    for (int nib = (static_cast<int>(bits.size()) + 3) / 4 - 1; nib >= 0; --nib)
+    {
+        int v = 0;
+        for (int b = 0; b < 4; ++b)
+            if (nib * 4 + b < static_cast<int>(bits.size()) && bits[nib * 4 + b])
+                v |= 1 << b;
+        hex += "0123456789abcdef"[v];
+    }
+    return std::to_string(bits.size()) + "'h" + hex;
+}
+
+void emit_layer(std::ostream &out, const std::string &name, int ic,
+                const std::vector<std::vector<uint8_t>> &weights)
+{
+    int taps = ic * 9;
+    int oc = static_cast<int>(weights.size());
+
+    out << "module ConvKernel_" << name << " (\n"
+        << "    input  logic [" << taps - 1 << ":0] patch,  // tap ic*9+k, k = 3x3 row-major\n"
+        << "    output logic [" << oc - 1 << ":0] fires   // one bit per output channel\n"
+        << ");\n\n";
+
+    for (int o = 0; o < oc; ++o)
+    {
+        out << "  // oc " << o << ": " << hex_literal(weights[o]) << "\n"
+            << "  logic [" << taps - 1 << ":0] match_" << o << ";\n"
+            << "  logic [7:0] count_" << o << ", sum_" << o << ";\n"
+            << "  assign match_" << o << " = {\n";
+        for (int c = ic - 1; c >= 0; --c)
+        {
+            out << "    ";
+            for (int k = 8; k >= 0; --k)
+            {
+                int t = c * 9 + k;
+                out << (weights[o][t] ? " " : "~") << "patch[" << t << "]";
+                if (t != 0)
+                    out << ", ";
+            }
+            out << "\n";
+        }
+        out << "  };\n"
+            << "  assign count_" << o << " = 8'($countones(match_" << o << "));\n"
+            << "  assign sum_" << o << " = (count_" << o << " << 1) - 8'd" << taps
+            << ";  // +/-1 sum, wraps like ConvPoolCore's popcount\n"
+            << "  assign fires[" << o << "] = ~sum_" << o << "[7];\n\n";
+    }
+
+    out << "endmodule\n\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <bnn_top.sv> <ConvKernels.sv>\n";
+        return EXIT_FAILURE;
+    }
+
+    bnn::Weights w = bnn::load_weights(argv[1]);
+
+    std::ofstream out(argv[2]);
+    if (!out)
+    {
+        std::cerr << "cannot write " << argv[2] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    out << "`ifndef CONVKERNELS_SV\n"
+        << "`define CONVKERNELS_SV\n"
+        << "// Weight-specialized conv kernels for ConvPoolCoreFixed, generated by\n"
+        << "// src/host/conv_specialize.cpp from the conv weights in bnn_top.sv.\n"
+        << "// Do not edit by hand.\n"
+        << "`timescale 1ns / 1ps\n\n";
+    emit_layer(out, "conv1", 1, w.conv1);
+    emit_layer(out, "conv2", bnn::CONV1_OC, w.conv2);
+    out << "`endif\n";
+
+    std::cout << "[CONV] Wrote " << argv[2] << "\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,52 @@
+// Pretty-prints a debug log saved by the harness (debug_log_save in
+// tests/debug_log.cpp). Images are drawn as 30x30 grids.
+//
+// usage: debug_decode <debug_log.bin> [first_cycle [last_cycle]]
+//
+// The cycle range is in main clock cycles for every record, bnn_top's job
+// events included (their own clk/4 count is printed with them).
+
+#include "debug_log.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+
+int main(int argc, char **argv)
+{
+    if (argc < 2 || argc > 4)
+    {
+        std::cerr << "usage: " << argv[0] << " <debug_log.bin> [first_cycle [last_cycle]]\n";
+        return EXIT_FAILURE;
+    }
+
+    uint64_t first = argc > 2 ? std::stoull(argv[2]) : 0;
+    uint64_t last = argc > 3 ? std::stoull(argv[3]) : std::numeric_limits<uint64_t>::max();
+
+    std::vector<debug_log::Record> records = debug_log::read(argv[1]);
+    size_t shown = 0;
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        const auto &rec = records[i];
+        if (rec.cycle < first || rec.cycle > last)
+            continue;
+
+        if (rec.type == debug_log::IMAGE)
+        {
+            if (rec.aux != 0)
+                continue; // drawn with chunk 0
+            std::cout << "[" << rec.cycle << "] [IMAGE]\n";
+            for (const auto &row : debug_log::image_rows(records, i))
+                std::cout << "    " << row << "\n";
+        }
+        else
+        {
+            std::cout << debug_log::format(rec) << "\n";
+        }
+        ++shown;
+    }
+
+    std::cerr << "[DEBUG] " << shown << " of " << records.size() << " records shown\n";
+    return EXIT_SUCCESS;
+}
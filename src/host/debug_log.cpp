@@ -0,0 +1,100 @@
+#include "debug_log.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace debug_log
+{
+
+namespace
+{
+constexpr char MAGIC[4] = {'D', 'B', 'G', 'L'};
+
+std::string bit(const Record &rec, Flag f)
+{
+    return (rec.sig.flags & f) ? "1" : "0";
+}
+} // namespace
+
+std::vector<Record> read(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    char magic[4];
+    uint32_t count = 0;
+    in.read(magic, 4);
+    in.read(reinterpret_cast<char *>(&count), sizeof(count));
+    if (!in || std::memcmp(magic, MAGIC, 4) != 0)
+        throw std::runtime_error(path + " is not a debug log");
+
+    std::vector<Record> records(count);
+    in.read(reinterpret_cast<char *>(records.data()), count * sizeof(Record));
+    if (!in)
+        throw std::runtime_error(path + " is truncated");
+    return records;
+}
+
+void write(const std::string &path, const std::vector<Record> &records)
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+        throw std::runtime_error("cannot write " + path);
+    uint32_t count = static_cast<uint32_t>(records.size());
+    out.write(MAGIC, 4);
+    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    out.write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(Record));
+}
+
+std::string format(const Record &rec)
+{
+    std::stringstream ss;
+    ss << "[" << rec.cycle << "] ";
+    switch (rec.type)
+    {
+    case SIGNALS:
+        ss << std::hex << std::setfill('0') << "[FSM] rx " << std::setw(2) << int(rec.sig.spi_rx_data)
+           << " valid " << bit(rec, SPI_BYTE_VALID) << " en " << bit(rec, SPI_RX_ENABLE) << " taken "
+           << bit(rec, BYTE_TAKEN) << " status " << int(rec.aux >> 4) << " clear " << bit(rec, CLEAR_INTERNAL)
+           << " bnn_en " << bit(rec, BNN_ENABLE) << " | [SPI] sclk " << bit(rec, SCLK) << " copi "
+           << bit(rec, COPI) << " cs_n " << bit(rec, SPI_CS_N) << " | [BUF] full " << bit(rec, BUFFER_FULL)
+           << " empty " << bit(rec, BUFFER_EMPTY) << " data " << std::setw(2) << int(rec.sig.data_in)
+           << " addr " << std::setw(2) << int(rec.sig.buffer_write_addr) << " | [BNN] ready "
+           << bit(rec, RESULT_READY) << " result " << int(rec.aux & 0xF) << " clear " << bit(rec, BNN_CLEAR)
+           << std::dec << " | sclk cycles " << rec.sig.sclk_cycle;
+        break;
+    case IMAGE:
+        ss << "[IMAGE] chunk " << int(rec.aux) << ":" << std::hex << std::setfill('0');
+        for (uint8_t b : rec.image)
+            ss << " " << std::setw(2) << int(b);
+        break;
+    case BNN_START:
+        ss << "[BNN_TOP] job started, image " << (rec.aux ? "has pixels" : "is empty") << " | bnn cycle "
+           << rec.bnn.cycle;
+        break;
+    case BNN_DONE:
+        ss << "[BNN_TOP] job done, result " << int(rec.aux) << " | bnn cycle " << rec.bnn.cycle;
+        break;
+    default:
+        ss << "unknown record type " << int(rec.type);
+    }
+    return ss.str();
+}
+
+std::vector<std::string> image_rows(const std::vector<Record> &records, size_t first)
+{
+    std::vector<uint8_t> bytes(IMAGE_CHUNKS * CHUNK_BYTES, 0);
+    for (size_t i = first; i < records.size() && records[i].type == IMAGE &&
+                           records[i].cycle == records[first].cycle;
+         ++i)
+        if (records[i].aux < IMAGE_CHUNKS)
+            std::memcpy(&bytes[records[i].aux * CHUNK_BYTES], records[i].image, CHUNK_BYTES);
+
+    std::vector<std::string> rows(30);
+    for (int px = 0; px < IMAGE_BITS; ++px)
+        rows[px / 30] += ((bytes[px / 8] >> (px % 8)) & 1) ? '1' : '0';
+    return rows;
+}
+
+} // namespace debug_log
@@ -0,0 +1,91 @@
+#pragma once
+
+// Binary event log written by debug_module / bnn_top through DPI
+// (tests/debug_log.cpp) and read back by the debug_decode tool.
+//
+// Every record is 16 bytes. Signal snapshots are logged once per main clock
+// cycle while debug_enable is high; the 900-bit image is logged as
+// IMAGE_CHUNKS records, only when it differs from the last one logged.
+// bnn_top's job events are logged under the same debug_enable.
+//
+// `cycle` is always debug_module's main clock count, so one cycle range
+// selects every record type. BNN_* records also keep bnn_top's own clock
+// count (clk/4 unless LOW_LATENCY) in bnn.cycle.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace debug_log
+{
+
+enum RecordType : uint8_t
+{
+    SIGNALS = 0,   // debug_module snapshot
+    IMAGE = 1,     // one chunk of img_in, aux = chunk index
+    BNN_START = 2, // conv1 was given a job, aux = 1 if the image has any pixel set
+    BNN_DONE = 3,  // a new result is on bnn_top's output, aux = result
+};
+
+// SIGNALS flag bits
+enum Flag : uint16_t
+{
+    SPI_BYTE_VALID = 1 << 0,
+    SPI_RX_ENABLE = 1 << 1,
+    BYTE_TAKEN = 1 << 2,
+    CLEAR_INTERNAL = 1 << 3,
+    BNN_ENABLE = 1 << 4,
+    BUFFER_FULL = 1 << 5,
+    BUFFER_EMPTY = 1 << 6,
+    RESULT_READY = 1 << 7,
+    SCLK = 1 << 8,
+    COPI = 1 << 9,
+    SPI_CS_N = 1 << 10,
+    SRC_PULSE = 1 << 11,
+    DST_PULSE = 1 << 12,
+    BNN_CLEAR = 1 << 13,
+};
+
+constexpr int IMAGE_BITS = 900;
+constexpr int CHUNK_BYTES = 10;
+constexpr int IMAGE_CHUNKS = (IMAGE_BITS / 8 + 1 + CHUNK_BYTES - 1) / CHUNK_BYTES; // 12
+
+#pragma pack(push, 1)
+struct Record
+{
+    uint32_t cycle; // debug_module main_cycle_cnt
+    uint8_t type;   // RecordType
+    uint8_t aux;    // SIGNALS: status << 4 | result_out; IMAGE: chunk
+    union
+    {
+        struct
+        {
+            uint8_t spi_rx_data;
+            uint8_t data_in;
+            uint8_t buffer_write_addr;
+            uint8_t reserved;
+            uint16_t flags;
+            uint32_t sclk_cycle;
+        } sig;
+        uint8_t image[CHUNK_BYTES]; // img_in bits chunk*80 .. chunk*80+79, LSB first
+        struct
+        {
+            uint32_t cycle; // bnn_top clock count
+        } bnn;
+    };
+};
+#pragma pack(pop)
+static_assert(sizeof(Record) == 16, "debug log records are 16 bytes");
+
+// File: "DBGL" magic, u32 record count, then the records oldest first
+std::vector<Record> read(const std::string &path);
+void write(const std::string &path, const std::vector<Record> &records);
+
+// One line per record; IMAGE chunks are shown as hex
+std::string format(const Record &rec);
+
+// Rebuild the 30x30 image from the IMAGE chunks that share a cycle,
+// starting at records[first]; returns 30 rows of '0'/'1'
+std::vector<std::string> image_rows(const std::vector<Record> &records, size_t first);
+
+} // namespace debug_log
@@ -0,0 +1,140 @@
+// Converts the Q8.8 fc_weights in bnn_top.sv into the packed 1-bit layout
+// used by FCBinary.sv, then compares the two FC variants on the digit set.
+//
+// Each weight becomes its sign bit; each class gets a scale (mean |w|, so
+// scale * (+/-1 dot product) approximates the Q8.8 sum) and a bias that
+// removes the average error of that approximation on the clean digits.
+//
+// usage: fc_binarize <bnn_top.sv> <fc_binary_weights.svh>
+
+#include "bnn_model.hpp"
+#include "digits.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct Sample
+{
+    std::string flat;
+    int label;
+};
+
+int16_t clamp16(double v)
+{
+    return static_cast<int16_t>(std::lround(std::fmin(std::fmax(v, INT16_MIN), INT16_MAX)));
+}
+
+bnn::BinaryFC binarize(const bnn::Weights &w, const std::vector<Sample> &calibration)
+{
+    bnn::BinaryFC fc;
+    fc.words.assign(bnn::FC_OC * bnn::FC_WORDS, 0);
+
+    for (int oc = 0; oc < bnn::FC_OC; ++oc)
+    {
+        double abs_sum = 0;
+        for (int ic = 0; ic < bnn::FC_IC; ++ic)
+        {
+            int16_t wt = w.fc[oc * bnn::FC_IC + ic];
+            abs_sum += std::abs(wt);
+            if (wt >= 0)
+                fc.words[oc * bnn::FC_WORDS + ic / bnn::FC_WORD] |= 1u << (ic % bnn::FC_WORD);
+        }
+        fc.scale.push_back(clamp16(256.0 * abs_sum / bnn::FC_IC));
+    }
+
+    // Bias: mean of (exact - binarized) over the calibration images
+    fc.bias.assign(bnn::FC_OC, 0);
+    std::vector<double> err(bnn::FC_OC, 0);
+    for (const auto &s : calibration)
+    {
+        auto fc_in = bnn::features(w, s.flat);
+        auto exact = bnn::fc_q88(w, fc_in);
+        auto approx = bnn::fc_binary(fc, fc_in);
+        for (int oc = 0; oc < bnn::FC_OC; ++oc)
+            err[oc] += exact[oc] - approx[oc];
+    }
+    for (int oc = 0; oc < bnn::FC_OC; ++oc)
+        fc.bias[oc] = clamp16(err[oc] / calibration.size());
+
+    return fc;
+}
+
+void report(const std::string &name, const bnn::Weights &w, const bnn::BinaryFC &fc,
+            const std::vector<Sample> &set)
+{
+    int q88_ok = 0, bin_ok = 0, agree = 0;
+    for (const auto &s : set)
+    {
+        int q88 = bnn::classify(w, s.flat);
+        int bin = bnn::classify_binary(w, fc, s.flat);
+        q88_ok += q88 == s.label;
+        bin_ok += bin == s.label;
+        agree += q88 == bin;
+    }
+
+    auto pct = [&](int n)
+    { return 100.0 * n / set.size(); };
+    std::cout << std::fixed << std::setprecision(1) << "[FC] " << name << " (" << set.size()
+              << " images): Q8.8 " << pct(q88_ok) << "%, binary " << pct(bin_ok)
+              << "%, same prediction " << pct(agree) << "%\n"
+              << std::defaultfloat;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <bnn_top.sv> <fc_binary_weights.svh>\n";
+        return EXIT_FAILURE;
+    }
+
+    bnn::Weights w = bnn::load_weights(argv[1]);
+
+    std::vector<Sample> clean = {
+        {bnn::flatten(digit_0), 0}, {bnn::flatten(digit_1), 1}, {bnn::flatten(digit_2), 2},
+        {bnn::flatten(digit_3), 3}, {bnn::flatten(digit_4), 4}, {bnn::flatten(digit_5), 5},
+        {bnn::flatten(digit_6), 6}, {bnn::flatten(digit_8), 8}, {bnn::flatten(digit_9), 9}};
+
+    // Held-out set: every digit with a few random pixels flipped
+    std::vector<Sample> noisy;
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<int> px_dist{0, bnn::IMG_SIZE * bnn::IMG_SIZE - 1};
+    for (const auto &s : clean)
+        for (int v = 0; v < 20; ++v)
+        {
+            Sample n = s;
+            for (int f = 0; f < 12; ++f)
+            {
+                char &px = n.flat[px_dist(rng)];
+                px = (px == '1') ? '0' : '1';
+            }
+            noisy.push_back(n);
+        }
+
+    bnn::BinaryFC fc = binarize(w, clean);
+    bnn::write_binary_fc(argv[2], fc);
+    std::cout << "[FC] Wrote " << argv[2] << "\n";
+
+    report("clean digits", w, fc, clean);
+    report("noisy digits", w, fc, noisy);
+
+    int q88_bits = bnn::FC_IC * bnn::FC_OC * 16;
+    int bin_bits = bnn::FC_IC * bnn::FC_OC + bnn::FC_OC * 2 * 16;
+    std::cout << "[FC] Weight memory: " << q88_bits << " bits Q8.8, " << bin_bits << " bits binary ("
+              << std::setprecision(3) << static_cast<double>(q88_bits) / bin_bits << "x smaller)\n";
+    std::cout << "[FC] FC cycles: " << bnn::fc_q88_cycles() << " Q8.8, " << bnn::fc_binary_cycles()
+              << " binary (" << static_cast<double>(bnn::fc_q88_cycles()) / bnn::fc_binary_cycles()
+              << "x fewer)\n";
+
+    return EXIT_SUCCESS;
+}
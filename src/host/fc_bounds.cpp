@@ -0,0 +1,82 @@
+// Computes the suffix bounds FC.sv's early exit checks against (the sum of
+// |weight| over the inputs a class has not reached yet) from the Q8.8
+// fc_weights in bnn_top.sv, then estimates on the digit set how many FC
+// cycles the early exit saves.
+//
+// usage: fc_bounds <bnn_top.sv> <fc_bounds.svh>
+
+#include "bnn_model.hpp"
+#include "digits.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Returns the number of images whose prediction changed (must be 0)
+int report(const std::string &name, const bnn::Weights &w, const std::vector<int32_t> &bounds,
+           const std::vector<std::string> &set)
+{
+    long total = 0;
+    int changed = 0;
+    for (const auto &flat : set)
+    {
+        auto fc_in = bnn::features(w, flat);
+        int cycles = 0;
+        auto early = bnn::fc_q88_early_exit(w, bounds, fc_in, &cycles);
+        total += cycles;
+        changed += bnn::argmax(early) != bnn::argmax(bnn::fc_q88(w, fc_in));
+    }
+
+    double avg = static_cast<double>(total) / set.size();
+    std::cout << std::fixed << std::setprecision(1) << "[FC] " << name << " (" << set.size()
+              << " images): " << avg << " FC cycles with early exit, " << bnn::fc_q88_cycles() << " without ("
+              << 100.0 * (1.0 - avg / bnn::fc_q88_cycles()) << "% saved), " << changed
+              << " predictions changed\n"
+              << std::defaultfloat;
+    return changed;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <bnn_top.sv> <fc_bounds.svh>\n";
+        return EXIT_FAILURE;
+    }
+
+    bnn::Weights w = bnn::load_weights(argv[1]);
+    std::vector<int32_t> bounds = bnn::fc_bounds(w);
+    bnn::write_fc_bounds(argv[2], bounds);
+    std::cout << "[FC] Wrote " << argv[2] << "\n";
+
+    std::vector<std::string> clean = {bnn::flatten(digit_0), bnn::flatten(digit_1), bnn::flatten(digit_2),
+                                      bnn::flatten(digit_3), bnn::flatten(digit_4), bnn::flatten(digit_5),
+                                      bnn::flatten(digit_6), bnn::flatten(digit_8), bnn::flatten(digit_9)};
+
+    // Same held-out set as fc_binarize: every digit with a few pixels flipped
+    std::vector<std::string> noisy;
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<int> px_dist{0, bnn::IMG_SIZE * bnn::IMG_SIZE - 1};
+    for (const auto &flat : clean)
+        for (int v = 0; v < 20; ++v)
+        {
+            std::string n = flat;
+            for (int f = 0; f < 12; ++f)
+            {
+                char &px = n[px_dist(rng)];
+                px = (px == '1') ? '0' : '1';
+            }
+            noisy.push_back(n);
+        }
+
+    int changed = report("clean digits", w, bounds, clean) + report("noisy digits", w, bounds, noisy);
+    return changed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,293 @@
+#include "image_prep.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace image_prep
+{
+
+namespace
+{
+
+// Next whitespace-separated number of a PGM header, skipping # comments
+bool pgm_number(const std::vector<uint8_t> &raw, size_t &pos, int &value)
+{
+    while (pos < raw.size())
+    {
+        if (raw[pos] == '#')
+            while (pos < raw.size() && raw[pos] != '\n')
+                ++pos;
+        else if (std::isspace(raw[pos]))
+            ++pos;
+        else
+            break;
+    }
+    if (pos >= raw.size() || !std::isdigit(raw[pos]))
+        return false;
+    value = 0;
+    while (pos < raw.size() && std::isdigit(raw[pos]) && value < 100000)
+        value = value * 10 + (raw[pos++] - '0');
+    return true;
+}
+
+} // namespace
+
+bool decode(const std::vector<uint8_t> &raw, int width, int height, GrayImage &out, std::string &error)
+{
+    size_t pos = 0;
+    if (width == 0 && height == 0)
+    {
+        int maxval = 0;
+        if (raw.size() < 2 || raw[0] != 'P' || raw[1] != '5')
+        {
+            error = "not a binary PGM";
+            return false;
+        }
+        pos = 2;
+        if (!pgm_number(raw, pos, width) || !pgm_number(raw, pos, height) || !pgm_number(raw, pos, maxval))
+        {
+            error = "bad PGM header";
+            return false;
+        }
+        if (maxval <= 0 || maxval > 255)
+        {
+            error = "PGM maxval must be 1..255";
+            return false;
+        }
+        ++pos; // single whitespace before the raster
+    }
+
+    if (width <= 0 || height <= 0 || raw.size() < pos + static_cast<size_t>(width) * height)
+    {
+        error = "image data too short for " + std::to_string(width) + "x" + std::to_string(height);
+        return false;
+    }
+
+    out.width = width;
+    out.height = height;
+    out.pixels.assign(raw.begin() + pos, raw.begin() + pos + static_cast<size_t>(width) * height);
+    return true;
+}
+
+int otsu_threshold(const GrayImage &img)
+{
+    uint32_t hist[256] = {};
+    for (uint8_t p : img.pixels)
+        ++hist[p];
+
+    double total = static_cast<double>(img.pixels.size());
+    double sum_all = 0;
+    for (int i = 0; i < 256; ++i)
+        sum_all += static_cast<double>(i) * hist[i];
+
+    // Maximise the between-class variance; pixels <= t form the lower class
+    double w_lo = 0, sum_lo = 0, best = -1;
+    int best_t = 127;
+    for (int t = 0; t < 255; ++t)
+    {
+        w_lo += hist[t];
+        sum_lo += static_cast<double>(t) * hist[t];
+        double w_hi = total - w_lo;
+        if (w_lo == 0 || w_hi == 0)
+            continue;
+        double diff = sum_lo / w_lo - (sum_all - sum_lo) / w_hi;
+        double var = w_lo * w_hi * diff * diff;
+        if (var > best)
+        {
+            best = var;
+            best_t = t;
+        }
+    }
+    return best_t;
+}
+
+void threshold(const GrayImage &img, const Options &opt, std::vector<uint8_t> &mask)
+{
+    int t = opt.threshold >= 0 ? opt.threshold : otsu_threshold(img);
+    mask.resize(img.pixels.size());
+    for (size_t i = 0; i < img.pixels.size(); ++i)
+        mask[i] = opt.dark_ink ? img.pixels[i] <= t : img.pixels[i] > t;
+}
+
+void center_resize(const std::vector<uint8_t> &mask, int width, int height, const Options &opt,
+                   std::string &flat)
+{
+    flat.assign(IMG_SIZE * IMG_SIZE, '0');
+
+    int x0 = width, y0 = height, x1 = -1, y1 = -1;
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            if (mask[y * width + x])
+            {
+                x0 = std::min(x0, x);
+                x1 = std::max(x1, x);
+                y0 = std::min(y0, y);
+                y1 = std::max(y1, y);
+            }
+    if (x1 < 0)
+        return;
+
+    int bw = x1 - x0 + 1, bh = y1 - y0 + 1;
+    double scale = static_cast<double>(opt.height) / bh;
+    int ow = std::clamp(static_cast<int>(std::lround(bw * scale)), 1, std::min(opt.max_width, IMG_SIZE));
+    int oh = std::clamp(opt.height, 1, IMG_SIZE);
+    int ox = std::clamp(static_cast<int>(std::lround(opt.center_x - (ow - 1) / 2.0)), 0, IMG_SIZE - ow);
+    int oy = std::clamp(opt.top, 0, IMG_SIZE - oh);
+
+    // Summed-area table of the bounding box, kept per worker thread
+    thread_local std::vector<uint32_t> sat;
+    sat.assign(static_cast<size_t>(bw + 1) * (bh + 1), 0);
+    for (int y = 0; y < bh; ++y)
+        for (int x = 0; x < bw; ++x)
+            sat[(y + 1) * (bw + 1) + x + 1] = mask[(y0 + y) * width + x0 + x] + sat[y * (bw + 1) + x + 1] +
+                                              sat[(y + 1) * (bw + 1) + x] - sat[y * (bw + 1) + x];
+
+    // Each output pixel covers a box of the source; at least one pixel when
+    // enlarging
+    for (int r = 0; r < oh; ++r)
+    {
+        int sy0 = r * bh / oh;
+        int sy1 = std::max(sy0 + 1, (r + 1) * bh / oh);
+        for (int c = 0; c < ow; ++c)
+        {
+            int sx0 = c * bw / ow;
+            int sx1 = std::max(sx0 + 1, (c + 1) * bw / ow);
+            uint32_t ink = sat[sy1 * (bw + 1) + sx1] - sat[sy0 * (bw + 1) + sx1] - sat[sy1 * (bw + 1) + sx0] +
+                           sat[sy0 * (bw + 1) + sx0];
+            if (ink >= opt.coverage * (sy1 - sy0) * (sx1 - sx0))
+                flat[(oy + r) * IMG_SIZE + ox + c] = '1';
+        }
+    }
+}
+
+void pack(const std::string &flat, Payload &payload)
+{
+    payload.fill(0);
+    for (size_t i = 0; i < flat.size() && i < IMG_SIZE * IMG_SIZE; ++i)
+        if (flat[i] == '1')
+            payload[i / 8] |= 1 << (i % 8);
+}
+
+bool prepare(const std::vector<uint8_t> &raw, int width, int height, const Options &opt, Payload &payload,
+             std::string &error)
+{
+    GrayImage gray;
+    std::vector<uint8_t> mask;
+    std::string flat;
+    if (!decode(raw, width, height, gray, error))
+        return false;
+    threshold(gray, opt, mask);
+    center_resize(mask, gray.width, gray.height, opt, flat);
+    pack(flat, payload);
+    return true;
+}
+
+Pipeline::Pipeline(const Options &opt, unsigned threads, size_t depth) : opt_(opt), frames_(std::max<size_t>(depth, 1))
+{
+    for (auto &f : frames_)
+        free_.push_back(&f);
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threads; ++i)
+        threads_.emplace_back(&Pipeline::worker, this);
+}
+
+Pipeline::~Pipeline()
+{
+    close();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        work_.clear();
+    }
+    work_cv_.notify_all();
+    for (auto &t : threads_)
+        t.join();
+}
+
+Frame *Pipeline::acquire()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    free_cv_.wait(lock, [this] { return !free_.empty(); });
+    Frame *f = free_.back();
+    free_.pop_back();
+    return f;
+}
+
+void Pipeline::submit(Frame *f)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        f->seq = next_seq_++;
+        work_.push_back(f);
+    }
+    work_cv_.notify_one();
+}
+
+Frame *Pipeline::next()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return done_.count(next_out_) || (closed_ && next_out_ == next_seq_); });
+    auto it = done_.find(next_out_);
+    if (it == done_.end())
+        return nullptr;
+    Frame *f = it->second;
+    done_.erase(it);
+    ++next_out_;
+    return f;
+}
+
+void Pipeline::release(Frame *f)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(f);
+    }
+    free_cv_.notify_one();
+}
+
+void Pipeline::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    work_cv_.notify_all();
+    done_cv_.notify_all();
+}
+
+void Pipeline::worker()
+{
+    for (;;)
+    {
+        Frame *f;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_cv_.wait(lock, [this] { return !work_.empty() || closed_; });
+            if (work_.empty())
+                return;
+            f = work_.front();
+            work_.pop_front();
+        }
+
+        f->error.clear();
+        f->ok = decode(f->raw, f->width, f->height, f->gray, f->error);
+        if (f->ok)
+        {
+            threshold(f->gray, opt_, f->mask);
+            center_resize(f->mask, f->gray.width, f->gray.height, opt_, f->flat);
+        }
+        else
+            f->flat.assign(IMG_SIZE * IMG_SIZE, '0');
+        pack(f->flat, f->payload);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_[f->seq] = f;
+        }
+        done_cv_.notify_all();
+    }
+}
+
+} // namespace image_prep
@@ -0,0 +1,127 @@
+#pragma once
+
+// Host-side image preparation: 8-bit grayscale crops of any size to the
+// 113-byte payload image_buffer expects after CMD_IMG_SEND_REQUEST.
+//
+// Each image goes through four stages: decode (raw buffer or binary PGM),
+// threshold, crop to the ink's bounding box and resize it into the 30x30
+// frame where the reference digits sit, then pack LSB first. The stages are plain functions; Pipeline
+// runs them on a thread pool with a fixed set of reusable frames, so memory
+// is bounded and a slow consumer (the SPI link) throttles the producers.
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace image_prep
+{
+
+constexpr int IMG_SIZE = 30;
+constexpr int PAYLOAD_BYTES = (IMG_SIZE * IMG_SIZE + 7) / 8; // 113
+
+using Payload = std::array<uint8_t, PAYLOAD_BYTES>;
+
+struct GrayImage
+{
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels; // row-major
+};
+
+struct Options
+{
+    int threshold = -1;    // 0..255, or -1 for Otsu's threshold per image
+    bool dark_ink = true;  // ink darker than the background
+    // Placement in the 30x30 frame, after the digits the weights were
+    // checked against (tests/digits.h): 19-20 rows tall from row 3, up to 24
+    // columns wide around column 13
+    int height = 19;       // digit height in rows; the width keeps the aspect ratio
+    int top = 3;           // first row of the digit
+    int max_width = 26;    // wider digits are squeezed to this
+    double center_x = 13.25; // column of the digit's horizontal centre
+    double coverage = 0.4; // fraction of ink an output pixel needs to be set
+};
+
+// Stage 1: a raw width x height buffer, or a binary PGM (P5, maxval <= 255)
+// when width and height are 0. Returns false with `error` set on bad input.
+bool decode(const std::vector<uint8_t> &raw, int width, int height, GrayImage &out, std::string &error);
+
+// Stage 2: ink mask, 1 byte per pixel
+void threshold(const GrayImage &img, const Options &opt, std::vector<uint8_t> &mask);
+int otsu_threshold(const GrayImage &img);
+
+// Stage 3: ink bounding box scaled to opt.height rows and placed as in
+// Options; '0'/'1' string in the row-major layout of flatten_pattern. All
+// zeros if there is no ink.
+void center_resize(const std::vector<uint8_t> &mask, int width, int height, const Options &opt,
+                   std::string &flat);
+
+// Stage 4: LSB first, 8 pixels per byte, as pack_image_bytes in the harness
+void pack(const std::string &flat, Payload &payload);
+
+// All four stages
+bool prepare(const std::vector<uint8_t> &raw, int width, int height, const Options &opt, Payload &payload,
+             std::string &error);
+
+// One image in flight. Owned by the Pipeline; input and scratch buffers keep
+// their capacity from one image to the next.
+struct Frame
+{
+    uint64_t seq = 0;
+
+    // Input, filled by the caller between acquire() and submit()
+    std::vector<uint8_t> raw;
+    int width = 0; // 0: raw holds a PGM
+    int height = 0;
+
+    // Output, valid when returned by next()
+    bool ok = false;
+    std::string error;
+    std::string flat;
+    Payload payload{};
+
+    // Scratch
+    GrayImage gray;
+    std::vector<uint8_t> mask;
+};
+
+class Pipeline
+{
+public:
+    // `depth` frames exist in total; threads = 0 uses one per hardware thread
+    explicit Pipeline(const Options &opt, unsigned threads = 0, size_t depth = 64);
+    ~Pipeline();
+
+    Pipeline(const Pipeline &) = delete;
+    Pipeline &operator=(const Pipeline &) = delete;
+
+    Frame *acquire();        // blocks until a frame is free
+    void submit(Frame *f);   // queue an acquired frame for processing
+    Frame *next();           // next finished frame in submit order; nullptr once closed and drained
+    void release(Frame *f);  // hand a frame from next() back for reuse
+    void close();            // no more submits
+
+private:
+    void worker();
+
+    Options opt_;
+    std::vector<Frame> frames_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable free_cv_, work_cv_, done_cv_;
+    std::vector<Frame *> free_;
+    std::deque<Frame *> work_;
+    std::map<uint64_t, Frame *> done_; // finished, waiting for their turn
+    uint64_t next_seq_ = 0;
+    uint64_t next_out_ = 0;
+    bool closed_ = false;
+};
+
+} // namespace image_prep
@@ -0,0 +1,195 @@
+// Turns grayscale crops into 113-byte SPI image payloads with the
+// image_prep pipeline, or benchmarks the pipeline on synthetic crops.
+//
+// usage: prep_images <payloads.bin> <image.pgm>...
+//        prep_images --bench <count> [threads] [bnn_top.sv]
+//
+// payloads.bin gets one 113-byte payload per input image, in order; send
+// each after CMD_IMG_SEND_REQUEST. An image that cannot be preprocessed is
+// reported on stderr and left out, and the exit status is non-zero.
+//
+// --bench renders the digit set at random sizes and positions as dark ink on
+// a noisy light background and reports the pipeline throughput. Given
+// bnn_top.sv it also runs bnn::classify on the results, and fails if fewer
+// than MIN_AGREEMENT of them get the class the source pattern gets.
+
+#include "image_prep.hpp"
+#include "bnn_model.hpp"
+#include "digits.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+// The model is sensitive to where the digit sits in the frame, so this
+// mostly checks that preprocessing reproduces the reference layout
+constexpr double MIN_AGREEMENT = 0.65;
+
+struct Crop
+{
+    std::vector<uint8_t> pgm;
+    int label;
+    const std::vector<std::string> *source;
+};
+
+// Renders `rows` scaled to `height` pixels with a margin, as a binary PGM
+std::vector<uint8_t> render(const std::vector<std::string> &rows, int height, std::mt19937 &rng)
+{
+    int src = static_cast<int>(rows.size());
+    int margin = height / 4;
+    int w = height + 2 * margin, h = height + 2 * margin;
+    std::normal_distribution<double> noise{0, 12};
+
+    std::string header = "P5\n" + std::to_string(w) + " " + std::to_string(h) + "\n255\n";
+    std::vector<uint8_t> pgm(header.begin(), header.end());
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+        {
+            int sy = (y - margin) * src / height, sx = (x - margin) * src / height;
+            bool ink = sy >= 0 && sy < src && sx >= 0 && sx < src && rows[sy][sx] == '1';
+            double v = (ink ? 40 : 215) + noise(rng);
+            pgm.push_back(static_cast<uint8_t>(std::min(255.0, std::max(0.0, v))));
+        }
+    return pgm;
+}
+
+int bench(size_t count, unsigned threads, const char *bnn_top)
+{
+    const std::vector<std::pair<const std::vector<std::string> *, int>> digits = {
+        {&digit_0, 0}, {&digit_1, 1}, {&digit_2, 2}, {&digit_3, 3}, {&digit_4, 4},
+        {&digit_5, 5}, {&digit_6, 6}, {&digit_8, 8}, {&digit_9, 9}};
+
+    std::vector<Crop> crops;
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<int> size_dist{24, 120};
+    for (int i = 0; i < 180; ++i)
+    {
+        const auto &d = digits[i % digits.size()];
+        crops.push_back({render(*d.first, size_dist(rng), rng), d.second, d.first});
+    }
+
+    image_prep::Pipeline pipeline(image_prep::Options{}, threads);
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer(
+        [&]()
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                image_prep::Frame *f = pipeline.acquire();
+                f->raw = crops[i % crops.size()].pgm;
+                f->width = f->height = 0;
+                pipeline.submit(f);
+            }
+            pipeline.close();
+        });
+
+    // Keep the first pass over the crop set for the accuracy check
+    std::vector<std::string> flats;
+    size_t done = 0, failed = 0;
+    while (image_prep::Frame *f = pipeline.next())
+    {
+        failed += !f->ok;
+        if (flats.size() < crops.size())
+            flats.push_back(f->flat);
+        ++done;
+        pipeline.release(f);
+    }
+    producer.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "[PREP] " << done << " crops, " << (threads ? std::to_string(threads) : std::string("all"))
+              << " threads: " << std::fixed << std::setprecision(3) << seconds << " s, " << std::setprecision(0)
+              << done / seconds << " images/s (" << std::setprecision(1)
+              << done / seconds * image_prep::PAYLOAD_BYTES * 8 / 1e6 << " Mbit/s of payload)\n"
+              << std::defaultfloat;
+
+    if (bnn_top)
+    {
+        bnn::Weights w = bnn::load_weights(bnn_top);
+        int correct = 0, same = 0;
+        for (size_t i = 0; i < flats.size(); ++i)
+        {
+            int got = bnn::classify(w, flats[i]);
+            correct += got == crops[i].label;
+            same += got == bnn::classify(w, bnn::flatten(*crops[i].source));
+        }
+        std::cout << "[PREP] Model on preprocessed crops: " << correct << "/" << flats.size() << " correct, " << same
+                  << "/" << flats.size() << " same as on the source pattern\n";
+        if (same < MIN_AGREEMENT * flats.size())
+        {
+            std::cerr << "[PREP] Agreement with the source pattern below " << MIN_AGREEMENT * 100 << "%\n";
+            return EXIT_FAILURE;
+        }
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc >= 3 && std::string(argv[1]) == "--bench" && argc <= 5)
+    {
+        unsigned threads = argc > 3 ? static_cast<unsigned>(std::stoul(argv[3])) : 0;
+        return bench(std::stoull(argv[2]), threads, argc > 4 ? argv[4] : nullptr);
+    }
+    if (argc < 3 || std::string(argv[1]) == "--bench")
+    {
+        std::cerr << "usage: " << argv[0] << " <payloads.bin> <image.pgm>...\n"
+                  << "       " << argv[0] << " --bench <count> [threads] [bnn_top.sv]\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream out(argv[1], std::ios::binary);
+    if (!out)
+    {
+        std::cerr << "cannot write " << argv[1] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    image_prep::Pipeline pipeline(image_prep::Options{});
+    std::vector<char> readable(argc, 0); // set before the frame is submitted
+    std::thread producer(
+        [&]()
+        {
+            for (int i = 2; i < argc; ++i)
+            {
+                image_prep::Frame *f = pipeline.acquire();
+                std::ifstream in(argv[i], std::ios::binary);
+                readable[i] = static_cast<bool>(in);
+                f->raw.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+                f->width = f->height = 0;
+                pipeline.submit(f);
+            }
+            pipeline.close();
+        });
+
+    int status = EXIT_SUCCESS;
+    int index = 2;
+    while (image_prep::Frame *f = pipeline.next())
+    {
+        if (f->ok)
+            out.write(reinterpret_cast<const char *>(f->payload.data()), f->payload.size());
+        else
+        {
+            std::cerr << argv[index] << ": " << (readable[index] ? f->error : std::string("cannot read"))
+                      << ", skipped\n";
+            status = EXIT_FAILURE;
+        }
+        pipeline.release(f);
+        ++index;
+    }
+    producer.join();
+    return status;
+}
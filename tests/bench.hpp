@@ -0,0 +1,256 @@
+#pragma once
+
+// Shared driver for the module-level benchmarks (bench_*.cpp). Each one
+// verilates a single bnn_module block as its own top, so a layer can be
+// timed without going through SPI and the FSM.
+//
+// ConvCore is driven with its data_in_ready / data_out_ready pair: inputs
+// are applied while data_in_ready is low (which also resets the core), then
+// data_in_ready stays high until data_out_ready rises. The layers and
+// bnn_top stream jobs with in_valid / in_ready and out_valid / out_ready
+// instead, and get one job at a time through stream_op().
+//
+// Blocks that read block RAM through a prefetching port (FC's weights,
+// Conv2d_MaxPool2d's input channels) get a Ram model: latch() takes the
+// address before each clock edge and drive() returns the word after it,
+// like bnn_top's registered reads.
+
+#include "verilated.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace bench
+{
+
+struct Args
+{
+    int ops;
+    uint32_t seed = 1;
+};
+
+// usage: <bench> [ops] [seed]
+inline Args parse_args(int argc, char **argv, int default_ops)
+{
+    Verilated::commandArgs(argc, argv);
+    Args a{default_ops};
+    if (argc > 1 && argv[1][0] != '+')
+        a.ops = std::atoi(argv[1]);
+    if (argc > 2 && argv[2][0] != '+')
+        a.seed = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 0));
+    return a;
+}
+
+struct NoRam
+{
+    template <typename Dut>
+    void latch(Dut *)
+    {
+    }
+    template <typename Dut>
+    void drive(Dut *)
+    {
+    }
+};
+
+template <typename Dut, typename Ram>
+void tick(Dut *dut, Ram &ram)
+{
+    dut->clk = 0;
+    dut->eval();
+    ram.latch(dut);
+    dut->clk = 1;
+    dut->eval();
+    if (!std::is_same<Ram, NoRam>::value)
+    {
+        ram.drive(dut);
+        dut->eval();
+    }
+}
+
+template <typename Dut>
+void tick(Dut *dut)
+{
+    NoRam none;
+    tick(dut, none);
+}
+
+// One operation: cycles from data_in_ready rising to data_out_ready, or 0
+// if the block did not finish within max_cycles
+template <typename Dut, typename Ram>
+uint64_t run_op(Dut *dut, uint64_t max_cycles, Ram &ram)
+{
+    dut->data_in_ready = 0;
+    tick(dut, ram);
+    dut->data_in_ready = 1;
+    for (uint64_t cycles = 1; cycles <= max_cycles; ++cycles)
+    {
+        tick(dut, ram);
+        if (dut->data_out_ready)
+            return cycles;
+    }
+    return 0;
+}
+
+template <typename Dut>
+uint64_t run_op(Dut *dut, uint64_t max_cycles)
+{
+    NoRam none;
+    return run_op(dut, max_cycles, none);
+}
+
+// One job through a streaming block: cycles from in_valid rising to
+// out_valid, or 0 if the block did not finish within max_cycles. The
+// outputs are still there on return; out_ready stays high, so the first
+// clock of the next stream_op() takes them.
+template <typename Dut, typename Ram>
+uint64_t stream_op(Dut *dut, uint64_t max_cycles, Ram &ram)
+{
+    dut->clear = 0;
+    dut->in_valid = 1;
+    dut->out_ready = 1;
+    for (uint64_t cycles = 1; cycles <= max_cycles; ++cycles)
+    {
+        dut->eval();
+        bool taken = dut->in_ready;
+        tick(dut, ram);
+        if (taken)
+            dut->in_valid = 0;
+        if (dut->out_valid)
+        {
+            dut->in_valid = 0;
+            return cycles;
+        }
+    }
+    dut->in_valid = 0;
+    return 0;
+}
+
+template <typename Dut>
+uint64_t stream_op(Dut *dut, uint64_t max_cycles)
+{
+    NoRam none;
+    return stream_op(dut, max_cycles, none);
+}
+
+// Packed Verilog vectors are plain integers up to 64 bits and VlWide (an
+// array of 32-bit words) above that. Bits are passed one byte per bit.
+template <typename T>
+void set_bits_impl(T &v, const std::vector<uint8_t> &bits, std::true_type)
+{
+    v = 0;
+    for (size_t i = 0; i < bits.size(); ++i)
+        v |= static_cast<T>(bits[i] ? 1 : 0) << i;
+}
+
+template <typename W>
+void set_bits_impl(W &wide, const std::vector<uint8_t> &bits, std::false_type)
+{
+    for (size_t i = 0; i < bits.size(); ++i)
+    {
+        auto &word = wide[i / 32];
+        if (bits[i])
+            word |= 1u << (i % 32);
+        else
+            word &= ~(1u << (i % 32));
+    }
+}
+
+template <typename T>
+std::vector<uint8_t> get_bits_impl(const T &v, size_t n, std::true_type)
+{
+    std::vector<uint8_t> bits(n);
+    for (size_t i = 0; i < n; ++i)
+        bits[i] = (v >> i) & 1;
+    return bits;
+}
+
+template <typename W>
+std::vector<uint8_t> get_bits_impl(const W &wide, size_t n, std::false_type)
+{
+    std::vector<uint8_t> bits(n);
+    for (size_t i = 0; i < n; ++i)
+        bits[i] = (wide[i / 32] >> (i % 32)) & 1;
+    return bits;
+}
+
+template <typename W>
+void set_bits(W &w, const std::vector<uint8_t> &bits)
+{
+    set_bits_impl(w, bits, std::is_integral<W>{});
+}
+
+template <typename W>
+std::vector<uint8_t> get_bits(const W &w, size_t n)
+{
+    return get_bits_impl(w, n, std::is_integral<W>{});
+}
+
+inline std::vector<uint8_t> random_bits(std::mt19937 &rng, size_t n, double density = 0.5)
+{
+    std::bernoulli_distribution bit{density};
+    std::vector<uint8_t> bits(n);
+    for (auto &b : bits)
+        b = bit(rng);
+    return bits;
+}
+
+class Timer
+{
+public:
+    double seconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+};
+
+// Cycle statistics cover the operations that finished; a run_op() timeout
+// (0 cycles) is only counted
+struct Stats
+{
+    int ops = 0;
+    int timeouts = 0;
+    int mismatches = 0;
+    uint64_t cycles = 0;
+    uint64_t min_cycles = UINT64_MAX;
+    uint64_t max_cycles = 0;
+
+    void add(uint64_t c)
+    {
+        if (c == 0)
+        {
+            ++timeouts;
+            return;
+        }
+        ++ops;
+        cycles += c;
+        min_cycles = std::min(min_cycles, c);
+        max_cycles = std::max(max_cycles, c);
+    }
+};
+
+// One summary line per benchmark; returns the process exit code
+inline int report(const std::string &name, const Stats &s, double seconds)
+{
+    double mean = s.ops ? static_cast<double>(s.cycles) / s.ops : 0.0;
+    uint64_t min_cycles = s.ops ? s.min_cycles : 0;
+    std::cout << std::fixed << "[BENCH] " << name << ": " << s.ops << " ops, " << std::setprecision(1) << mean
+              << " cycles/op (" << min_cycles << ".." << s.max_cycles << "), " << std::setprecision(2)
+              << s.cycles / seconds / 1e6 << " M sim cycles/s, " << std::setprecision(0) << s.ops / seconds
+              << " ops/s, " << s.timeouts << " timeouts, " << s.mismatches << " mismatches\n"
+              << std::defaultfloat;
+    return (s.mismatches || s.timeouts) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+} // namespace bench
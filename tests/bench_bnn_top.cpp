@@ -0,0 +1,64 @@
+// bnn_top verilated on its own at one point of the design-space sweep
+// (src/host/bnn_sweep.cpp), with the weights that tool generated for it.
+// BENCH_IMG must match the -GCONV1_IMG_IN_SIZE bnn_top was verilated with.
+//
+// usage: bench_bnn_top <images.txt>
+//
+// images.txt holds one BENCH_IMG^2 character '0'/'1' image per line; for
+// each, "<cycles> <result>" is printed, cycles counted in bnn_top clocks
+// from in_valid to out_valid (0 if it never finished).
+
+#include "Vbnn_top.h"
+#include "bench.hpp"
+
+#include <fstream>
+#include <memory>
+
+#ifndef BENCH_IMG
+#define BENCH_IMG 30
+#endif
+
+// bnn_top logs the start and end of every job through DPI; nothing to log here
+extern "C" void debug_log_bnn_start(int, int) {}
+extern "C" void debug_log_bnn_done(int, int) {}
+
+int main(int argc, char **argv)
+{
+    Verilated::commandArgs(argc, argv);
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <images.txt>\n";
+        return EXIT_FAILURE;
+    }
+    std::ifstream in(argv[1]);
+    if (!in)
+    {
+        std::cerr << "cannot open " << argv[1] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    auto dut = std::make_unique<Vbnn_top>();
+    dut->incremental = 0;
+    dut->weight_bank = 0;
+    dut->weight_wr_en = 0;
+    bench::set_bits(dut->dirty_in, std::vector<uint8_t>(BENCH_IMG * BENCH_IMG, 0));
+
+    for (std::string line; std::getline(in, line);)
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.size() != BENCH_IMG * BENCH_IMG)
+            continue;
+
+        std::vector<uint8_t> bits(line.size());
+        for (size_t i = 0; i < line.size(); ++i)
+            bits[i] = line[i] == '1';
+        bench::set_bits(dut->conv1_img_in[0], bits);
+
+        uint64_t cycles = bench::stream_op(dut.get(), 100000000ull);
+        std::cout << cycles << " " << static_cast<int>(dut->result) << "\n";
+    }
+
+    dut->final();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,41 @@
+// Comparator on random score vectors, checked against bnn::argmax. Half of
+// the vectors come from a narrow range so ties (first maximum wins) are
+// common.
+//
+// usage: bench_comparator [ops] [seed]
+
+#include "VComparator.h"
+#include "bench.hpp"
+#include "bnn_model.hpp"
+
+#include <memory>
+
+int main(int argc, char **argv)
+{
+    bench::Args args = bench::parse_args(argc, argv, 100000);
+    auto dut = std::make_unique<VComparator>();
+    std::mt19937 rng{args.seed};
+    std::uniform_int_distribution<int> wide{INT16_MIN, INT16_MAX};
+    std::uniform_int_distribution<int> narrow{-3, 3};
+    bench::Stats stats;
+    bench::Timer timer;
+
+    std::vector<int16_t> scores(bnn::FC_OC);
+    for (int op = 0; op < args.ops; ++op)
+    {
+        for (int i = 0; i < bnn::FC_OC; ++i)
+        {
+            scores[i] = static_cast<int16_t>(op % 2 ? narrow(rng) : wide(rng));
+            dut->in[i] = static_cast<uint16_t>(scores[i]);
+        }
+
+        uint64_t cycles = bench::stream_op(dut.get(), 100);
+        stats.add(cycles);
+        if ((!cycles || dut->out != bnn::argmax(scores)) && stats.mismatches++ < 5)
+            std::cerr << "[BENCH] Comparator op " << op << (cycles ? ": output differs from bnn::argmax\n"
+                                                                    : ": no out_valid\n");
+    }
+
+    dut->final();
+    return bench::report("Comparator " + std::to_string(bnn::FC_OC) + " classes", stats, timer.seconds());
+}
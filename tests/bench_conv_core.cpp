@@ -0,0 +1,83 @@
+// ConvCore on random images and weights. Shape from BENCH_IC / BENCH_IN,
+// which must match the -G parameters the module was verilated with.
+//
+// usage: bench_conv_core [ops] [seed]
+
+#include "VConvCore.h"
+#include "bench.hpp"
+
+#include <memory>
+
+#ifndef BENCH_IC
+#define BENCH_IC 1
+#endif
+#ifndef BENCH_IN
+#define BENCH_IN 30
+#endif
+
+namespace
+{
+
+constexpr int IC = BENCH_IC;
+constexpr int IN = BENCH_IN;
+constexpr int OUT = IN - 2;
+
+// ConvCore as it behaves: each conv pixel is the 8-bit wrapping +/-1 sum of
+// its window. The first pixel of every row but the first is computed on the
+// window of the previous row's last column, because img_ind is advanced
+// from the old col when the row wraps. ConvPoolCore, which replaced ConvCore
+// in bnn_top, does not have this quirk.
+std::vector<uint8_t> conv_core_model(const std::vector<std::vector<uint8_t>> &img, const std::vector<uint8_t> &w)
+{
+    std::vector<uint8_t> out(OUT * OUT);
+    for (int r = 0; r < OUT; ++r)
+        for (int c = 0; c < OUT; ++c)
+        {
+            int wc = (c == 0 && r > 0) ? OUT - 1 : c;
+            int8_t popcount = 0;
+            for (int ic = 0; ic < IC; ++ic)
+                for (int tap = 0; tap < 9; ++tap)
+                {
+                    bool match = img[ic][(r + tap / 3) * IN + wc + tap % 3] == w[ic * 9 + tap];
+                    popcount = static_cast<int8_t>(popcount + (match ? 1 : -1));
+                }
+            out[r * OUT + c] = popcount >= 0;
+        }
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bench::Args args = bench::parse_args(argc, argv, 100);
+    auto dut = std::make_unique<VConvCore>();
+    std::mt19937 rng{args.seed};
+    bench::Stats stats;
+    bench::Timer timer;
+
+    for (int op = 0; op < args.ops; ++op)
+    {
+        std::vector<std::vector<uint8_t>> img;
+        for (int ic = 0; ic < IC; ++ic)
+        {
+            img.push_back(bench::random_bits(rng, IN * IN));
+            bench::set_bits(dut->img_in[ic], img[ic]);
+        }
+        std::vector<uint8_t> w = bench::random_bits(rng, IC * 9);
+        bench::set_bits(dut->weights, w);
+
+        uint64_t cycles = bench::run_op(dut.get(), 100ull * OUT * OUT * IC * 10);
+        stats.add(cycles);
+        if (!cycles || bench::get_bits(dut->img_out, OUT * OUT) != conv_core_model(img, w))
+        {
+            if (stats.mismatches++ < 5)
+                std::cerr << "[BENCH] ConvCore op " << op << (cycles ? ": output differs from the model\n"
+                                                                      : ": no data_out_ready\n");
+        }
+    }
+
+    dut->final();
+    return bench::report("ConvCore IC=" + std::to_string(IC) + " " + std::to_string(IN) + "x" + std::to_string(IN),
+                         stats, timer.seconds());
+}
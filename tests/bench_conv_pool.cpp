@@ -0,0 +1,107 @@
+// Conv2d_MaxPool2d (all output channels through ConvPoolCore) on random
+// images and weights, checked against bnn::conv_pool. Shape from BENCH_IC /
+// BENCH_OC / BENCH_IN, which must match the -G parameters the module was
+// verilated with. BENCH_DENSITY sets the fraction of 1 pixels, which
+// drives how often the per-window early-out fires. Input channels are
+// served through the module's RAM port with one cycle of latency (the
+// whole img_in array under CONV_SPECIALIZED).
+//
+// usage: bench_conv_pool [ops] [seed]
+
+#include "VConv2d_MaxPool2d.h"
+#include "bench.hpp"
+#include "bnn_model.hpp"
+
+#include <memory>
+
+#ifndef BENCH_IC
+#define BENCH_IC 1
+#endif
+#ifndef BENCH_OC
+#define BENCH_OC 16
+#endif
+#ifndef BENCH_IN
+#define BENCH_IN 30
+#endif
+#ifndef BENCH_DENSITY
+#define BENCH_DENSITY 0.5
+#endif
+
+namespace
+{
+
+constexpr int IC = BENCH_IC;
+constexpr int OC = BENCH_OC;
+constexpr int IN = BENCH_IN;
+constexpr int POOL = (IN - 2) / 2;
+
+#ifndef CONV_SPECIALIZED
+struct ChannelRam
+{
+    std::vector<std::vector<uint8_t>> *img;
+    uint32_t ch = 0;
+    uint32_t driven = UINT32_MAX;
+
+    void latch(VConv2d_MaxPool2d *dut) { ch = static_cast<uint32_t>(dut->in_ch) % IC; }
+    void drive(VConv2d_MaxPool2d *dut)
+    {
+        if (ch != driven)
+            bench::set_bits(dut->in_data, (*img)[ch]);
+        driven = ch;
+    }
+};
+#endif
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bench::Args args = bench::parse_args(argc, argv, 100);
+    auto dut = std::make_unique<VConv2d_MaxPool2d>();
+    std::mt19937 rng{args.seed};
+    bench::Stats stats;
+    bench::Timer timer;
+
+    dut->incremental = 0;
+    dut->rd_ch = 0;
+    bench::set_bits(dut->dirty_in, std::vector<uint8_t>(IN * IN, 0));
+
+    for (int op = 0; op < args.ops; ++op)
+    {
+        std::vector<std::vector<uint8_t>> img, w;
+        for (int ic = 0; ic < IC; ++ic)
+        {
+            img.push_back(bench::random_bits(rng, IN * IN, BENCH_DENSITY));
+#ifdef CONV_SPECIALIZED
+            bench::set_bits(dut->img_in[ic], img[ic]);
+#endif
+        }
+        for (int oc = 0; oc < OC; ++oc)
+        {
+            w.push_back(bench::random_bits(rng, IC * 9));
+            bench::set_bits(dut->weights[oc], w[oc]);
+        }
+
+        uint64_t max_cycles = 100ull * (OC + 1) * (IN - 2) * (IN - 2) * IC * 10;
+#ifdef CONV_SPECIALIZED
+        uint64_t cycles = bench::stream_op(dut.get(), max_cycles);
+#else
+        ChannelRam ram{&img};
+        uint64_t cycles = bench::stream_op(dut.get(), max_cycles, ram);
+#endif
+        stats.add(cycles);
+
+        bool same = cycles != 0;
+        std::vector<std::vector<uint8_t>> expected = bnn::conv_pool(img, IN, w);
+        for (int oc = 0; oc < OC && same; ++oc)
+            same = bench::get_bits(dut->img_out[oc], POOL * POOL) == expected[oc];
+        if (!same && stats.mismatches++ < 5)
+            std::cerr << "[BENCH] Conv2d_MaxPool2d op " << op
+                      << (cycles ? ": output differs from bnn::conv_pool\n" : ": no out_valid\n");
+    }
+
+    dut->final();
+    return bench::report("Conv2d_MaxPool2d IC=" + std::to_string(IC) + " OC=" + std::to_string(OC) + " " +
+                             std::to_string(IN) + "x" + std::to_string(IN),
+                         stats, timer.seconds());
+}
@@ -0,0 +1,67 @@
+// FC (Q8.8, bnn_top's 576 -> 10 shape) on random inputs and weights,
+// checked against bnn::fc_q88. Weights are drawn from the range of
+// bnn_top's fc_weights so the 16-bit sums wrap about as often. The
+// weights are served through FC's RAM port with one cycle of latency.
+//
+// usage: bench_fc [ops] [seed]
+
+#include "VFC.h"
+#include "bench.hpp"
+#include "bnn_model.hpp"
+
+#include <memory>
+
+namespace
+{
+
+struct WeightRam
+{
+    const std::vector<int16_t> &words;
+    uint32_t addr = 0;
+
+    void latch(VFC *dut) { addr = dut->weight_addr; }
+    void drive(VFC *dut) { dut->weight_data = static_cast<uint16_t>(addr < words.size() ? words[addr] : 0); }
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bench::Args args = bench::parse_args(argc, argv, 1000);
+    auto dut = std::make_unique<VFC>();
+    std::mt19937 rng{args.seed};
+    std::uniform_int_distribution<int> weight{-128, 127};
+    bench::Stats stats;
+    bench::Timer timer;
+
+    bnn::Weights w;
+    w.fc.resize(bnn::FC_IC * bnn::FC_OC);
+    WeightRam ram{w.fc};
+    dut->incremental = 0;
+    dut->early_exit = 0;
+
+    for (int op = 0; op < args.ops; ++op)
+    {
+        // New weights every few ops; drawing 5760 of them dominates otherwise
+        if (op % 16 == 0)
+            for (auto &wt : w.fc)
+                wt = static_cast<int16_t>(weight(rng));
+        std::vector<uint8_t> in = bench::random_bits(rng, bnn::FC_IC);
+        bench::set_bits(dut->in, in);
+
+        uint64_t cycles = bench::stream_op(dut.get(), 10ull * bnn::fc_q88_cycles(), ram);
+        stats.add(cycles);
+
+        bool same = cycles != 0;
+        std::vector<int16_t> expected = bnn::fc_q88(w, in);
+        for (int oc = 0; oc < bnn::FC_OC && same; ++oc)
+            same = static_cast<int16_t>(dut->out[oc]) == expected[oc];
+        if (!same && stats.mismatches++ < 5)
+            std::cerr << "[BENCH] FC op " << op << (cycles ? ": output differs from bnn::fc_q88\n"
+                                                            : ": no out_valid\n");
+    }
+
+    dut->final();
+    return bench::report("FC " + std::to_string(bnn::FC_IC) + "x" + std::to_string(bnn::FC_OC), stats,
+                         timer.seconds());
+}
@@ -0,0 +1,115 @@
+// FC built with EARLY_EXIT on the digit set: bnn_top's own fc_weights and
+// the FC inputs the conv layers produce for each digit, clean and with a few
+// pixels flipped (the sets fc_bounds reports on). Each image runs once with
+// early_exit low and once high; the first must match bnn::fc_q88, the
+// second bnn::fc_q88_early_exit (same class, same cycle count).
+//
+// usage: bench_fc_early_exit [bnn_top.sv]
+// (default: $BNN_SOURCE_DIR/src/fpga/bnn_module/bnn_top.sv)
+
+#include "VFC.h"
+#include "bench.hpp"
+#include "bnn_model.hpp"
+#include "digits.h"
+#include "source_path.hpp"
+
+#include <memory>
+
+namespace
+{
+
+struct WeightRam
+{
+    const std::vector<int16_t> &words;
+    uint32_t addr = 0;
+
+    void latch(VFC *dut) { addr = dut->weight_addr; }
+    void drive(VFC *dut) { dut->weight_data = static_cast<uint16_t>(addr < words.size() ? words[addr] : 0); }
+};
+
+std::vector<std::string> digit_set()
+{
+    std::vector<std::vector<std::string>> digits = {digit_0, digit_1, digit_2, digit_3, digit_4,
+                                                    digit_5, digit_6, digit_8, digit_9};
+    std::vector<std::string> set;
+    for (const auto &rows : digits)
+        set.push_back(bnn::flatten(rows));
+
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<int> px_dist{0, bnn::IMG_SIZE * bnn::IMG_SIZE - 1};
+    for (size_t d = 0; d < digits.size(); ++d)
+        for (int v = 0; v < 20; ++v)
+        {
+            std::string n = set[d];
+            for (int f = 0; f < 12; ++f)
+            {
+                char &px = n[px_dist(rng)];
+                px = (px == '1') ? '0' : '1';
+            }
+            set.push_back(n);
+        }
+    return set;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Verilated::commandArgs(argc, argv);
+    std::string path;
+    if (argc > 1 && argv[1][0] != '+')
+        path = argv[1];
+    else
+        path = source_path("src/fpga/bnn_module/bnn_top.sv");
+
+    bnn::Weights w = bnn::load_weights(path);
+    std::vector<int32_t> bounds = bnn::fc_bounds(w);
+
+    auto dut = std::make_unique<VFC>();
+    WeightRam ram{w.fc};
+    dut->incremental = 0;
+    for (size_t i = 0; i < bounds.size(); ++i)
+        dut->bound[i] = static_cast<uint32_t>(bounds[i]);
+
+    bench::Stats full, early;
+    bench::Timer timer;
+    for (const std::string &flat : digit_set())
+    {
+        std::vector<uint8_t> fc_in = bnn::features(w, flat);
+        bench::set_bits(dut->in, fc_in);
+
+        dut->early_exit = 0;
+        uint64_t cycles = bench::stream_op(dut.get(), 10ull * bnn::fc_q88_cycles(), ram);
+        full.add(cycles);
+        std::vector<int16_t> expected = bnn::fc_q88(w, fc_in);
+        bool same = cycles != 0;
+        for (int oc = 0; oc < bnn::FC_OC && same; ++oc)
+            same = static_cast<int16_t>(dut->out[oc]) == expected[oc];
+        if (!same && full.mismatches++ < 5)
+            std::cerr << "[BENCH] FC full pass differs from bnn::fc_q88\n";
+
+        dut->early_exit = 1;
+        cycles = bench::stream_op(dut.get(), 10ull * bnn::fc_q88_cycles(), ram);
+        early.add(cycles);
+        int model_cycles = 0;
+        expected = bnn::fc_q88_early_exit(w, bounds, fc_in, &model_cycles);
+        same = cycles == static_cast<uint64_t>(model_cycles);
+        for (int oc = 0; oc < bnn::FC_OC && same; ++oc)
+            same = static_cast<int16_t>(dut->out[oc]) == expected[oc];
+        same = same && bnn::argmax(expected) == bnn::argmax(bnn::fc_q88(w, fc_in));
+        if (!same && early.mismatches++ < 5)
+            std::cerr << "[BENCH] FC early exit differs from bnn::fc_q88_early_exit (" << cycles << " vs "
+                      << model_cycles << " cycles)\n";
+    }
+    double seconds = timer.seconds();
+
+    dut->final();
+    int rc_full = bench::report("FC digits, full pass", full, seconds);
+    int rc_early = bench::report("FC digits, early exit", early, seconds);
+    double avg_full = full.ops ? static_cast<double>(full.cycles) / full.ops : 0.0;
+    double avg_early = early.ops ? static_cast<double>(early.cycles) / early.ops : 0.0;
+    std::cout << std::fixed << std::setprecision(1) << "[BENCH] FC early exit saves " << avg_full - avg_early
+              << " cycles per image on average (" << 100.0 * (1.0 - avg_early / avg_full) << "%)\n"
+              << std::defaultfloat;
+    return rc_full != EXIT_SUCCESS ? rc_full : rc_early;
+}
@@ -0,0 +1,150 @@
+#include "main_test.hpp"
+#include "svdpi.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// DPI side of the bnn_top taps (define BNN_TAPS). Each stage's tensor is
+// staged per bnn_top instance; the result tap completes the record.
+//
+// File layout, little-endian:
+//   BnnTapHeader
+//   BnnTapRecord * count
+//   index: {u32 tag, u64 record offset} * count
+//   BnnTapFooter
+
+namespace
+{
+struct TapFile
+{
+    std::ofstream out;
+    std::map<std::string, BnnTapRecord> pending; // by bnn_top scope
+    std::map<std::string, uint8_t> cores;   // scope -> core number, in order of first use
+    std::vector<std::pair<uint32_t, uint64_t>> index;
+    uint32_t tag = 0;
+    uint32_t seq = 0;
+};
+
+TapFile *taps = nullptr;
+
+void copy_bits(uint8_t *dst, const svBitVecVal *src, int bits)
+{
+    std::memset(dst, 0, (bits + 7) / 8);
+    for (int i = 0; i < bits; ++i)
+        if ((src[i / 32] >> (i % 32)) & 1)
+            dst[i / 8] |= 1 << (i % 8);
+}
+
+template <typename T>
+void put(std::ofstream &out, const T &v)
+{
+    out.write(reinterpret_cast<const char *>(&v), sizeof(v));
+}
+} // namespace
+
+void bnn_taps_open(const std::string &path)
+{
+    delete taps;
+    taps = new TapFile;
+    taps->out.open(path, std::ios::binary);
+    if (!taps->out)
+        throw std::runtime_error("bnn_taps_open: cannot write " + path);
+
+    BnnTapHeader hdr{};
+    std::memcpy(hdr.magic, "BNNT", 4);
+    hdr.version = 1;
+    hdr.record_size = sizeof(BnnTapRecord);
+    put(taps->out, hdr);
+}
+
+void bnn_taps_set_tag(uint32_t tag)
+{
+    if (taps)
+        taps->tag = tag;
+}
+
+size_t bnn_taps_close()
+{
+    if (!taps)
+        return 0;
+
+    BnnTapFooter foot{};
+    foot.index_offset = static_cast<uint64_t>(taps->out.tellp());
+    for (const auto &[tag, offset] : taps->index)
+    {
+        put(taps->out, tag);
+        put(taps->out, offset);
+    }
+    foot.count = static_cast<uint32_t>(taps->index.size());
+    std::memcpy(foot.magic, "BNNI", 4);
+    put(taps->out, foot);
+
+    size_t count = taps->index.size();
+    delete taps;
+    taps = nullptr;
+    return count;
+}
+
+std::vector<BnnTapRecord> bnn_taps_read(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    BnnTapHeader hdr{};
+    in.read(reinterpret_cast<char *>(&hdr), sizeof(hdr));
+    if (!in || std::memcmp(hdr.magic, "BNNT", 4) != 0 || hdr.record_size != sizeof(BnnTapRecord))
+        throw std::runtime_error("bnn_taps_read: " + path + " is not a tap file");
+
+    in.seekg(-static_cast<std::streamoff>(sizeof(BnnTapFooter)), std::ios::end);
+    BnnTapFooter foot{};
+    in.read(reinterpret_cast<char *>(&foot), sizeof(foot));
+
+    std::vector<BnnTapRecord> recs(foot.count);
+    in.seekg(sizeof(BnnTapHeader));
+    in.read(reinterpret_cast<char *>(recs.data()), foot.count * sizeof(BnnTapRecord));
+    return recs;
+}
+
+extern "C" void bnn_tap_pool1(const char *scope, const svBitVecVal *bits)
+{
+    if (taps)
+        copy_bits(taps->pending[scope].pool1, bits, BNN_TAP_POOL1_BITS);
+}
+
+extern "C" void bnn_tap_fc_in(const char *scope, const svBitVecVal *bits)
+{
+    if (taps)
+        copy_bits(taps->pending[scope].fc_in, bits, BNN_TAP_FC_IN_BITS);
+}
+
+extern "C" void bnn_tap_fc_out(const char *scope, const svBitVecVal *scores)
+{
+    if (!taps)
+        return;
+    for (int oc = 0; oc < BNN_TAP_FC_OUT; ++oc)
+    {
+        uint32_t lo = oc * 16;
+        uint16_t v = (scores[lo / 32] >> (lo % 32)) & 0xFFFF;
+        taps->pending[scope].fc_out[oc] = static_cast<int16_t>(v);
+    }
+}
+
+extern "C" void bnn_tap_result(const char *scope, int result)
+{
+    if (!taps)
+        return;
+
+    auto core = taps->cores.emplace(scope, static_cast<uint8_t>(taps->cores.size())).first->second;
+    BnnTapRecord &rec = taps->pending[scope];
+    rec.seq = taps->seq++;
+    rec.tag = taps->tag;
+    rec.core = core;
+    rec.result = static_cast<uint8_t>(result);
+
+    taps->index.emplace_back(rec.tag, static_cast<uint64_t>(taps->out.tellp()));
+    put(taps->out, rec);
+    taps->pending.erase(scope);
+}
@@ -0,0 +1,101 @@
+#include "main_test.hpp"
+#include "debug_log.hpp"
+#include "svdpi.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+// DPI sink for debug_module / bnn_top events. Records go into a ring buffer
+// that keeps the most recent DEBUG_LOG_CAPACITY of them; nothing is
+// formatted until the log is saved and decoded offline.
+
+namespace
+{
+constexpr size_t DEBUG_LOG_CAPACITY = 1 << 20; // 16 MiB of records
+
+std::vector<debug_log::Record> ring(DEBUG_LOG_CAPACITY);
+size_t ring_head = 0;  // next slot to write
+uint64_t ring_total = 0; // records ever written
+uint32_t main_cycle = 0; // latest debug_module cycle, stamps bnn_top's events
+
+debug_log::Record &next_record(uint32_t cycle, uint8_t type, uint8_t aux)
+{
+    debug_log::Record &rec = ring[ring_head];
+    ring_head = (ring_head + 1) % DEBUG_LOG_CAPACITY;
+    ring_total++;
+    std::memset(&rec, 0, sizeof(rec));
+    rec.cycle = cycle;
+    rec.type = type;
+    rec.aux = aux;
+    return rec;
+}
+} // namespace
+
+void debug_log_clear()
+{
+    ring_head = 0;
+    ring_total = 0;
+    main_cycle = 0;
+}
+
+size_t debug_log_size()
+{
+    return ring_total < DEBUG_LOG_CAPACITY ? ring_total : DEBUG_LOG_CAPACITY;
+}
+
+std::vector<debug_log::Record> debug_log_records()
+{
+    std::vector<debug_log::Record> out;
+    size_t n = debug_log_size();
+    out.reserve(n);
+    size_t start = (ring_head + DEBUG_LOG_CAPACITY - n) % DEBUG_LOG_CAPACITY;
+    for (size_t i = 0; i < n; ++i)
+        out.push_back(ring[(start + i) % DEBUG_LOG_CAPACITY]);
+    return out;
+}
+
+size_t debug_log_save(const std::string &path)
+{
+    std::vector<debug_log::Record> out = debug_log_records();
+    debug_log::write(path, out);
+    return out.size();
+}
+
+extern "C" void debug_log_signals(int cycle, int sclk_cycle, int flags, int status, int result,
+                                  int spi_rx_data, int data_in, int write_addr)
+{
+    main_cycle = cycle;
+    debug_log::Record &rec = next_record(cycle, debug_log::SIGNALS, ((status & 0xF) << 4) | (result & 0xF));
+    rec.sig.spi_rx_data = spi_rx_data;
+    rec.sig.data_in = data_in;
+    rec.sig.buffer_write_addr = write_addr;
+    rec.sig.flags = flags;
+    rec.sig.sclk_cycle = sclk_cycle;
+}
+
+extern "C" void debug_log_image(int cycle, const svBitVecVal *img)
+{
+    for (int chunk = 0; chunk < debug_log::IMAGE_CHUNKS; ++chunk)
+    {
+        debug_log::Record &rec = next_record(cycle, debug_log::IMAGE, chunk);
+        for (int i = 0; i < debug_log::CHUNK_BYTES * 8; ++i)
+        {
+            int px = chunk * debug_log::CHUNK_BYTES * 8 + i;
+            if (px < debug_log::IMAGE_BITS && ((img[px / 32] >> (px % 32)) & 1))
+                rec.image[i / 8] |= 1 << (i % 8);
+        }
+    }
+}
+
+// bnn_top logs these only while debug_enable is high, when debug_module is
+// logging a snapshot every main clock cycle
+extern "C" void debug_log_bnn_start(int bnn_cycle, int nonzero)
+{
+    next_record(main_cycle, debug_log::BNN_START, nonzero ? 1 : 0).bnn.cycle = bnn_cycle;
+}
+
+extern "C" void debug_log_bnn_done(int bnn_cycle, int result)
+{
+    next_record(main_cycle, debug_log::BNN_DONE, result & 0xF).bnn.cycle = bnn_cycle;
+}
@@ -1,7 +1,9 @@
+#pragma once
+
 #include <vector>
 #include <string>
 
-std::vector<std::string> digit_0 = {
+inline std::vector<std::string> digit_0 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000",
     "000000000000000000000000000000",
@@ -33,7 +35,7 @@ std::vector<std::string> digit_0 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000"};
 
-std::vector<std::string> digit_1 = {
+inline std::vector<std::string> digit_1 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000",
     "000000000000000000000000000000",
@@ -65,7 +67,7 @@ std::vector<std::string> digit_1 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000"};
 
-std::vector<std::string> digit_2 = {
+inline std::vector<std::string> digit_2 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000",
     "000000000000000000000000000000",
@@ -97,7 +99,7 @@ std::vector<std::string> digit_2 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000"};
 
-std::vector<std::string> digit_3 = {
+inline std::vector<std::string> digit_3 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000",
     "000000000000000000000000000000",
@@ -129,7 +131,7 @@ std::vector<std::string> digit_3 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000"};
 
-std::vector<std::string> digit_4 = {
+inline std::vector<std::string> digit_4 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000",
     "000000000000000000000000000000",
@@ -161,7 +163,7 @@ std::vector<std::string> digit_4 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000"};
 
-std::vector<std::string> digit_5 = {
+inline std::vector<std::string> digit_5 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000",
     "000000000000000000000000000000",
@@ -193,7 +195,7 @@ std::vector<std::string> digit_5 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000"};
 
-std::vector<std::string> digit_6 = {
+inline std::vector<std::string> digit_6 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000",
     "000000000000000000000000000000",
@@ -225,7 +227,7 @@ std::vector<std::string> digit_6 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000"};
 
-std::vector<std::string> digit_8 = {
+inline std::vector<std::string> digit_8 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000",
     "000000000000000000000000000000",
@@ -257,7 +259,7 @@ std::vector<std::string> digit_8 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000"};
 
-std::vector<std::string> digit_9 = {
+inline std::vector<std::string> digit_9 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000",
     "000000000000000000000000000000",
@@ -289,7 +291,7 @@ std::vector<std::string> digit_9 = {
     "000000000000000000000000000000",
     "000000000000000000000000000000"};
 
-std::vector<std::string> repeating_pattern = {
+inline std::vector<std::string> repeating_pattern = {
     "100000001100000011100000111100",
     "111110001111110011111100111111",
     "100000001100000011100000111100",
@@ -1,89 +1,193 @@
 #include "verilated.h"
 #include "svdpi.h"
 #include "handles.h"
+#include "tb_sched.hpp"
+#include "source_path.hpp"
+#include "bnn_model.hpp"
+#include "digits.h"
 #include <iostream>
 #include <cstdlib>
+#include <string>
+#include <vector>
 
-// Vtb *dut = nullptr;
+// Transaction-level testbench for the tb.sv flow. c_external is called on
+// every edge of the tb clock; on posedges it ticks the scheduler, which
+// resumes the SPI master, result monitor, scoreboard and watchdog agents
+// when they are due. Pins driven here take effect at main.cpp's next eval,
+// well before the following posedge.
 
-// ------------------------------------------------------------------
-// Simple SPI‐master state machine
-// ------------------------------------------------------------------
-enum SpiState
+namespace
 {
-    ASSERT_CS,
-    SEND_BITS,
-    DEASSERT_CS,
-    DONE
+constexpr uint8_t CMD_IMG_SEND_REQUEST = 0xFE;
+constexpr uint8_t CMD_CLEAR = 0xFD;
+
+constexpr int STATUS_IDLE = 0;
+constexpr int STATUS_RX_IMG_RDY = 1;
+constexpr int STATUS_RESULT_RDY = 8;
+
+constexpr int SCLK_HALF_CYCLES = 4;       // main clock cycles per SCLK half period
+constexpr uint64_t TIMEOUT_CYCLES = 2000000; // whole scenario
+
+struct Image
+{
+    std::string name;
+    std::string flat;
 };
 
-extern "C" void c_external(const svBit is_posedge)
+struct Expected
 {
-    // Grab the current TB scope (the one `tb` instance)
-    // dut = (Vtb *)Verilated::dpiScope();
-    assert(::dut && "dut not set!");
+    std::string name;
+    int digit;
+};
 
-    static SpiState state = ASSERT_CS;
-    static int bytes_sent = 0, bit_idx = 7;
-    static uint8_t cur_byte = 0x55;
+tb::Scheduler sched;
+tb::Mailbox<Expected> expected(sched); // master -> scoreboard
+tb::Mailbox<int> observed(sched);      // monitor -> scoreboard
+tb::Mailbox<bool> checked(sched);      // scoreboard -> master
 
-    switch (state)
+bool finished = false;
+int exit_code = 0;
+
+int status() { return dut->status_code_reg; }
+
+int seg_digit(uint8_t seg)
+{
+    static const uint8_t SEGS[10] = {0x40, 0x79, 0x24, 0x30, 0x19, 0x12, 0x02, 0x78, 0x00, 0x10};
+    for (int d = 0; d < 10; ++d)
+        if (seg == SEGS[d])
+            return d;
+    return bnn::BLANK_RESULT;
+}
+
+tb::Task spi_send_byte(uint8_t byte)
+{
+    dut->spi_cs_n = 0;
+    co_await sched.cycles(7);
+    for (int i = 7; i >= 0; --i)
     {
-    case ASSERT_CS:
-        dut->spi_cs_n = 0;
-        bit_idx = 7;
-        bytes_sent = 0;
-        cur_byte = 0x55;
-        state = SEND_BITS;
-        break;
-
-    case SEND_BITS:
-        // Drive SCLK = is_posedge
-        std::cout << "[C++] Status code: " << (int)dut->status_code_reg << "\n";
-        dut->SCLK = is_posedge;
-        if (!is_posedge)
-        {
-            // falling edge: set next COPI bit
-            dut->COPI = (cur_byte >> bit_idx) & 1;
-        }
-        else
-        {
-            // rising edge: advance bit counter
-            if (--bit_idx < 0)
-            {
-                bit_idx = 7;
-                if (++bytes_sent < 113)
-                {
-                    cur_byte = 0x55;
-                }
-                else if (bytes_sent == 113)
-                {
-                    cur_byte = 0xFF; // “process” command
-                }
-                else
-                {
-                    state = DEASSERT_CS;
-                }
-            }
-        }
-        break;
-
-    case DEASSERT_CS:
-        dut->spi_cs_n = 1;
+        dut->COPI = (byte >> i) & 1;
+        co_await sched.cycles(2);
+        dut->SCLK = 1;
+        co_await sched.cycles(SCLK_HALF_CYCLES);
         dut->SCLK = 0;
-        std::cout << "[C++] All bytes sent, deasserting CS\n";
-        std::cout << "[C++] Bytes sent: " << bytes_sent << "\n";
-        std::cout << "[C++] Segment: " << (int)dut->seg << "\n";
-        std::cout << "[C++] Status code: " << (int)dut->status_code_reg << "\n";
-        state = DONE;
-        break;
-
-    case DONE:
-        std::cout << "[C++] DONE reached, exiting simulation\n";
-        std::exit(0);
-        break;
+        co_await sched.cycles(SCLK_HALF_CYCLES);
+    }
+    co_await sched.cycles(7);
+    dut->spi_cs_n = 1;
+    co_await sched.cycles(10);
+}
+
+// LSB-first, 113 bytes per image like the harness's pack_image_bytes
+tb::Task spi_send_image(const std::string &flat)
+{
+    for (size_t i = 0; i < flat.size(); i += 8)
+    {
+        uint8_t b = 0;
+        for (size_t bit = 0; bit < 8 && i + bit < flat.size(); ++bit)
+            if (flat[i + bit] == '1')
+                b |= 1 << bit;
+        co_await spi_send_byte(b);
+    }
+}
+
+tb::Task spi_master(std::vector<Image> images)
+{
+    bnn::Weights weights = bnn::load_weights(source_path("src/fpga/bnn_module/bnn_top.sv"));
+
+    co_await sched.until([] { return dut->rst_n_pin; });
+    co_await sched.cycles(4);
+
+    for (const Image &img : images)
+    {
+        co_await spi_send_byte(CMD_CLEAR);
+        co_await sched.until([] { return status() == STATUS_IDLE; });
+        co_await spi_send_byte(CMD_IMG_SEND_REQUEST);
+        co_await sched.until([] { return status() == STATUS_RX_IMG_RDY; });
+
+        expected.put({img.name, bnn::classify(weights, img.flat)});
+        co_await spi_send_image(img.flat);
+        co_await checked.get();
+    }
+}
+
+// One observed digit per RESULT_RDY, read once the display has caught up
+tb::Task result_monitor()
+{
+    for (;;)
+    {
+        co_await sched.until([] { return status() == STATUS_RESULT_RDY; });
+        co_await sched.cycles(4);
+        observed.put(seg_digit(dut->seg));
+        co_await sched.until([] { return status() != STATUS_RESULT_RDY; });
+    }
+}
+
+tb::Task scoreboard(size_t count)
+{
+    int mismatches = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        Expected exp = co_await expected.get();
+        int got = co_await observed.get();
+        bool ok = got == exp.digit;
+        mismatches += !ok;
+        std::cout << (ok ? "✅ " : "❌ ") << "[C++][" << sched.cycle() << "] " << exp.name << ": display "
+                  << got << ", model " << exp.digit << "\n";
+        checked.put(ok);
+    }
+
+    std::cout << "[C++] " << count - mismatches << "/" << count << " results match the model in "
+              << sched.cycle() << " cycles\n";
+    exit_code = mismatches ? EXIT_FAILURE : EXIT_SUCCESS;
+    finished = true;
+}
+
+tb::Task watchdog()
+{
+    co_await sched.cycles(TIMEOUT_CYCLES);
+    std::cerr << "❌ [C++] Timed out after " << TIMEOUT_CYCLES << " cycles, status "
+              << status() << "\n";
+    exit_code = EXIT_FAILURE;
+    finished = true;
+}
+
+void start_agents()
+{
+    std::vector<Image> images = {
+        {"digit_0", bnn::flatten(digit_0)}, {"digit_1", bnn::flatten(digit_1)},
+        {"digit_2", bnn::flatten(digit_2)}, {"digit_3", bnn::flatten(digit_3)},
+        {"digit_4", bnn::flatten(digit_4)}, {"digit_5", bnn::flatten(digit_5)},
+        {"digit_6", bnn::flatten(digit_6)}, {"digit_8", bnn::flatten(digit_8)},
+        {"digit_9", bnn::flatten(digit_9)},
+        {"digit_3 again", bnn::flatten(digit_3)}, // result cache hit
+    };
+
+    dut->spi_cs_n = 1;
+    dut->SCLK = 0;
+    dut->COPI = 0;
+
+    size_t count = images.size();
+    sched.spawn(spi_master(std::move(images)));
+    sched.spawn(result_monitor());
+    sched.spawn(scoreboard(count));
+    sched.spawn(watchdog());
+}
+} // namespace
+
+bool tb_finished() { return finished; }
+int tb_exit_code() { return exit_code; }
+
+extern "C" void c_external(const svBit is_posedge)
+{
+    assert(::dut && "dut not set!");
+
+    static bool started = false;
+    if (!started)
+    {
+        start_agents();
+        started = true;
     }
 
-    // Must propagate our SPI pin changes *immediately*
-    dut->eval();
+    if (is_posedge && !finished)
+        sched.tick();
 }
@@ -3,3 +3,7 @@
 #include "Vtb.h"
 class Vtb;
 extern Vtb *dut; // our shared handle
+
+// Set by the scoreboard / watchdog agents in external.cpp
+bool tb_finished();
+int tb_exit_code();
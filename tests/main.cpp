@@ -18,7 +18,7 @@ int main(int argc, char **argv)
     dut->rst_n_pin = 1;
     dut->eval();
 
-    while (!ctx->gotFinish())
+    while (!ctx->gotFinish() && !tb_finished())
     {
         ctx->timeInc(1);
         dut->eval();
@@ -27,5 +27,5 @@ int main(int argc, char **argv)
     delete dut;
     delete ctx;
 
-    return 0;
+    return tb_exit_code();
 }
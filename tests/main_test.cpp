@@ -37,6 +37,20 @@ int main(int argc, char **argv)
     test_bnn_inference(dut);
     test_image_buffer_module(dut);
     test_image_buffer(dut);
+    test_compressed_upload(dut);
+    test_delta_update(dut);
+    test_result_cache(dut);
+    test_reference_model(dut);
+    test_strip_mode(dut);
+    test_multi_core(dut);
+    test_spi_replay(dut);
+    test_bnn_taps(dut);
+    test_debug_log(dut);
+    test_spi_rate(dut);
+    test_quad_upload(dut);
+    test_weight_upload(dut);
+    test_result_latency(dut);
+    test_gray_ingest(dut);
 
     // Reset VERBOSE if needed
     VERBOSE = 0;
@@ -3,6 +3,8 @@
 #include "Vsystem_controller.h"
 #include "verilated.h"
 #include "verilated_vcd_c.h"
+#include "debug_log.hpp"
+#include "source_path.hpp"
 
 #include <memory>
 #include <vector>
@@ -17,6 +19,13 @@ extern vluint64_t sclk_ticks;
 // SPI Commands
 constexpr uint8_t CMD_IMG_SEND_REQUEST = 0xFE; // 11111110
 constexpr uint8_t CMD_CLEAR = 0xFD;            // 11111101
+constexpr uint8_t CMD_IMG_SEND_RLE = 0xFC;     // 11111100
+constexpr uint8_t CMD_IMG_WRITE_AT = 0xFB;     // 11111011, then address and data bytes
+constexpr uint8_t CMD_RERUN = 0xFA;            // 11111010
+constexpr uint8_t CMD_IMG_SEND_STRIP = 0xF9;   // 11111001, then four 30x30 tiles
+constexpr uint8_t CMD_IMG_SEND_QUAD = 0xF8;    // 11111000, then 113 bytes on four data lanes
+constexpr uint8_t CMD_LOAD_WEIGHTS = 0xF7;     // 11110111, then the weight image and its CRC-32
+constexpr uint8_t CMD_IMG_SEND_GRAY = 0xF6;    // 11110110, then mode, threshold and 30x30 grayscale pixels
 
 // Status Codes
 constexpr uint8_t STATUS_IDLE = 0;       // FPGA idle, ready
@@ -37,18 +46,114 @@ extern int VERBOSE;
 void test_spi(Vsystem_controller *dut);
 void test_fsm(Vsystem_controller *dut);
 void test_image_buffer(Vsystem_controller *dut);
+void test_compressed_upload(Vsystem_controller *dut);
+void test_delta_update(Vsystem_controller *dut);
+void test_result_cache(Vsystem_controller *dut);
+void test_reference_model(Vsystem_controller *dut);
+void test_strip_mode(Vsystem_controller *dut);
+void test_multi_core(Vsystem_controller *dut);
+void test_spi_replay(Vsystem_controller *dut);
+void test_bnn_taps(Vsystem_controller *dut);
+void test_debug_log(Vsystem_controller *dut);
+void test_spi_rate(Vsystem_controller *dut);
+void test_quad_upload(Vsystem_controller *dut);
+void test_weight_upload(Vsystem_controller *dut);
+void test_result_latency(Vsystem_controller *dut);
+void test_gray_ingest(Vsystem_controller *dut);
 
 // Helpers
-void tick_main_clk(Vsystem_controller *dut, int cycles);
+void tick_main_clk(Vsystem_controller *dut, int cycles); // cycles * 50 clk posedges
+void tick_clk_cycles(Vsystem_controller *dut, int posedges);
 void sclk_rise(Vsystem_controller *dut);
 void sclk_fall(Vsystem_controller *dut);
 void check_fsm_state(Vsystem_controller *dut, int expected_state, const std::string &state_name);
 void spi_send_bytes(Vsystem_controller *dut, const std::vector<uint8_t> &bytes);
 void spi_send_byte(Vsystem_controller *dut, const uint8_t byte_val);
+void spi_send_byte_quad(Vsystem_controller *dut, uint8_t byte_val);
+void spi_send_burst(Vsystem_controller *dut, const std::vector<uint8_t> &bytes, int half); // CS low throughout
 
 void do_reset(Vsystem_controller *dut);
 void debug(Vsystem_controller *dut);
 
+// Image helpers (test_image_buffer.cpp)
+std::string read_seg(Vsystem_controller *dut, int max_cycles = 500);
+std::string flatten_pattern(const std::vector<std::string> &pattern);
+void clear_buffer_and_wait(Vsystem_controller *dut);
+void send_image_request_and_wait(Vsystem_controller *dut);
+std::vector<uint8_t> pack_image_bytes(const std::string &flat);
+void stream_image_bits(Vsystem_controller *dut, const std::string &flat);
+std::string wait_for_result(Vsystem_controller *dut);
+std::string wait_for_result_timed(Vsystem_controller *dut, vluint64_t &bnn_cycles);
+std::string decode_seg(uint8_t seg);
+
+// Strip helpers (test_strip_mode.cpp)
+std::vector<std::string> make_strip(const std::vector<std::vector<std::string>> &digits);
+std::vector<std::string> split_strip(const std::vector<std::string> &strip);
+std::string send_strip(Vsystem_controller *dut, const std::vector<std::string> &tiles,
+                       vluint64_t *drain_cycles = nullptr);
+
+// SPI pin record/replay (spi_trace.cpp)
+struct SpiReplayStats
+{
+    uint64_t cycles = 0;         // main clock posedges driven
+    uint64_t skipped_cycles = 0; // idle cycles cut by max_gap
+    uint64_t pin_changes = 0;
+    int checkpoints = 0;
+    int mismatches = 0;
+};
+
+extern bool spi_trace_recording;
+void spi_trace_start(const std::string &path);
+void spi_trace_sample(Vsystem_controller *dut);
+void spi_trace_checkpoint(Vsystem_controller *dut);
+size_t spi_trace_stop();
+SpiReplayStats spi_replay(Vsystem_controller *dut, const std::string &path, uint64_t max_gap = 0);
+
+// Binary debug event log (debug_log.cpp); decode with debug_decode
+void debug_log_clear();
+size_t debug_log_size();
+size_t debug_log_save(const std::string &path);
+std::vector<debug_log::Record> debug_log_records(); // oldest first
+
+// Per-layer bnn_top taps (bnn_taps.cpp, RTL built with BNN_TAPS)
+constexpr int BNN_TAP_POOL1_BITS = 16 * 14 * 14;
+constexpr int BNN_TAP_FC_IN_BITS = 16 * 6 * 6;
+constexpr int BNN_TAP_FC_OUT = 10;
+
+#pragma pack(push, 1)
+struct BnnTapHeader
+{
+    char magic[4]; // "BNNT"
+    uint32_t version;
+    uint32_t record_size;
+};
+
+// One inference; tensors are bit-packed LSB first in bnn_top's order
+struct BnnTapRecord
+{
+    uint32_t seq;    // order the results came out
+    uint32_t tag;    // bnn_taps_set_tag() value at the time
+    uint8_t core;    // bnn_top replica
+    uint8_t result;  // Comparator output
+    uint16_t reserved;
+    int16_t fc_out[BNN_TAP_FC_OUT];
+    uint8_t pool1[BNN_TAP_POOL1_BITS / 8];
+    uint8_t fc_in[BNN_TAP_FC_IN_BITS / 8];
+};
+
+struct BnnTapFooter
+{
+    uint64_t index_offset;
+    uint32_t count;
+    char magic[4]; // "BNNI"
+};
+#pragma pack(pop)
+
+void bnn_taps_open(const std::string &path);
+void bnn_taps_set_tag(uint32_t tag);
+size_t bnn_taps_close();
+std::vector<BnnTapRecord> bnn_taps_read(const std::string &path);
+
 class DUT
 {
 public:
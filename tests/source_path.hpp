@@ -0,0 +1,13 @@
+#pragma once
+
+// The C++ model reads its weights from the RTL sources. The CMake targets
+// point BNN_SOURCE_DIR at the checkout; otherwise run from the repo root.
+
+#include <cstdlib>
+#include <string>
+
+inline std::string source_path(const std::string &rel)
+{
+    const char *dir = std::getenv("BNN_SOURCE_DIR");
+    return std::string(dir ? dir : ".") + "/" + rel;
+}
@@ -0,0 +1,218 @@
+#include "main_test.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Log layout: "SPIR" + version byte, then one record per pin change:
+//   LEB128 delta   main clock posedges since the previous record
+//   flags byte     PIN_* bits, REC_LANES / REC_CHECKPOINT / REC_END
+//   [lanes]        only with REC_LANES: copi_quad[3:1] in bits 0-2, zero
+//                  when the byte is absent
+//   [status, seg]  only on checkpoints
+// A record applies before the posedge it lands on, which is where the
+// harness changes pins (between tick_main_clk calls, with clk low).
+
+namespace
+{
+constexpr char SPI_TRACE_MAGIC[4] = {'S', 'P', 'I', 'R'};
+constexpr uint8_t SPI_TRACE_VERSION = 2;
+
+constexpr uint8_t PIN_SCLK = 1 << 0;
+constexpr uint8_t PIN_COPI = 1 << 1;
+constexpr uint8_t PIN_CS_N = 1 << 2;
+constexpr uint8_t PIN_RST_N = 1 << 3;
+constexpr uint8_t PIN_DEBUG = 1 << 4;
+constexpr uint8_t REC_LANES = 1 << 5;
+constexpr uint8_t REC_END = 1 << 6;
+constexpr uint8_t REC_CHECKPOINT = 1 << 7;
+
+struct Recorder
+{
+    std::string path;
+    std::vector<uint8_t> log;
+    uint64_t cycle = 0;
+    uint64_t last_cycle = 0;
+    uint16_t last_pins = 0; // PIN_* bits, copi_quad in bits 8-10
+    bool first = true;
+};
+
+Recorder recorder;
+
+uint16_t sample_pins(const Vsystem_controller *dut)
+{
+    return (dut->SCLK ? PIN_SCLK : 0) | (dut->COPI ? PIN_COPI : 0) | (dut->spi_cs_n ? PIN_CS_N : 0) |
+           (dut->rst_n_pin ? PIN_RST_N : 0) | (dut->debug_trigger ? PIN_DEBUG : 0) |
+           ((dut->copi_quad & 0x7) << 8);
+}
+
+void put_record(uint16_t pins, uint8_t rec = 0)
+{
+    uint64_t delta = recorder.cycle - recorder.last_cycle;
+    do
+    {
+        uint8_t b = delta & 0x7F;
+        delta >>= 7;
+        recorder.log.push_back(b | (delta ? 0x80 : 0));
+    } while (delta);
+    uint8_t lanes = pins >> 8;
+    recorder.log.push_back(static_cast<uint8_t>(pins) | rec | (lanes ? REC_LANES : 0));
+    if (lanes)
+        recorder.log.push_back(lanes);
+    recorder.last_cycle = recorder.cycle;
+}
+
+// One posedge with the pins as they are, same toggling as tick_main_clk
+inline void replay_posedge(Vsystem_controller *dut)
+{
+    dut->clk = 1;
+    dut->eval();
+    dut->clk = 0;
+    dut->eval();
+    main_clk_ticks++;
+}
+} // namespace
+
+bool spi_trace_recording = false;
+
+void spi_trace_start(const std::string &path)
+{
+    recorder = Recorder{};
+    recorder.path = path;
+    recorder.log.insert(recorder.log.end(), SPI_TRACE_MAGIC, SPI_TRACE_MAGIC + 4);
+    recorder.log.push_back(SPI_TRACE_VERSION);
+    spi_trace_recording = true;
+}
+
+void spi_trace_sample(Vsystem_controller *dut)
+{
+    uint16_t pins = sample_pins(dut);
+    if (recorder.first || pins != recorder.last_pins)
+    {
+        put_record(pins);
+        recorder.last_pins = pins;
+        recorder.first = false;
+    }
+    recorder.cycle++;
+}
+
+void spi_trace_checkpoint(Vsystem_controller *dut)
+{
+    if (!spi_trace_recording)
+        return;
+    put_record(recorder.last_pins, REC_CHECKPOINT);
+    recorder.log.push_back(dut->status_code_reg);
+    recorder.log.push_back(dut->seg);
+}
+
+size_t spi_trace_stop()
+{
+    if (!spi_trace_recording)
+        return 0;
+    put_record(recorder.last_pins, REC_END);
+    spi_trace_recording = false;
+
+    std::ofstream out(recorder.path, std::ios::binary);
+    if (!out)
+        throw std::runtime_error("spi_trace_stop: cannot write " + recorder.path);
+    out.write(reinterpret_cast<const char *>(recorder.log.data()), recorder.log.size());
+    return recorder.log.size();
+}
+
+SpiReplayStats spi_replay(Vsystem_controller *dut, const std::string &path, uint64_t max_gap)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("spi_replay: cannot open " + path);
+    struct stat st;
+    fstat(fd, &st);
+    size_t size = st.st_size;
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        throw std::runtime_error("spi_replay: cannot map " + path);
+
+    const uint8_t *p = static_cast<const uint8_t *>(map);
+    const uint8_t *end = p + size;
+    if (size < 5 || std::memcmp(p, SPI_TRACE_MAGIC, 4) != 0 || p[4] != SPI_TRACE_VERSION)
+    {
+        munmap(map, size);
+        throw std::runtime_error("spi_replay: " + path + " is not an SPI trace");
+    }
+    p += 5;
+
+    SpiReplayStats stats;
+    dut->clk = 0;
+    while (p < end)
+    {
+        uint64_t delta = 0;
+        for (int shift = 0; p < end; shift += 7)
+        {
+            uint8_t b = *p++;
+            delta |= uint64_t(b & 0x7F) << shift;
+            if (!(b & 0x80))
+                break;
+        }
+        if (p >= end)
+            break;
+        uint8_t flags = *p++;
+        uint8_t lanes = 0;
+        if (flags & REC_LANES)
+        {
+            if (p >= end)
+                break;
+            lanes = *p++;
+        }
+
+        // Idle stretches longer than max_gap are cut down to max_gap
+        if (max_gap && delta > max_gap)
+        {
+            stats.skipped_cycles += delta - max_gap;
+            delta = max_gap;
+        }
+        for (uint64_t i = 0; i < delta; ++i)
+            replay_posedge(dut);
+        stats.cycles += delta;
+
+        if (flags & REC_END)
+            break;
+
+        if (flags & REC_CHECKPOINT)
+        {
+            if (end - p < 2)
+                break;
+            uint8_t status = *p++;
+            uint8_t seg = *p++;
+            stats.checkpoints++;
+            if (dut->status_code_reg != status || dut->seg != seg)
+            {
+                std::cerr << "❌ Replay checkpoint " << stats.checkpoints << " at cycle " << stats.cycles
+                          << ": status " << (int)dut->status_code_reg << " seg " << (int)dut->seg
+                          << ", recorded status " << (int)status << " seg " << (int)seg << "\n";
+                stats.mismatches++;
+            }
+            continue;
+        }
+
+        dut->SCLK = (flags & PIN_SCLK) != 0;
+        dut->COPI = (flags & PIN_COPI) != 0;
+        dut->copi_quad = lanes & 0x7;
+        dut->spi_cs_n = (flags & PIN_CS_N) != 0;
+        dut->rst_n_pin = (flags & PIN_RST_N) != 0;
+        dut->debug_trigger = (flags & PIN_DEBUG) != 0;
+        dut->eval();
+        stats.pin_changes++;
+    }
+
+    munmap(map, size);
+    return stats;
+}
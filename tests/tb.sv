@@ -8,9 +8,11 @@ module tb (
     input  logic       rst_n_pin,
     input  logic       SCLK,
     input  logic       COPI,
+    input  logic [3:1] copi_quad,
     input  logic       spi_cs_n,
     output logic [3:0] status_code_reg,
     output logic [6:0] seg,
+    output logic [3:0] an,
     output logic       decimalPoint,
     output logic       heartbeat,
     input  logic       debugTrigger
@@ -35,9 +37,11 @@ module tb (
       .rst_n_pin      (rst_n_pin),
       .SCLK           (SCLK),
       .COPI           (COPI),
+      .copi_quad      (copi_quad),
       .spi_cs_n       (spi_cs_n),
       .status_code_reg(status_code_reg),
       .seg            (seg),
+      .an             (an),
       .decimalPoint   (decimalPoint),
       .heartbeat      (heartbeat),
       .debug_trigger  (debugTrigger)
@@ -0,0 +1,224 @@
+#pragma once
+
+// Cooperative scheduler for the tb.sv / DPI flow (external.cpp).
+//
+// Testbench agents are C++20 coroutines returning tb::Task. They suspend on
+//   co_await sched.cycles(n)        - n main clock posedges
+//   co_await sched.until(pred)      - first posedge where pred() holds
+//   co_await mailbox.get()          - next item put by another agent
+//   co_await sub_task(...)          - another Task, run to completion
+// and c_external calls sched.tick() on every posedge. A tick resumes only the
+// agents that are due; agents parked on a far-off cycle or a mailbox cost
+// nothing until then.
+
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace tb
+{
+
+class Task
+{
+  public:
+    struct promise_type;
+    using handle = std::coroutine_handle<promise_type>;
+
+    struct promise_type
+    {
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+        std::exception_ptr error;
+
+        Task get_return_object() { return Task(handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        // Hand control back to whoever co_awaited us (the scheduler for
+        // spawned agents)
+        auto final_suspend() noexcept
+        {
+            struct Resume
+            {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(handle h) noexcept { return h.promise().continuation; }
+                void await_resume() noexcept {}
+            };
+            return Resume{};
+        }
+
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    Task(Task &&other) noexcept : h_(std::exchange(other.h_, {})) {}
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+    ~Task()
+    {
+        if (h_)
+            h_.destroy();
+    }
+
+    bool done() const { return !h_ || h_.done(); }
+    handle get() const { return h_; }
+
+    // Awaiting a Task runs it as a sub-routine of the caller
+    bool await_ready() const noexcept { return done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+    {
+        h_.promise().continuation = caller;
+        return h_;
+    }
+    void await_resume() const
+    {
+        if (h_ && h_.promise().error)
+            std::rethrow_exception(h_.promise().error);
+    }
+
+  private:
+    explicit Task(handle h) : h_(h) {}
+    handle h_;
+};
+
+class Scheduler
+{
+  public:
+    // Agents start on the next tick
+    void spawn(Task task)
+    {
+        ready_.push_back(task.get());
+        agents_.push_back(std::move(task));
+    }
+
+    // One main clock posedge
+    void tick()
+    {
+        ++cycle_;
+
+        while (!timed_.empty() && timed_.top().cycle <= cycle_)
+        {
+            ready_.push_back(timed_.top().h);
+            timed_.pop();
+        }
+
+        for (size_t i = 0; i < waiting_.size();)
+        {
+            if (waiting_[i].pred())
+            {
+                ready_.push_back(waiting_[i].h);
+                waiting_[i] = std::move(waiting_.back());
+                waiting_.pop_back();
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        // Mailbox puts made while running append here and run this tick
+        while (!ready_.empty())
+        {
+            std::coroutine_handle<> h = ready_.front();
+            ready_.pop_front();
+            h.resume();
+        }
+
+        for (const Task &agent : agents_)
+            agent.await_resume(); // rethrow an agent's uncaught exception
+    }
+
+    uint64_t cycle() const { return cycle_; }
+
+    // Resume `h` within the current (or next) tick
+    void wake(std::coroutine_handle<> h) { ready_.push_back(h); }
+
+    auto cycles(uint64_t n)
+    {
+        struct Awaiter
+        {
+            Scheduler &s;
+            uint64_t n;
+            bool await_ready() const noexcept { return n == 0; }
+            void await_suspend(std::coroutine_handle<> h) { s.timed_.push({s.cycle_ + n, s.seq_++, h}); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this, n};
+    }
+
+    auto until(std::function<bool()> pred)
+    {
+        struct Awaiter
+        {
+            Scheduler &s;
+            std::function<bool()> pred;
+            bool await_ready() const { return pred(); }
+            void await_suspend(std::coroutine_handle<> h) { s.waiting_.push_back({std::move(pred), h}); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this, std::move(pred)};
+    }
+
+  private:
+    struct Timed
+    {
+        uint64_t cycle;
+        uint64_t seq; // FIFO order among agents due on the same cycle
+        std::coroutine_handle<> h;
+        bool operator>(const Timed &o) const { return cycle != o.cycle ? cycle > o.cycle : seq > o.seq; }
+    };
+
+    struct Waiting
+    {
+        std::function<bool()> pred;
+        std::coroutine_handle<> h;
+    };
+
+    uint64_t cycle_ = 0;
+    uint64_t seq_ = 0;
+    std::vector<Task> agents_;
+    std::deque<std::coroutine_handle<>> ready_;
+    std::priority_queue<Timed, std::vector<Timed>, std::greater<Timed>> timed_;
+    std::vector<Waiting> waiting_;
+};
+
+// Single-consumer queue between agents
+template <typename T> class Mailbox
+{
+  public:
+    explicit Mailbox(Scheduler &sched) : sched_(sched) {}
+
+    void put(T item)
+    {
+        items_.push_back(std::move(item));
+        if (waiter_)
+            sched_.wake(std::exchange(waiter_, {}));
+    }
+
+    auto get()
+    {
+        struct Awaiter
+        {
+            Mailbox &mb;
+            bool await_ready() const noexcept { return !mb.items_.empty(); }
+            void await_suspend(std::coroutine_handle<> h) noexcept { mb.waiter_ = h; }
+            T await_resume()
+            {
+                T item = std::move(mb.items_.front());
+                mb.items_.pop_front();
+                return item;
+            }
+        };
+        return Awaiter{*this};
+    }
+
+  private:
+    Scheduler &sched_;
+    std::deque<T> items_;
+    std::coroutine_handle<> waiter_;
+};
+
+} // namespace tb
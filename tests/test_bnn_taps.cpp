@@ -0,0 +1,89 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include "bnn_model.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+
+#ifdef BNN_TAPS
+static const std::string BNN_TAP_FILE = "bnn_taps.bin";
+
+static bool bits_match(const uint8_t *packed, const std::vector<uint8_t> &bits)
+{
+    for (size_t i = 0; i < bits.size(); ++i)
+        if (((packed[i / 8] >> (i % 8)) & 1) != bits[i])
+            return false;
+    return true;
+}
+#endif
+
+void test_bnn_taps(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] Per-layer activation taps\n";
+
+#ifndef BNN_TAPS
+    (void)dut;
+    std::cout << "[TAPS] Skipped, the simulation was built without BNN_TAPS\n";
+#else
+    bnn::Weights weights = bnn::load_weights(source_path("src/fpga/bnn_module/bnn_top.sv"));
+
+    std::vector<std::vector<std::string>> all_digits = {
+        digit_0, digit_1, digit_2, digit_3,
+        digit_4, digit_5, digit_6, digit_8, digit_9};
+    std::vector<int> labels = {0, 1, 2, 3, 4, 5, 6, 8, 9};
+
+    // Empty result cache, so every image goes through the BNN
+    do_reset(dut);
+    bnn_taps_open(BNN_TAP_FILE);
+    for (size_t idx = 0; idx < all_digits.size(); ++idx)
+    {
+        bnn_taps_set_tag(labels[idx]);
+        clear_buffer_and_wait(dut);
+        send_image_request_and_wait(dut);
+        stream_image_bits(dut, flatten_pattern(all_digits[idx]));
+        wait_for_result(dut);
+    }
+    size_t count = bnn_taps_close();
+    assert(count == all_digits.size());
+
+    // Every stage must match the C++ model bit for bit
+    std::vector<BnnTapRecord> recs = bnn_taps_read(BNN_TAP_FILE);
+    for (size_t idx = 0; idx < recs.size(); ++idx)
+    {
+        const BnnTapRecord &rec = recs[idx];
+        std::string flat = flatten_pattern(all_digits[idx]);
+        assert(rec.tag == static_cast<uint32_t>(labels[idx]));
+
+        auto fc_in = bnn::features(weights, flat);
+#ifdef FC_BINARY
+        auto fc_out = bnn::fc_binary(bnn::load_binary_fc(source_path("src/fpga/bnn_module/fc_binary_weights.svh")), fc_in);
+#elif defined(FC_EARLY_EXIT)
+        // Classes cut short report their bound; the result is fc_q88's
+        auto fc_out = bnn::fc_q88_early_exit(weights, bnn::fc_bounds(weights), fc_in);
+        assert(bnn::argmax(fc_out) == bnn::argmax(bnn::fc_q88(weights, fc_in)));
+#else
+        auto fc_out = bnn::fc_q88(weights, fc_in);
+#endif
+        bool pool1_ok = bits_match(rec.pool1, bnn::pool1(weights, flat));
+        bool fc_in_ok = bits_match(rec.fc_in, fc_in);
+        bool fc_out_ok = std::equal(fc_out.begin(), fc_out.end(), rec.fc_out);
+        bool result_ok = rec.result == bnn::argmax(fc_out);
+
+        std::cout << "[TAPS] Digit " << rec.tag << " (core " << (int)rec.core << "): pool1 "
+                  << (pool1_ok ? "ok" : "DIFF") << ", fc_in " << (fc_in_ok ? "ok" : "DIFF") << ", fc_out "
+                  << (fc_out_ok ? "ok" : "DIFF") << ", result " << (int)rec.result << "\n";
+        if (!(pool1_ok && fc_in_ok && fc_out_ok && result_ok))
+        {
+            std::cerr << "❌ Tapped tensors differ from the model for digit " << rec.tag << "\n";
+            assert(false);
+        }
+    }
+    std::cout << "✅ [PASS] " << recs.size() << " records in " << BNN_TAP_FILE
+              << ", every layer matches the model\n";
+#endif
+
+    std::cout << "[TEST COMPLETE] BNN taps\n";
+}
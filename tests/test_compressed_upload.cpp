@@ -0,0 +1,147 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+#include <iomanip>
+#include <vector>
+
+constexpr size_t IMG_STREAM_BITS = 904; // 900 pixels + 4 pad bits (113 bytes)
+
+// Run-length encode a flattened 30x30 image for CMD_IMG_SEND_RLE.
+// Runs alternate starting with 0s; each run is a sequence of 4-bit tokens,
+// 15 = "15 bits, run continues", 0..14 = "n bits, then toggle". Tokens are
+// packed low nibble first.
+std::vector<uint8_t> rle_encode(const std::string &flat)
+{
+    std::string bits = flat;
+    bits.resize(IMG_STREAM_BITS, '0');
+
+    std::vector<uint8_t> nibbles;
+    char cur = '0';
+    size_t run = 0;
+    auto flush_run = [&](size_t len)
+    {
+        while (len >= 15)
+        {
+            nibbles.push_back(15);
+            len -= 15;
+        }
+        nibbles.push_back(static_cast<uint8_t>(len));
+    };
+
+    for (char b : bits)
+    {
+        if (b == cur)
+        {
+            run++;
+        }
+        else
+        {
+            flush_run(run);
+            cur = b;
+            run = 1;
+        }
+    }
+    flush_run(run);
+
+    std::vector<uint8_t> payload;
+    for (size_t i = 0; i < nibbles.size(); i += 2)
+    {
+        uint8_t lo = nibbles[i];
+        uint8_t hi = (i + 1 < nibbles.size()) ? nibbles[i + 1] : 0;
+        payload.push_back(static_cast<uint8_t>(lo | (hi << 4)));
+    }
+    return payload;
+}
+
+// Software model of rle_decoder.sv, used to check the encoder round-trips
+std::string rle_decode(const std::vector<uint8_t> &payload)
+{
+    std::string bits;
+    char val = '0';
+    for (uint8_t byte : payload)
+    {
+        for (int n = 0; n < 2 && bits.size() < IMG_STREAM_BITS; ++n)
+        {
+            uint8_t token = n ? (byte >> 4) : (byte & 0xF);
+            for (int i = 0; i < token && bits.size() < IMG_STREAM_BITS; ++i)
+                bits += val;
+            if (token != 15)
+                val = (val == '0') ? '1' : '0';
+        }
+    }
+    return bits.substr(0, 900);
+}
+
+void test_compressed_upload(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] Compressed (RLE) image upload\n";
+
+    std::vector<std::vector<std::string>> all_digits = {
+        digit_0, digit_1, digit_2, digit_3,
+        digit_4, digit_5, digit_6, digit_8, digit_9};
+
+    size_t total_raw_bytes = 0, total_rle_bytes = 0;
+    vluint64_t total_raw_cycles = 0, total_rle_cycles = 0;
+
+    for (size_t idx = 0; idx < all_digits.size(); ++idx)
+    {
+        std::string flat = flatten_pattern(all_digits[idx]);
+        std::vector<uint8_t> payload = rle_encode(flat);
+        assert(rle_decode(payload) == flat);
+
+        // Raw upload
+        clear_buffer_and_wait(dut);
+        vluint64_t start = main_clk_ticks;
+        send_image_request_and_wait(dut);
+        stream_image_bits(dut, flat);
+        vluint64_t raw_cycles = main_clk_ticks - start;
+        std::string raw_seg = wait_for_result(dut);
+
+        // Compressed upload
+        clear_buffer_and_wait(dut);
+        start = main_clk_ticks;
+        spi_send_byte(dut, CMD_IMG_SEND_RLE);
+        for (uint8_t b : payload)
+        {
+            spi_send_byte(dut, b);
+            tick_main_clk(dut, 2);
+        }
+        for (int i = 0; i < 20 && dut->status_code_reg != STATUS_BNN_BUSY &&
+                        dut->status_code_reg != STATUS_RESULT_RDY;
+             ++i)
+            tick_main_clk(dut, 1);
+        vluint64_t rle_cycles = main_clk_ticks - start;
+        std::string rle_seg = wait_for_result(dut);
+
+        size_t raw_bytes = 1 + 113;
+        size_t rle_bytes = 1 + payload.size();
+        total_raw_bytes += raw_bytes;
+        total_rle_bytes += rle_bytes;
+        total_raw_cycles += raw_cycles;
+        total_rle_cycles += rle_cycles;
+
+        std::cout << "[RLE] Digit " << idx << ": " << raw_bytes << " -> " << rle_bytes
+                  << " bytes, upload " << raw_cycles << " -> " << rle_cycles << " cycles\n";
+
+        if (rle_seg != raw_seg)
+        {
+            std::cerr << "❌ Compressed upload of digit " << idx << " displayed " << rle_seg
+                      << ", raw upload displayed " << raw_seg << "\n";
+            assert(rle_seg == raw_seg);
+        }
+        std::cout << "✅ [PASS] Compressed digit " << idx << " matches raw result " << rle_seg << "\n";
+    }
+
+    double saved = 100.0 * (1.0 - (double)total_rle_bytes / total_raw_bytes);
+    double speedup = (double)total_raw_cycles / total_rle_cycles;
+    std::cout << "[RLE] Total bytes: " << total_raw_bytes << " raw, " << total_rle_bytes
+              << " compressed (" << std::fixed << std::setprecision(1) << saved << "% saved)\n";
+    std::cout << "[RLE] Upload latency: " << total_raw_cycles << " raw, " << total_rle_cycles
+              << " compressed cycles (" << std::setprecision(2) << speedup << "x)\n";
+    std::cout << std::defaultfloat;
+
+    std::cout << "[TEST COMPLETE] Compressed image upload\n";
+}
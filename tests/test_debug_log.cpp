@@ -0,0 +1,110 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include "debug_log.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+
+static const std::string DEBUG_LOG_FILE = "debug_log.bin";
+
+// Upload one digit and wait for the result; returns the wall time in seconds
+static double timed_upload(Vsystem_controller *dut, const std::string &flat)
+{
+    auto start = std::chrono::steady_clock::now();
+    clear_buffer_and_wait(dut);
+    send_image_request_and_wait(dut);
+    stream_image_bits(dut, flat);
+    wait_for_result(dut);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void test_debug_log(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] Binary debug event log\n";
+
+    std::string flat = flatten_pattern(digit_4);
+
+    // Empty result cache, so both uploads run the BNN. Without
+    // debug_trigger nothing is logged, bnn_top's job events included.
+    do_reset(dut);
+    debug_log_clear();
+    double plain_s = timed_upload(dut, flat);
+    if (debug_log_size() != 0)
+    {
+        std::cerr << "❌ " << debug_log_size() << " records logged with debug_trigger low\n";
+        assert(debug_log_size() == 0);
+    }
+
+    do_reset(dut);
+    debug_log_clear();
+    dut->debug_trigger = 1;
+    vluint64_t start_ticks = main_clk_ticks;
+    double debug_s = timed_upload(dut, flat);
+    vluint64_t debug_cycles = main_clk_ticks - start_ticks;
+    dut->debug_trigger = 0;
+    tick_main_clk(dut, 1);
+
+    size_t saved = debug_log_save(DEBUG_LOG_FILE);
+    std::vector<debug_log::Record> records = debug_log::read(DEBUG_LOG_FILE);
+    assert(records.size() == saved);
+
+    size_t signals = 0, bnn_starts = 0, last_image = records.size();
+    uint32_t first_cycle = UINT32_MAX, last_cycle = 0;
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        signals += records[i].type == debug_log::SIGNALS;
+        bnn_starts += records[i].type == debug_log::BNN_START;
+        if (records[i].type == debug_log::SIGNALS)
+        {
+            first_cycle = std::min(first_cycle, records[i].cycle);
+            last_cycle = std::max(last_cycle, records[i].cycle);
+        }
+        if (records[i].type == debug_log::IMAGE && records[i].aux == 0)
+            last_image = i;
+    }
+
+    // One snapshot per clock while debug_enable is high
+    if (signals < debug_cycles)
+    {
+        std::cerr << "❌ " << signals << " signal records for " << debug_cycles << " cycles\n";
+        assert(signals >= debug_cycles);
+    }
+    std::cout << "✅ [PASS] " << signals << " signal records for " << debug_cycles << " cycles\n";
+
+    assert(bnn_starts >= 1);
+
+    // bnn_top's events carry the main clock count like the snapshots
+    for (const auto &rec : records)
+        if ((rec.type == debug_log::BNN_START || rec.type == debug_log::BNN_DONE) &&
+            (rec.cycle < first_cycle || rec.cycle > last_cycle))
+        {
+            std::cerr << "❌ " << debug_log::format(rec) << " at main cycle " << rec.cycle << ", outside "
+                      << first_cycle << ".." << last_cycle << "\n";
+            assert(false);
+        }
+    std::cout << "✅ [PASS] BNN job events fall in the main clock range of the snapshots\n";
+
+    assert(last_image < records.size());
+    std::string logged;
+    for (const auto &row : debug_log::image_rows(records, last_image))
+        logged += row;
+    if (logged != flat)
+    {
+        std::cerr << "❌ Logged image differs from the uploaded digit\n";
+        assert(logged == flat);
+    }
+    std::cout << "✅ [PASS] Last logged image is the uploaded digit\n";
+    std::cout << "[DEBUG] Sample: " << debug_log::format(records[0]) << "\n";
+
+    std::cout << std::fixed << std::setprecision(3) << "[DEBUG] " << saved << " records ("
+              << saved * sizeof(debug_log::Record) << " bytes) in " << DEBUG_LOG_FILE << ", upload took "
+              << debug_s << " s with debug vs " << plain_s << " s without\n"
+              << std::defaultfloat;
+
+    std::cout << "[TEST COMPLETE] Debug log\n";
+}
@@ -0,0 +1,212 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include "bnn_model.hpp"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+#include <iomanip>
+#include <vector>
+#include <random>
+
+// Build a video-like sequence: each frame flips a few pixels of the previous one
+static std::vector<std::string> make_frame_sequence(const std::string &base, int frames, int flips)
+{
+    std::mt19937 frame_rng{42};
+    std::uniform_int_distribution<int> row_dist{3, 26};
+    std::uniform_int_distribution<int> col_dist{3, 26};
+
+    std::vector<std::string> seq = {base};
+    for (int f = 1; f < frames; ++f)
+    {
+        std::string next = seq.back();
+        for (int i = 0; i < flips; ++i)
+        {
+            int px = row_dist(frame_rng) * 30 + col_dist(frame_rng);
+            next[px] = (next[px] == '1') ? '0' : '1';
+        }
+        seq.push_back(next);
+    }
+    return seq;
+}
+
+#ifdef BNN_TAPS
+static const std::string DELTA_TAP_FILE = "delta_taps.bin";
+
+// FC scores the model gives for `flat` without any history; an incremental
+// run must land on exactly these
+static bool fc_out_matches(const bnn::Weights &weights, const std::string &flat, const int16_t *fc_out)
+{
+    auto fc_in = bnn::features(weights, flat);
+#ifdef FC_BINARY
+    auto expected = bnn::fc_binary(bnn::load_binary_fc(source_path("src/fpga/bnn_module/fc_binary_weights.svh")), fc_in);
+#else
+    auto expected = bnn::fc_q88(weights, fc_in);
+#endif
+    if (std::equal(expected.begin(), expected.end(), fc_out))
+        return true;
+#ifdef FC_EARLY_EXIT
+    // a full run may have stopped classes early and left their bounds
+    expected = bnn::fc_q88_early_exit(weights, bnn::fc_bounds(weights), fc_in);
+    return std::equal(expected.begin(), expected.end(), fc_out);
+#else
+    return false;
+#endif
+}
+#endif
+
+static std::string expected_seg(const bnn::Weights &weights, const std::string &flat)
+{
+#ifdef FC_BINARY
+    int cls = bnn::classify_binary(weights, bnn::load_binary_fc(source_path("src/fpga/bnn_module/fc_binary_weights.svh")),
+                                   flat);
+#else
+    int cls = bnn::classify(weights, flat);
+#endif
+    return (cls == bnn::BLANK_RESULT) ? "Blank/Unknown" : std::to_string(cls);
+}
+
+static void wait_for_result_ready(Vsystem_controller *dut)
+{
+    for (int i = 0; i < 20 && dut->status_code_reg != STATUS_RESULT_RDY; ++i)
+        tick_main_clk(dut, 1);
+    check_fsm_state(dut, STATUS_RESULT_RDY, "STATUS_RESULT_RDY");
+}
+
+// Send only the bytes that differ from the previous frame, then re-run
+static size_t send_delta(Vsystem_controller *dut, const std::string &prev, const std::string &next)
+{
+    std::vector<uint8_t> old_bytes = pack_image_bytes(prev);
+    std::vector<uint8_t> new_bytes = pack_image_bytes(next);
+
+    size_t sent = 0;
+    for (size_t addr = 0; addr < new_bytes.size(); ++addr)
+    {
+        if (old_bytes[addr] == new_bytes[addr])
+            continue;
+        spi_send_bytes(dut, {CMD_IMG_WRITE_AT, static_cast<uint8_t>(addr), new_bytes[addr]});
+        tick_main_clk(dut, 2);
+        sent += 3;
+    }
+
+    spi_send_byte(dut, CMD_RERUN);
+    tick_main_clk(dut, 5);
+    return sent + 1;
+}
+
+void test_delta_update(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] Delta image update + re-run\n";
+
+    bnn::Weights weights = bnn::load_weights(source_path("src/fpga/bnn_module/bnn_top.sv"));
+    std::vector<std::string> frames = make_frame_sequence(flatten_pattern(digit_3), 5, 3);
+
+    // Start with an empty result cache so every full upload below runs the BNN
+    do_reset(dut);
+#ifdef BNN_TAPS
+    bnn_taps_open(DELTA_TAP_FILE);
+#endif
+
+    // Full upload of the first frame
+    clear_buffer_and_wait(dut);
+    send_image_request_and_wait(dut);
+    stream_image_bits(dut, frames[0]);
+    std::string seg = wait_for_result(dut);
+    wait_for_result_ready(dut);
+    std::cout << "[DELTA] Frame 0 (full upload): " << seg << "\n";
+
+    std::vector<std::string> delta_segs = {seg};
+    size_t delta_bytes = 0;
+    vluint64_t delta_cycles = 0;
+    vluint64_t incremental_bnn_cycles = 0;
+
+    for (size_t f = 1; f < frames.size(); ++f)
+    {
+        vluint64_t start = main_clk_ticks;
+        vluint64_t bnn_cycles = 0;
+        size_t sent = send_delta(dut, frames[f - 1], frames[f]);
+        seg = wait_for_result_timed(dut, bnn_cycles);
+        wait_for_result_ready(dut);
+        vluint64_t cycles = main_clk_ticks - start;
+
+        delta_bytes += sent;
+        delta_cycles += cycles;
+        incremental_bnn_cycles += bnn_cycles;
+        delta_segs.push_back(seg);
+        std::cout << "[DELTA] Frame " << f << ": " << sent << " bytes, " << cycles
+                  << " cycles (BNN " << bnn_cycles << ", incremental) -> " << seg << "\n";
+    }
+
+    // The first re-run follows a full upload: the BNN must start from that
+    // upload's activations and sums, not from cleared ones
+    for (size_t f = 0; f < frames.size(); ++f)
+    {
+        std::string want = expected_seg(weights, frames[f]);
+        if (delta_segs[f] != want)
+        {
+            std::cerr << "❌ Frame " << f << " result " << delta_segs[f] << ", model says " << want << "\n";
+            assert(delta_segs[f] == want);
+        }
+    }
+#ifdef BNN_TAPS
+    size_t tapped = bnn_taps_close();
+    std::vector<BnnTapRecord> recs = bnn_taps_read(DELTA_TAP_FILE);
+    assert(tapped == frames.size() && recs.size() == frames.size());
+    for (size_t f = 0; f < recs.size(); ++f)
+    {
+        if (!fc_out_matches(weights, frames[f], recs[f].fc_out))
+        {
+            std::cerr << "❌ Frame " << f << " FC scores differ from the model\n";
+            assert(false);
+        }
+    }
+    std::cout << "✅ [PASS] FC scores of the full upload and every re-run match the model\n";
+#else
+    std::cout << "✅ [PASS] Full upload and every re-run match the model's class\n";
+#endif
+
+    // Same frames again, each as clear + full upload
+    size_t full_bytes = 0;
+    vluint64_t full_cycles = 0;
+    vluint64_t full_bnn_cycles = 0;
+
+    for (size_t f = 1; f < frames.size(); ++f)
+    {
+        vluint64_t start = main_clk_ticks;
+        vluint64_t bnn_cycles = 0;
+        clear_buffer_and_wait(dut);
+        send_image_request_and_wait(dut);
+        stream_image_bits(dut, frames[f]);
+        seg = wait_for_result_timed(dut, bnn_cycles);
+        wait_for_result_ready(dut);
+        vluint64_t cycles = main_clk_ticks - start;
+
+        full_bytes += 2 + 113;
+        full_cycles += cycles;
+        full_bnn_cycles += bnn_cycles;
+        std::cout << "[FULL] Frame " << f << ": " << 2 + 113 << " bytes, " << cycles
+                  << " cycles (BNN " << bnn_cycles << ", full recompute) -> " << seg << "\n";
+
+        if (seg != delta_segs[f])
+        {
+            std::cerr << "❌ Frame " << f << " delta result " << delta_segs[f]
+                      << " differs from full upload result " << seg << "\n";
+            assert(seg == delta_segs[f]);
+        }
+        std::cout << "✅ [PASS] Frame " << f << " delta result matches full upload\n";
+    }
+
+    std::cout << "[DELTA] " << frames.size() - 1 << " frames: " << delta_bytes << " bytes / "
+              << delta_cycles << " cycles with delta updates, " << full_bytes << " bytes / "
+              << full_cycles << " cycles with full uploads ("
+              << std::fixed << std::setprecision(1)
+              << 100.0 * (1.0 - (double)delta_bytes / full_bytes) << "% bytes, "
+              << 100.0 * (1.0 - (double)delta_cycles / full_cycles) << "% cycles saved)\n";
+    std::cout << "[DELTA] BNN busy: " << incremental_bnn_cycles << " cycles incremental, "
+              << full_bnn_cycles << " cycles full recompute ("
+              << 100.0 * (1.0 - (double)incremental_bnn_cycles / full_bnn_cycles) << "% saved)\n";
+    std::cout << std::defaultfloat;
+
+    std::cout << "[TEST COMPLETE] Delta image update\n";
+}
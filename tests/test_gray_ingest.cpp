@@ -0,0 +1,233 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+// CMD_IMG_SEND_GRAY mode byte
+constexpr uint8_t GRAY_4BIT = 0x01;      // two pixels per byte, low nibble first
+constexpr uint8_t GRAY_LIGHT_INK = 0x02; // ink is brighter than the background
+constexpr uint8_t GRAY_FIXED = 0x04;     // use the threshold byte instead of Otsu
+
+static const int GRAY_PIXELS = 30 * 30;
+static const int GRAY_SPI_HALF = 4;       // SCLK = clk/8
+static const int GRAY_DRAIN_LIMIT = 5000; // clk cycles from the last byte to a full buffer
+
+// Software model of gray_ingest.sv: threshold (Otsu on the upper nibble
+// unless GRAY_FIXED), then move the ink's bounding box to the middle.
+// `px` holds 8-bit pixels, 4-bit ones already expanded to {p, p}.
+std::string gray_reference(const std::vector<uint8_t> &px, uint8_t mode, uint8_t thresh_byte)
+{
+    int thresh = thresh_byte;
+    if (!(mode & GRAY_FIXED))
+    {
+        int64_t hist[16] = {}, sum_all = 0;
+        for (uint8_t p : px)
+        {
+            hist[p >> 4]++;
+            sum_all += p >> 4;
+        }
+
+        // Between-class variance up to a constant: (s0*N - S*w0)^2 / (w0*w1)
+        int64_t w0 = 0, s0 = 0;
+        bool best_v = false;
+        unsigned __int128 best_num = 0, best_den = 0;
+        int best_t = 0;
+        for (int t = 0; t < 15; ++t)
+        {
+            w0 += hist[t];
+            s0 += t * hist[t];
+            int64_t w1 = GRAY_PIXELS - w0;
+            if (w0 == 0 || w1 == 0)
+                continue;
+            int64_t diff = s0 * GRAY_PIXELS - sum_all * w0;
+            unsigned __int128 num = static_cast<unsigned __int128>(diff * diff);
+            unsigned __int128 den = static_cast<unsigned __int128>(w0 * w1);
+            if (!best_v || num * best_den > best_num * den)
+            {
+                best_v = true;
+                best_t = t;
+                best_num = num;
+                best_den = den;
+            }
+        }
+        thresh = best_v ? (best_t << 4) | 0xF : 0x7F;
+    }
+
+    bool light = mode & GRAY_LIGHT_INK;
+    auto ink = [&](uint8_t p)
+    { return light ? p > thresh : p <= thresh; };
+
+    int x0 = 30, x1 = -1, y0 = 30, y1 = -1;
+    for (int r = 0; r < 30; ++r)
+        for (int c = 0; c < 30; ++c)
+            if (ink(px[r * 30 + c]))
+            {
+                x0 = std::min(x0, c);
+                x1 = std::max(x1, c);
+                y0 = std::min(y0, r);
+                y1 = std::max(y1, r);
+            }
+
+    std::string flat(GRAY_PIXELS, '0');
+    if (x1 < 0)
+        return flat;
+
+    int bw = x1 - x0 + 1, bh = y1 - y0 + 1;
+    int ox = (30 - bw) / 2, oy = (30 - bh) / 2;
+    for (int r = oy; r < oy + bh; ++r)
+        for (int c = ox; c < ox + bw; ++c)
+            if (ink(px[(r - oy + y0) * 30 + (c - ox + x0)]))
+                flat[r * 30 + c] = '1';
+    return flat;
+}
+
+// A digit as a noisy grayscale crop, moved by (dx, dy)
+static std::vector<uint8_t> render_gray(const std::vector<std::string> &pattern, int dx, int dy, bool light,
+                                        std::mt19937 &rng)
+{
+    std::string flat = flatten_pattern(pattern);
+    std::uniform_int_distribution<int> ink_level(10, 70), bg_level(180, 250);
+
+    std::vector<uint8_t> px(GRAY_PIXELS);
+    for (int r = 0; r < 30; ++r)
+        for (int c = 0; c < 30; ++c)
+        {
+            int sr = r - dy, sc = c - dx;
+            bool on = sr >= 0 && sr < 30 && sc >= 0 && sc < 30 && flat[sr * 30 + sc] == '1';
+            int level = on ? ink_level(rng) : bg_level(rng);
+            px[r * 30 + c] = static_cast<uint8_t>(light ? 255 - level : level);
+        }
+    return px;
+}
+
+// Wire payload after the command byte; in 4-bit mode `px` is quantized to
+// what the fabric will see
+static std::vector<uint8_t> gray_payload(std::vector<uint8_t> &px, uint8_t mode, uint8_t thresh)
+{
+    std::vector<uint8_t> payload = {mode, thresh};
+    if (mode & GRAY_4BIT)
+    {
+        for (int i = 0; i < GRAY_PIXELS; i += 2)
+        {
+            uint8_t lo = px[i] >> 4, hi = px[i + 1] >> 4;
+            payload.push_back(static_cast<uint8_t>(lo | (hi << 4)));
+            px[i] = static_cast<uint8_t>(lo * 0x11);
+            px[i + 1] = static_cast<uint8_t>(hi * 0x11);
+        }
+    }
+    else
+    {
+        payload.insert(payload.end(), px.begin(), px.end());
+    }
+    return payload;
+}
+
+struct GrayCase
+{
+    const char *name;
+    const std::vector<std::string> *digit;
+    int dx, dy;
+    uint8_t mode;
+    uint8_t thresh;
+};
+
+void test_gray_ingest(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] Grayscale ingest (threshold + centering in fabric)\n";
+
+    const GrayCase cases[] = {
+        {"digit 3, 8-bit, Otsu", &digit_3, 4, -3, 0, 0},
+        {"digit 5, 4-bit, light ink, Otsu", &digit_5, -2, 5, GRAY_4BIT | GRAY_LIGHT_INK, 0},
+        {"digit 8, 8-bit, fixed 0x80", &digit_8, 3, 4, GRAY_FIXED, 0x80},
+        {"digit 1, 4-bit, fixed 0x60", &digit_1, -6, 0, GRAY_4BIT | GRAY_FIXED, 0x60},
+    };
+
+    std::mt19937 rng(49);
+    for (const GrayCase &tc : cases)
+    {
+        bool light = tc.mode & GRAY_LIGHT_INK;
+        std::vector<uint8_t> px = render_gray(*tc.digit, tc.dx, tc.dy, light, rng);
+        std::vector<uint8_t> payload = gray_payload(px, tc.mode, tc.thresh);
+        std::string expected = gray_reference(px, tc.mode, tc.thresh);
+
+        // Centering undoes the offset
+        std::vector<uint8_t> home = render_gray(*tc.digit, 0, 0, light, rng);
+        gray_payload(home, tc.mode, tc.thresh);
+        if (gray_reference(home, tc.mode, tc.thresh) != expected)
+        {
+            std::cerr << "❌ Reference model: " << tc.name << " centers differently from the unshifted digit\n";
+            assert(false);
+        }
+
+        do_reset(dut);
+        vluint64_t start = main_clk_ticks;
+        spi_send_byte(dut, CMD_IMG_SEND_GRAY);
+        spi_send_burst(dut, payload, GRAY_SPI_HALF);
+        vluint64_t rx_cycles = main_clk_ticks - start;
+
+        // The buffer is written only after the last pixel, so log from here
+        debug_log_clear();
+        dut->debug_trigger = 1;
+        vluint64_t drain_start = main_clk_ticks;
+        for (int i = 0; i < GRAY_DRAIN_LIMIT && (dut->status_code_reg == STATUS_RX_IMG_RDY ||
+                                                 dut->status_code_reg == STATUS_RX_IMG);
+             ++i)
+            tick_clk_cycles(dut, 1);
+        vluint64_t drain_cycles = main_clk_ticks - drain_start;
+        tick_clk_cycles(dut, 4);
+        dut->debug_trigger = 0;
+
+        bool full = dut->status_code_reg == STATUS_BNN_BUSY || dut->status_code_reg == STATUS_RESULT_RDY;
+
+        std::vector<debug_log::Record> records = debug_log_records();
+        size_t last_image = records.size();
+        for (size_t i = 0; i < records.size(); ++i)
+            if (records[i].type == debug_log::IMAGE && records[i].aux == 0)
+                last_image = i;
+        std::string logged;
+        if (last_image < records.size())
+            for (const auto &row : debug_log::image_rows(records, last_image))
+                logged += row;
+
+        if (!full || logged != expected)
+        {
+            std::cerr << "❌ " << tc.name << ": " << (full ? "buffer differs from the reference" : "buffer never filled")
+                      << "\n";
+            assert(full && logged == expected);
+        }
+
+        std::string shown = wait_for_result(dut);
+        size_t bytes = 1 + payload.size();
+        std::cout << "✅ [PASS] " << tc.name << ": " << bytes << " bytes in " << rx_cycles << " cycles, image ready "
+                  << drain_cycles << " cycles after the last byte, result " << shown << "\n";
+        std::cout << "[GRAY] " << std::fixed << std::setprecision(1)
+                  << 1000.0 * GRAY_PIXELS / (rx_cycles + drain_cycles) << " pixels per 1000 clk cycles at SCLK = clk/"
+                  << 2 * GRAY_SPI_HALF << std::defaultfloat << "\n";
+    }
+
+    // Flat image: every pixel in one histogram bin, no Otsu split, no ink
+    {
+        std::vector<uint8_t> px(GRAY_PIXELS, 200);
+        std::vector<uint8_t> payload = gray_payload(px, 0, 0);
+        assert(gray_reference(px, 0, 0) == std::string(GRAY_PIXELS, '0'));
+
+        do_reset(dut);
+        spi_send_byte(dut, CMD_IMG_SEND_GRAY);
+        spi_send_burst(dut, payload, GRAY_SPI_HALF);
+        for (int i = 0; i < GRAY_DRAIN_LIMIT && (dut->status_code_reg == STATUS_RX_IMG_RDY ||
+                                                 dut->status_code_reg == STATUS_RX_IMG);
+             ++i)
+            tick_clk_cycles(dut, 1);
+        check_fsm_state(dut, STATUS_BNN_BUSY, "STATUS_BNN_BUSY");
+        std::cout << "✅ [PASS] Flat image binarizes to a blank frame, result " << wait_for_result(dut) << "\n";
+    }
+
+    do_reset(dut);
+    std::cout << "[TEST COMPLETE] Grayscale ingest\n";
+}
@@ -44,8 +44,16 @@ void sclk_fall(Vsystem_controller *dut)
 
 void tick_main_clk(Vsystem_controller *dut, int cycles)
 {
-    for (int i = 0; i < (cycles * 100); i++)
+    tick_clk_cycles(dut, cycles * 50);
+}
+
+void tick_clk_cycles(Vsystem_controller *dut, int posedges)
+{
+    for (int i = 0; i < (posedges * 2); i++)
     {
+        if (spi_trace_recording && !dut->clk)
+            spi_trace_sample(dut); // pins in effect for the coming posedge
+
         dut->clk = !dut->clk;
         dut->eval();
 
@@ -105,6 +113,60 @@ void spi_send_bytes(Vsystem_controller *dut, const std::vector<uint8_t> &bytes)
     }
 }
 
+// Mode-0 burst: CS stays low for the whole payload, COPI changes while SCLK
+// is low. `half` clk cycles per SCLK level.
+void spi_send_burst(Vsystem_controller *dut, const std::vector<uint8_t> &bytes, int half)
+{
+    dut->spi_cs_n = 0;
+    tick_clk_cycles(dut, half);
+    for (uint8_t b : bytes)
+    {
+        for (int i = 7; i >= 0; --i)
+        {
+            dut->COPI = (b >> i) & 1;
+            tick_clk_cycles(dut, half);
+            dut->SCLK = 1;
+            tick_clk_cycles(dut, half);
+            dut->SCLK = 0;
+        }
+    }
+    tick_clk_cycles(dut, half);
+    dut->spi_cs_n = 1;
+    tick_clk_cycles(dut, 4);
+}
+
+// Quad-lane variant of spi_send_byte for CMD_IMG_SEND_QUAD payloads: two
+// SCLK periods per byte, high nibble first, bit 0 of each nibble on COPI
+void spi_send_byte_quad(Vsystem_controller *dut, uint8_t byte_val)
+{
+    if (!dut)
+        throw std::invalid_argument("spi_send_byte_quad: DUT pointer is null!");
+
+    dut->spi_cs_n = 0; // Start transaction
+    dut->eval();
+    tick_main_clk(dut, 7); // Setup time after CS_N falling
+
+    for (int shift = 4; shift >= 0; shift -= 4)
+    {
+        uint8_t nibble = (byte_val >> shift) & 0xF;
+
+        dut->COPI = nibble & 0x1;
+        dut->copi_quad = nibble >> 1;
+        dut->eval();
+        tick_main_clk(dut, 2); // Setup time before SCLK rising
+
+        sclk_rise(dut);
+        sclk_fall(dut);
+    }
+
+    tick_main_clk(dut, 7);
+
+    dut->spi_cs_n = 1; // End transaction
+    dut->copi_quad = 0;
+    dut->eval();
+    tick_main_clk(dut, 10); // Wait after CS_N goes high
+}
+
 void do_reset(Vsystem_controller *dut)
 {
     if (!dut)
@@ -49,7 +49,7 @@ std::string decode_seg(uint8_t seg)
     }
 }
 
-std::string read_seg(Vsystem_controller *dut, int max_cycles = 500)
+std::string read_seg(Vsystem_controller *dut, int max_cycles)
 {
     std::string digits(4, ' '); // Pre-fill with blanks
 
@@ -74,10 +74,11 @@ std::string read_seg(Vsystem_controller *dut, int max_cycles = 500)
         }
     }
 
-    return "[" + std::string(1, digits[0]) + "] " +
-           "[" + std::string(1, digits[1]) + "] " +
+    // Left to right, an[3] is the leftmost digit
+    return "[" + std::string(1, digits[3]) + "] " +
            "[" + std::string(1, digits[2]) + "] " +
-           "[" + std::string(1, digits[3]) + "]";
+           "[" + std::string(1, digits[1]) + "] " +
+           "[" + std::string(1, digits[0]) + "]";
 }
 
 // Extracted function to flatten a 30x30 pattern into a single string
@@ -108,20 +109,59 @@ void send_image_request_and_wait(Vsystem_controller *dut)
     check_fsm_state(dut, STATUS_RX_IMG_RDY, "STATUS_RX_IMG_RDY");
 }
 
-// Extracted function to stream image bits LSB-first in bytes
-void stream_image_bits(Vsystem_controller *dut, const std::string &flat)
+// Pack a flattened image LSB-first into the 113-byte image_buffer layout
+std::vector<uint8_t> pack_image_bytes(const std::string &flat)
 {
+    std::vector<uint8_t> bytes;
     for (size_t i = 0; i < flat.size(); i += 8)
     {
         uint8_t b = 0;
         for (int bit = 0; bit < 8 && i + bit < flat.size(); ++bit)
             if (flat[i + bit] == '1')
                 b |= (1 << bit);
+        bytes.push_back(b);
+    }
+    return bytes;
+}
+
+// Extracted function to stream image bits LSB-first in bytes
+void stream_image_bits(Vsystem_controller *dut, const std::string &flat)
+{
+    for (uint8_t b : pack_image_bytes(flat))
+    {
         spi_send_byte(dut, b);
         tick_main_clk(dut, 2);
     }
 }
 
+// Wait for the BNN to finish and return the displayed digits. A result cache
+// hit skips the BNN and goes straight to STATUS_RESULT_RDY.
+std::string wait_for_result(Vsystem_controller *dut)
+{
+    if (dut->status_code_reg != STATUS_RESULT_RDY)
+    {
+        check_fsm_state(dut, STATUS_BNN_BUSY, "STATUS_BNN_BUSY");
+        while (dut->status_code_reg == STATUS_BNN_BUSY)
+            tick_main_clk(dut, 3);
+    }
+
+    tick_main_clk(dut, 5);
+    return read_seg(dut, 100);
+}
+
+// Like wait_for_result, but also reports how long the BNN was busy
+std::string wait_for_result_timed(Vsystem_controller *dut, vluint64_t &bnn_cycles)
+{
+    check_fsm_state(dut, STATUS_BNN_BUSY, "STATUS_BNN_BUSY");
+    vluint64_t start = main_clk_ticks;
+    while (dut->status_code_reg == STATUS_BNN_BUSY)
+        tick_main_clk(dut, 1);
+    bnn_cycles = main_clk_ticks - start;
+
+    tick_main_clk(dut, 5);
+    return read_seg(dut, 100);
+}
+
 // Updated send_digit function to use extracted functions
 void send_digit(Vsystem_controller *dut, const std::vector<std::string> &digit, size_t idx)
 {
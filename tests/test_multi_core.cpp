@@ -0,0 +1,74 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+#include <iomanip>
+#include <map>
+#include <vector>
+
+// Matches the -GNUM_BNN_CORES the simulation was verilated with
+#ifndef NUM_BNN_CORES
+#define NUM_BNN_CORES 1
+#endif
+
+void test_multi_core(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] Strip throughput with " << NUM_BNN_CORES << " BNN core(s)\n";
+
+    do_reset(dut);
+
+    // Date- and amount-like fields, 12 images in total
+    std::vector<std::vector<std::vector<std::string>>> fields = {
+        {digit_2, digit_0, digit_2, digit_5},
+        {digit_1, digit_0, digit_1, digit_8},
+        {digit_3, digit_9, digit_6, digit_4}};
+
+    std::vector<std::vector<std::string>> strips;
+    for (const auto &field : fields)
+        strips.push_back(split_strip(make_strip(field)));
+
+    // Expected digits from single uploads, which always use one core at a time
+    std::map<std::string, char> single_result;
+    for (const auto &tiles : strips)
+        for (const auto &tile : tiles)
+        {
+            if (single_result.count(tile))
+                continue;
+            clear_buffer_and_wait(dut);
+            send_image_request_and_wait(dut);
+            stream_image_bits(dut, tile);
+            single_result[tile] = wait_for_result(dut)[1];
+        }
+
+    vluint64_t total_cycles = 0, total_drain = 0;
+    for (const auto &tiles : strips)
+    {
+        std::string expected;
+        for (size_t t = 0; t < tiles.size(); ++t)
+            expected += std::string(t ? " [" : "[") + single_result[tiles[t]] + "]";
+
+        clear_buffer_and_wait(dut);
+        vluint64_t start = main_clk_ticks;
+        vluint64_t drain = 0;
+        std::string seg = send_strip(dut, tiles, &drain);
+        total_cycles += main_clk_ticks - start;
+        total_drain += drain;
+
+        std::cout << "[CORES] Strip " << seg << ": " << main_clk_ticks - start << " cycles, "
+                  << drain << " after the last byte\n";
+        if (seg != expected)
+        {
+            std::cerr << "❌ Expected " << expected << " with " << NUM_BNN_CORES << " core(s)\n";
+            assert(seg == expected);
+        }
+    }
+    std::cout << "✅ [PASS] Results come back in tile order\n";
+
+    size_t images = strips.size() * strips[0].size();
+    std::cout << "[CORES] " << NUM_BNN_CORES << " core(s): " << total_cycles / images
+              << " cycles per image, " << total_drain / strips.size() << " cycles drain per strip\n";
+
+    std::cout << "[TEST COMPLETE] Multi-core dispatch\n";
+}
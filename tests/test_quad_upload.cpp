@@ -0,0 +1,87 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+#include <iomanip>
+
+static const std::string QUAD_SESSION_LOG = "spi_quad_session.bin";
+
+static void stream_image_quad(Vsystem_controller *dut, const std::string &flat)
+{
+    for (uint8_t b : pack_image_bytes(flat))
+    {
+        spi_send_byte_quad(dut, b);
+        tick_main_clk(dut, 2);
+    }
+}
+
+void test_quad_upload(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] Quad-lane image upload\n";
+
+    std::string flat = flatten_pattern(digit_2);
+
+    // Single lane, the reference for both the result and the timing
+    do_reset(dut);
+    clear_buffer_and_wait(dut);
+    send_image_request_and_wait(dut);
+    vluint64_t start = main_clk_ticks;
+    stream_image_bits(dut, flat);
+    vluint64_t single_cycles = main_clk_ticks - start;
+    std::string single_result = wait_for_result(dut);
+
+    // Same image on four lanes; reset so the result cache cannot answer.
+    // The session is recorded to check that replay drives all four lanes.
+    spi_trace_start(QUAD_SESSION_LOG);
+    do_reset(dut);
+    clear_buffer_and_wait(dut);
+    spi_send_byte(dut, CMD_IMG_SEND_QUAD);
+    tick_main_clk(dut, 5);
+    check_fsm_state(dut, STATUS_RX_IMG_RDY, "STATUS_RX_IMG_RDY");
+    start = main_clk_ticks;
+    stream_image_quad(dut, flat);
+    vluint64_t quad_cycles = main_clk_ticks - start;
+    std::string quad_result = wait_for_result(dut);
+    spi_trace_checkpoint(dut);
+    spi_trace_stop();
+
+    if (quad_result != single_result)
+    {
+        std::cerr << "❌ Quad upload shows " << quad_result << ", single lane showed " << single_result << "\n";
+        assert(quad_result == single_result);
+    }
+    std::cout << "✅ [PASS] Quad upload gives the single-lane result (" << quad_result << ")\n";
+
+    if (dut->spi_drop_count != 0)
+    {
+        std::cerr << "❌ SPI receiver dropped " << dut->spi_drop_count << " bytes of the quad upload\n";
+        assert(dut->spi_drop_count == 0);
+    }
+    std::cout << "✅ [PASS] No bytes dropped at four bits per SCLK\n";
+
+    SpiReplayStats replay = spi_replay(dut, QUAD_SESSION_LOG);
+    if (replay.checkpoints != 1 || replay.mismatches != 0)
+    {
+        std::cerr << "❌ Quad session replay: " << replay.checkpoints << " checkpoints, " << replay.mismatches
+                  << " mismatches\n";
+        assert(replay.checkpoints == 1 && replay.mismatches == 0);
+    }
+    std::cout << "✅ [PASS] Replayed quad session matches the recording\n";
+
+    std::cout << "[DEBUG] Upload: " << single_cycles << " cycles on one lane, " << quad_cycles
+              << " on four (" << std::fixed << std::setprecision(2)
+              << static_cast<double>(single_cycles) / quad_cycles << "x)" << std::defaultfloat << "\n";
+    assert(quad_cycles < single_cycles);
+
+    // Quad mode ends with the upload: the next image is single lane again
+    clear_buffer_and_wait(dut);
+    send_image_request_and_wait(dut);
+    stream_image_bits(dut, flat);
+    std::string after = wait_for_result(dut);
+    assert(after == single_result);
+    std::cout << "✅ [PASS] Single-lane upload after a quad upload\n";
+
+    std::cout << "[TEST COMPLETE] Quad-lane image upload\n";
+}
@@ -0,0 +1,73 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include "bnn_model.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+#include <iomanip>
+#include <vector>
+
+void test_reference_model(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] RTL vs C++ reference model\n";
+
+    bnn::Weights weights = bnn::load_weights(source_path("src/fpga/bnn_module/bnn_top.sv"));
+#ifdef FC_BINARY
+    bnn::BinaryFC fc = bnn::load_binary_fc(source_path("src/fpga/bnn_module/fc_binary_weights.svh"));
+    const std::string variant = "binary FC";
+#else
+    const std::string variant = "Q8.8 FC";
+#endif
+
+    std::vector<std::vector<std::string>> all_digits = {
+        digit_0, digit_1, digit_2, digit_3,
+        digit_4, digit_5, digit_6, digit_8, digit_9};
+    std::vector<int> labels = {0, 1, 2, 3, 4, 5, 6, 8, 9};
+
+    // Empty result cache, so every image goes through the BNN
+    do_reset(dut);
+
+    int correct = 0;
+    vluint64_t total_bnn_cycles = 0;
+    for (size_t idx = 0; idx < all_digits.size(); ++idx)
+    {
+        std::string flat = flatten_pattern(all_digits[idx]);
+#ifdef FC_BINARY
+        int expected = bnn::classify_binary(weights, fc, flat);
+#else
+        int expected = bnn::classify(weights, flat);
+#endif
+
+        clear_buffer_and_wait(dut);
+        send_image_request_and_wait(dut);
+        stream_image_bits(dut, flat);
+        vluint64_t bnn_cycles = 0;
+        wait_for_result_timed(dut, bnn_cycles);
+        total_bnn_cycles += bnn_cycles;
+
+        std::string shown = decode_seg(dut->seg);
+        std::string want = (expected == bnn::BLANK_RESULT) ? "Blank/Unknown" : std::to_string(expected);
+        correct += (shown == std::to_string(labels[idx]));
+
+        std::cout << "[MODEL] Digit " << labels[idx] << ": RTL " << shown << ", model " << want
+                  << ", BNN " << bnn_cycles << " cycles\n";
+        if (shown != want)
+        {
+            std::cerr << "❌ RTL shows " << shown << " but the " << variant << " model predicts " << want << "\n";
+            assert(shown == want);
+        }
+    }
+    std::cout << "✅ [PASS] RTL matches the " << variant << " model on all digits\n";
+
+    std::cout << "[MODEL] " << variant << ": " << correct << "/" << all_digits.size()
+              << " digits correct, " << total_bnn_cycles / all_digits.size() << " BNN cycles per image (FC "
+#ifdef FC_BINARY
+              << bnn::fc_binary_cycles()
+#else
+              << bnn::fc_q88_cycles()
+#endif
+              << " BNN clocks)\n";
+
+    std::cout << "[TEST COMPLETE] Reference model\n";
+}
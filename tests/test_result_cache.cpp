@@ -0,0 +1,127 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+#include <iomanip>
+#include <vector>
+
+constexpr int RESULT_CACHE_ENTRIES = 4;
+
+// Clear + full upload; reports whether the BNN ran and the cycles from the
+// request to the result
+static std::string upload_and_time(Vsystem_controller *dut, const std::string &flat,
+                                   bool &bnn_ran, vluint64_t &cycles)
+{
+    clear_buffer_and_wait(dut);
+    vluint64_t start = main_clk_ticks;
+    send_image_request_and_wait(dut);
+    stream_image_bits(dut, flat);
+
+    for (int i = 0; i < 20 && dut->status_code_reg == STATUS_RX_IMG; ++i)
+        tick_main_clk(dut, 1);
+
+    bnn_ran = (dut->status_code_reg == STATUS_BNN_BUSY);
+    while (dut->status_code_reg == STATUS_BNN_BUSY)
+        tick_main_clk(dut, 1);
+    check_fsm_state(dut, STATUS_RESULT_RDY, "STATUS_RESULT_RDY");
+    cycles = main_clk_ticks - start;
+
+    tick_main_clk(dut, 5);
+    return read_seg(dut, 100);
+}
+
+// Run the BNN again on the buffer as it is and return its result
+static std::string full_inference(Vsystem_controller *dut)
+{
+    spi_send_byte(dut, CMD_RERUN);
+    tick_main_clk(dut, 5);
+    std::string seg = wait_for_result(dut);
+    for (int i = 0; i < 20 && dut->status_code_reg != STATUS_RESULT_RDY; ++i)
+        tick_main_clk(dut, 1);
+    return seg;
+}
+
+static void check_counters(Vsystem_controller *dut, int hits, int misses)
+{
+    if (dut->cache_hit_count != hits || dut->cache_miss_count != misses)
+    {
+        std::cerr << "❌ Expected " << hits << " hits / " << misses << " misses, got "
+                  << (int)dut->cache_hit_count << " / " << (int)dut->cache_miss_count << "\n";
+        assert(dut->cache_hit_count == hits && dut->cache_miss_count == misses);
+    }
+    std::cout << "✅ [PASS] Cache counters: " << hits << " hits, " << misses << " misses\n";
+}
+
+void test_result_cache(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] Result cache keyed by image hash\n";
+
+    do_reset(dut);
+    check_counters(dut, 0, 0);
+
+    std::vector<std::vector<std::string>> all_digits = {
+        digit_0, digit_1, digit_2, digit_3, digit_4};
+
+    // First pass: every image is new and has to go through the BNN
+    std::vector<std::string> first_segs;
+    vluint64_t miss_cycles = 0;
+    for (size_t idx = 0; idx < RESULT_CACHE_ENTRIES; ++idx)
+    {
+        bool bnn_ran = false;
+        vluint64_t cycles = 0;
+        first_segs.push_back(upload_and_time(dut, flatten_pattern(all_digits[idx]), bnn_ran, cycles));
+        assert(bnn_ran);
+        miss_cycles += cycles;
+        std::cout << "[CACHE] Digit " << idx << " miss: " << cycles << " cycles -> "
+                  << first_segs.back() << "\n";
+    }
+    check_counters(dut, 0, RESULT_CACHE_ENTRIES);
+
+    // Second pass: same images, answered from the cache and checked against the BNN
+    vluint64_t hit_cycles = 0;
+    for (size_t idx = 0; idx < RESULT_CACHE_ENTRIES; ++idx)
+    {
+        bool bnn_ran = true;
+        vluint64_t cycles = 0;
+        std::string seg = upload_and_time(dut, flatten_pattern(all_digits[idx]), bnn_ran, cycles);
+        if (bnn_ran)
+        {
+            std::cerr << "❌ Repeated digit " << idx << " was not served from the cache\n";
+            assert(!bnn_ran);
+        }
+        hit_cycles += cycles;
+
+        std::string bnn_seg = full_inference(dut);
+        std::cout << "[CACHE] Digit " << idx << " hit: " << cycles << " cycles -> " << seg
+                  << " (BNN: " << bnn_seg << ")\n";
+        if (seg != first_segs[idx] || seg != bnn_seg)
+        {
+            std::cerr << "❌ Cached result " << seg << " for digit " << idx << " differs from BNN result "
+                      << bnn_seg << "\n";
+            assert(seg == first_segs[idx] && seg == bnn_seg);
+        }
+        std::cout << "✅ [PASS] Cached digit " << idx << " matches full inference\n";
+    }
+    check_counters(dut, RESULT_CACHE_ENTRIES, RESULT_CACHE_ENTRIES);
+
+    // A fifth image evicts the oldest entry, which then misses again
+    bool bnn_ran = false;
+    vluint64_t cycles = 0;
+    upload_and_time(dut, flatten_pattern(all_digits[RESULT_CACHE_ENTRIES]), bnn_ran, cycles);
+    assert(bnn_ran);
+    upload_and_time(dut, flatten_pattern(all_digits[0]), bnn_ran, cycles);
+    if (!bnn_ran)
+    {
+        std::cerr << "❌ Evicted digit 0 was still served from the cache\n";
+        assert(bnn_ran);
+    }
+    std::cout << "✅ [PASS] Oldest entry evicted\n";
+    check_counters(dut, RESULT_CACHE_ENTRIES, RESULT_CACHE_ENTRIES + 2);
+
+    std::cout << "[CACHE] Request-to-result latency: " << miss_cycles / RESULT_CACHE_ENTRIES
+              << " cycles on a miss, " << hit_cycles / RESULT_CACHE_ENTRIES << " cycles on a hit\n";
+
+    std::cout << "[TEST COMPLETE] Result cache\n";
+}
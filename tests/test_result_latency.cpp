@@ -0,0 +1,55 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include <iostream>
+#include <string>
+#include <cassert>
+
+#ifndef LOW_LATENCY
+#define LOW_LATENCY 0
+#endif
+
+static const int RESULT_LIMIT = 2000000; // clk cycles for the BNN to finish
+
+// Clocks from bnn_top raising out_valid to the host seeing
+// STATUS_RESULT_RDY, and to the result reaching the segment outputs.
+// Built with -GLOW_LATENCY=1 (main_test_low_latency) the path skips the
+// clock crossing, so `result_latency` runs both builds for comparison.
+void test_result_latency(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] Result latency (" << (LOW_LATENCY ? "low-latency handshake" : "synchronized handshake")
+              << ")\n";
+
+    do_reset(dut);
+    send_image_request_and_wait(dut);
+    stream_image_bits(dut, flatten_pattern(digit_3));
+    check_fsm_state(dut, STATUS_BNN_BUSY, "STATUS_BNN_BUSY");
+
+    vluint64_t done_tick = 0, status_tick = 0, seg_tick = 0;
+    for (int i = 0; i < RESULT_LIMIT && !(status_tick && seg_tick); ++i)
+    {
+        tick_clk_cycles(dut, 1);
+        if (!done_tick && dut->bnn_out_valid)
+            done_tick = main_clk_ticks;
+        if (!status_tick && dut->status_code_reg == STATUS_RESULT_RDY)
+            status_tick = main_clk_ticks;
+        if (!seg_tick && decode_seg(dut->seg) != "Blank/Unknown")
+            seg_tick = main_clk_ticks;
+    }
+    assert(done_tick && status_tick && seg_tick);
+
+    vluint64_t status_latency = status_tick - done_tick;
+    vluint64_t seg_latency = seg_tick - done_tick;
+    std::cout << "[LATENCY] out_valid -> STATUS_RESULT_RDY: " << status_latency
+              << " clk cycles, -> segment display: " << seg_latency << " clk cycles\n";
+
+    // Register stages left: result_ready_internal, then the status or
+    // segment register
+    if (LOW_LATENCY && (status_latency > 2 || seg_latency > 2))
+    {
+        std::cerr << "❌ Low-latency result path is longer than two clocks\n";
+        assert(status_latency <= 2 && seg_latency <= 2);
+    }
+
+    std::string shown = wait_for_result(dut);
+    std::cout << "✅ [PASS] Result " << shown << " after " << status_latency << " clk cycles\n";
+}
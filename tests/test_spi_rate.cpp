@@ -0,0 +1,85 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+#include <iomanip>
+
+#ifndef SPI_SCLK_DOMAIN
+#define SPI_SCLK_DOMAIN 0
+#endif
+
+// SCLK half periods to try, in clk cycles, slowest first
+static const int SWEEP_HALF_PERIODS[] = {16, 8, 6, 4, 3, 2, 1};
+static const int DRAIN_LIMIT = 2000; // clk cycles for the FIFO / FSM to catch up
+
+// Upload `flat` as one burst. Passes if the buffer filled and holds exactly
+// the image, as seen through the debug log, and the receiver dropped nothing.
+static bool upload_at_rate(Vsystem_controller *dut, const std::string &flat, int half, vluint64_t &burst_cycles)
+{
+    do_reset(dut);
+    send_image_request_and_wait(dut);
+
+    debug_log_clear();
+    dut->debug_trigger = 1;
+    vluint64_t start = main_clk_ticks;
+    spi_send_burst(dut, pack_image_bytes(flat), half);
+    burst_cycles = main_clk_ticks - start;
+
+    for (int i = 0; i < DRAIN_LIMIT && (dut->status_code_reg == STATUS_RX_IMG_RDY ||
+                                        dut->status_code_reg == STATUS_RX_IMG);
+         ++i)
+        tick_clk_cycles(dut, 1);
+    tick_clk_cycles(dut, 4);
+    dut->debug_trigger = 0;
+
+    bool full = dut->status_code_reg == STATUS_BNN_BUSY || dut->status_code_reg == STATUS_RESULT_RDY;
+
+    std::vector<debug_log::Record> records = debug_log_records();
+    size_t last_image = records.size();
+    for (size_t i = 0; i < records.size(); ++i)
+        if (records[i].type == debug_log::IMAGE && records[i].aux == 0)
+            last_image = i;
+
+    std::string logged;
+    if (last_image < records.size())
+        for (const auto &row : debug_log::image_rows(records, last_image))
+            logged += row;
+
+    return full && logged == flat && dut->spi_drop_count == 0;
+}
+
+void test_spi_rate(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] SPI link rate sweep (" << (SPI_SCLK_DOMAIN ? "SCLK-domain receiver" : "oversampling receiver")
+              << ")\n";
+
+    std::string flat = flatten_pattern(digit_8);
+
+    int best_half = 0;
+    for (int half : SWEEP_HALF_PERIODS)
+    {
+        vluint64_t cycles = 0;
+        bool ok = upload_at_rate(dut, flat, half, cycles);
+        // 113 bytes at clk = 100 MHz
+        double mbit_s = 113.0 * 8 * 100.0 / cycles;
+        std::cout << (ok ? "✅ " : "❌ ") << "[SPI RATE] SCLK = clk/" << 2 * half << ": burst " << cycles
+                  << " cycles, " << std::fixed << std::setprecision(1) << mbit_s << " Mbit/s at 100 MHz"
+                  << std::defaultfloat << "\n";
+        if (!ok)
+            break;
+        best_half = half;
+    }
+
+    // The slowest setting is within what the harness has always used
+    if (best_half == 0)
+    {
+        std::cerr << "❌ Upload fails even at SCLK = clk/" << 2 * SWEEP_HALF_PERIODS[0] << "\n";
+        assert(best_half != 0);
+    }
+    std::cout << "[SPI RATE] Fastest error-free SCLK = clk/" << 2 * best_half << "\n";
+
+    do_reset(dut);
+    std::cout << "[TEST COMPLETE] SPI link rate sweep\n";
+}
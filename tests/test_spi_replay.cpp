@@ -0,0 +1,80 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+
+static const std::string SPI_SESSION_LOG = "spi_session.bin";
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void check_replay(const SpiReplayStats &stats, int checkpoints, const std::string &what)
+{
+    if (stats.checkpoints != checkpoints || stats.mismatches != 0)
+    {
+        std::cerr << "❌ " << what << ": " << stats.checkpoints << " checkpoints, " << stats.mismatches
+                  << " mismatches\n";
+        assert(stats.checkpoints == checkpoints && stats.mismatches == 0);
+    }
+    std::cout << "✅ [PASS] " << what << " matches all " << checkpoints << " checkpoints\n";
+}
+
+void test_spi_replay(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] SPI session record and replay\n";
+
+    // Record: two uploads with an idle stretch between them
+    auto record_start = std::chrono::steady_clock::now();
+    spi_trace_start(SPI_SESSION_LOG);
+    do_reset(dut);
+
+    vluint64_t bnn_a = 0, bnn_b = 0;
+    clear_buffer_and_wait(dut);
+    send_image_request_and_wait(dut);
+    stream_image_bits(dut, flatten_pattern(digit_3));
+    std::string seg_a = wait_for_result_timed(dut, bnn_a);
+    spi_trace_checkpoint(dut);
+
+    vluint64_t idle_cycles = 20 * std::max<vluint64_t>(bnn_a, 1000);
+    tick_main_clk(dut, static_cast<int>(idle_cycles / 50));
+
+    clear_buffer_and_wait(dut);
+    send_image_request_and_wait(dut);
+    stream_image_bits(dut, flatten_pattern(digit_5));
+    std::string seg_b = wait_for_result_timed(dut, bnn_b);
+    spi_trace_checkpoint(dut);
+
+    size_t log_bytes = spi_trace_stop();
+    double record_s = seconds_since(record_start);
+    std::cout << "[REPLAY] Recorded " << seg_a << " and " << seg_b << " into " << log_bytes << " bytes\n";
+
+    // Replay as recorded; the log resets the DUT itself
+    auto replay_start = std::chrono::steady_clock::now();
+    SpiReplayStats full = spi_replay(dut, SPI_SESSION_LOG);
+    double replay_s = seconds_since(replay_start);
+    check_replay(full, 2, "Replay");
+
+    // Idle stretches longer than any BNN run can go
+    vluint64_t max_gap = 2 * std::max(bnn_a, bnn_b);
+    replay_start = std::chrono::steady_clock::now();
+    SpiReplayStats fast = spi_replay(dut, SPI_SESSION_LOG, max_gap);
+    double fast_s = seconds_since(replay_start);
+    check_replay(fast, 2, "Time-compressed replay");
+    assert(fast.skipped_cycles > 0);
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "[REPLAY] " << full.cycles << " cycles, " << full.pin_changes << " pin changes: recorded in "
+              << record_s << " s, replayed in " << replay_s << " s\n"
+              << "[REPLAY] max_gap " << max_gap << ": " << fast.cycles << " cycles (" << fast.skipped_cycles
+              << " idle cycles skipped) in " << fast_s << " s\n"
+              << std::defaultfloat;
+
+    std::cout << "[TEST COMPLETE] SPI record/replay\n";
+}
@@ -0,0 +1,137 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+#include <iomanip>
+#include <vector>
+
+constexpr int STRIP_TILES = 4;
+
+// Tick until the status reads `status`, failing after max_ticks
+static void wait_for_status(Vsystem_controller *dut, uint8_t status, const std::string &name, int max_ticks)
+{
+    for (int i = 0; i < max_ticks && dut->status_code_reg != status; ++i)
+        tick_main_clk(dut, 1);
+    check_fsm_state(dut, status, name);
+}
+
+// Glue 30x30 digits side by side into one 120x30 image
+std::vector<std::string> make_strip(const std::vector<std::vector<std::string>> &digits)
+{
+    std::vector<std::string> strip(30);
+    for (const auto &digit : digits)
+        for (size_t row = 0; row < 30; ++row)
+            strip[row] += digit[row];
+    return strip;
+}
+
+// Cut a 120x30 image into the four 30x30 tiles the strip command expects
+std::vector<std::string> split_strip(const std::vector<std::string> &strip)
+{
+    std::vector<std::string> tiles(STRIP_TILES);
+    for (const auto &row : strip)
+    {
+        assert(row.size() == 30 * STRIP_TILES);
+        for (int t = 0; t < STRIP_TILES; ++t)
+            tiles[t] += row.substr(t * 30, 30);
+    }
+    return tiles;
+}
+
+// Send one strip command and its tiles; returns the displayed digits.
+// drain_cycles, if given, gets the wait from the last tile byte to RESULT_RDY.
+std::string send_strip(Vsystem_controller *dut, const std::vector<std::string> &tiles,
+                       vluint64_t *drain_cycles)
+{
+    spi_send_byte(dut, CMD_IMG_SEND_STRIP);
+    tick_main_clk(dut, 5);
+    check_fsm_state(dut, STATUS_RX_IMG_RDY, "STATUS_RX_IMG_RDY");
+
+    for (int t = 0; t < STRIP_TILES; ++t)
+    {
+        stream_image_bits(dut, tiles[t]);
+        // The next tile can go as soon as the BNN has taken this one
+        if (t + 1 < STRIP_TILES)
+            wait_for_status(dut, STATUS_RX_IMG_RDY, "STATUS_RX_IMG_RDY", 20000);
+    }
+
+    vluint64_t drain_start = main_clk_ticks;
+    wait_for_status(dut, STATUS_RESULT_RDY, "STATUS_RESULT_RDY", 20000);
+    if (drain_cycles)
+        *drain_cycles = main_clk_ticks - drain_start;
+    tick_main_clk(dut, 5);
+    return read_seg(dut, 100);
+}
+
+void test_strip_mode(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] Strip mode: four tiles, four digits\n";
+
+    do_reset(dut);
+
+    std::vector<std::vector<std::string>> fields = {digit_2, digit_0, digit_3, digit_1};
+    std::vector<std::string> tiles = split_strip(make_strip(fields));
+
+    // Reference: one clear/request/upload round trip per digit
+    std::string expected;
+    vluint64_t single_start = main_clk_ticks;
+    for (int t = 0; t < STRIP_TILES; ++t)
+    {
+        clear_buffer_and_wait(dut);
+        send_image_request_and_wait(dut);
+        stream_image_bits(dut, tiles[t]);
+        std::string seg = wait_for_result(dut);
+        std::cout << "[STRIP] Tile " << t << " alone: " << seg << "\n";
+        expected += (t ? " " : "") + seg.substr(0, 3);
+    }
+    vluint64_t single_cycles = main_clk_ticks - single_start;
+
+    // Same four tiles in one strip upload
+    clear_buffer_and_wait(dut);
+    vluint64_t strip_start = main_clk_ticks;
+    std::string strip_seg = send_strip(dut, tiles);
+    vluint64_t strip_cycles = main_clk_ticks - strip_start;
+
+    std::cout << "[STRIP] Strip shows " << strip_seg << ", expected " << expected << "\n";
+    if (strip_seg != expected)
+    {
+        std::cerr << "❌ Strip digits differ from the single uploads\n";
+        assert(strip_seg == expected);
+    }
+    std::cout << "✅ [PASS] All four digits match the single-image results\n";
+
+    std::cout << "[STRIP] Commands: " << 3 * STRIP_TILES << " single vs 2 strip, "
+              << single_cycles << " vs " << strip_cycles << " cycles ("
+              << std::fixed << std::setprecision(2) << static_cast<double>(single_cycles) / strip_cycles
+              << "x)\n" << std::defaultfloat;
+
+    // A clear during the strip drops it and blanks the display
+    clear_buffer_and_wait(dut);
+    spi_send_byte(dut, CMD_IMG_SEND_STRIP);
+    tick_main_clk(dut, 5);
+    stream_image_bits(dut, tiles[0]);
+    clear_buffer_and_wait(dut);
+    std::string cleared = read_seg(dut, 100);
+    if (cleared != "[?] [?] [?] [?]")
+    {
+        std::cerr << "❌ Display not blank after aborting a strip: " << cleared << "\n";
+        assert(cleared == "[?] [?] [?] [?]");
+    }
+    std::cout << "✅ [PASS] CLEAR aborts a strip upload\n";
+
+    // A normal upload afterwards shows one result on every digit again
+    send_image_request_and_wait(dut);
+    stream_image_bits(dut, tiles[1]);
+    std::string single = wait_for_result(dut);
+    std::string want = "[" + std::string(1, expected[5]) + "]";
+    if (single != want + " " + want + " " + want + " " + want)
+    {
+        std::cerr << "❌ Single upload after a strip shows " << single << "\n";
+        assert(false);
+    }
+    std::cout << "✅ [PASS] Single uploads return to one result on all digits\n";
+
+    std::cout << "[TEST COMPLETE] Strip mode\n";
+}
@@ -0,0 +1,143 @@
+#include "main_test.hpp"
+#include "digits.h"
+#include "bnn_model.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cassert>
+#include <vector>
+
+// SCLK half period for the weight image: the slowest setting of the rate
+// sweep, which the oversampling receiver always handles
+static const int WEIGHT_SPI_HALF = 16;
+static const int WEIGHT_DONE_LIMIT = 20000; // clk cycles after the last byte
+
+static std::string expected_seg(int cls)
+{
+    return (cls == bnn::BLANK_RESULT) ? "Blank/Unknown" : std::to_string(cls);
+}
+
+// CMD_LOAD_WEIGHTS, the image and its CRC, then wait for the CRC check
+static void load_weights_over_spi(Vsystem_controller *dut, const std::vector<uint8_t> &image, uint32_t crc)
+{
+    spi_send_byte(dut, CMD_LOAD_WEIGHTS);
+    tick_main_clk(dut, 5);
+    check_fsm_state(dut, STATUS_RX_IMG, "STATUS_RX_IMG");
+
+    std::vector<uint8_t> payload = image;
+    for (int i = 0; i < 4; ++i)
+        payload.push_back((crc >> (8 * i)) & 0xFF);
+    spi_send_burst(dut, payload, WEIGHT_SPI_HALF);
+
+    for (int i = 0; i < WEIGHT_DONE_LIMIT && dut->status_code_reg == STATUS_RX_IMG; ++i)
+        tick_clk_cycles(dut, 1);
+    tick_main_clk(dut, 2);
+}
+
+static std::string classify_on_dut(Vsystem_controller *dut, const std::string &flat)
+{
+    clear_buffer_and_wait(dut);
+    send_image_request_and_wait(dut);
+    stream_image_bits(dut, flat);
+    return wait_for_result(dut);
+}
+
+static void expect_result(const std::string &shown, int expected, const std::string &what)
+{
+    if (shown != expected_seg(expected))
+    {
+        std::cerr << "❌ " << what << ": RTL shows " << shown << ", model predicts " << expected_seg(expected) << "\n";
+        assert(shown == expected_seg(expected));
+    }
+    std::cout << "✅ [PASS] " << what << " (" << shown << ")\n";
+}
+
+void test_weight_upload(Vsystem_controller *dut)
+{
+    std::cout << "\n[TEST] Runtime weight upload\n";
+
+    bnn::Weights boot = bnn::load_weights(source_path("src/fpga/bnn_module/bnn_top.sv"));
+
+#if defined(FC_BINARY) || defined(CONV_SPECIALIZED)
+    // These builds compute with weights fixed at synthesis time and refuse
+    // the command outright; the host clears the error and carries on
+    {
+        std::string flat = flatten_pattern(digit_3);
+#ifdef FC_BINARY
+        int expected = bnn::classify_binary(
+            boot, bnn::load_binary_fc(source_path("src/fpga/bnn_module/fc_binary_weights.svh")), flat);
+#else
+        int expected = bnn::classify(boot, flat);
+#endif
+        do_reset(dut);
+        spi_send_byte(dut, CMD_LOAD_WEIGHTS);
+        tick_main_clk(dut, 5);
+        check_fsm_state(dut, STATUS_ERROR, "STATUS_ERROR, upload refused by this build");
+        spi_send_byte(dut, CMD_CLEAR);
+        tick_main_clk(dut, 5);
+        check_fsm_state(dut, STATUS_IDLE, "STATUS_IDLE");
+        expect_result(classify_on_dut(dut, flat), expected, "Built-in weights kept");
+
+        do_reset(dut);
+        std::cout << "[TEST COMPLETE] Runtime weight upload\n";
+        return;
+    }
+#endif
+
+    std::vector<uint8_t> boot_image = bnn::weight_image(boot);
+    assert(static_cast<int>(boot_image.size()) == bnn::WEIGHT_BYTES);
+
+    // Second weight set: the FC rows move one class up, so the scores (and
+    // usually the answer) change while everything stays in range
+    bnn::Weights moved = boot;
+    for (int oc = 0; oc < bnn::FC_OC; ++oc)
+        for (int ic = 0; ic < bnn::FC_IC; ++ic)
+            moved.fc[oc * bnn::FC_IC + ic] = boot.fc[((oc + 1) % bnn::FC_OC) * bnn::FC_IC + ic];
+    std::vector<uint8_t> moved_image = bnn::weight_image(moved);
+
+    // Third set with the boot FC but other conv layers: conv1's kernels move
+    // one channel up and every conv2 kernel bit is inverted
+    bnn::Weights conv = boot;
+    for (int oc = 0; oc < bnn::CONV1_OC; ++oc)
+        conv.conv1[oc] = boot.conv1[(oc + 1) % bnn::CONV1_OC];
+    for (auto &kernel : conv.conv2)
+        for (auto &bit : kernel)
+            bit ^= 1;
+    std::vector<uint8_t> conv_image = bnn::weight_image(conv);
+
+    std::string flat_a = flatten_pattern(digit_3);
+    std::string flat_b = flatten_pattern(digit_6);
+
+    do_reset(dut);
+    expect_result(classify_on_dut(dut, flat_a), bnn::classify(boot, flat_a), "Boot weights");
+
+    // A verified upload switches banks and flushes the result cache, so the
+    // same image is classified again with the new weights
+    vluint64_t start = main_clk_ticks;
+    load_weights_over_spi(dut, moved_image, bnn::crc32(moved_image));
+    std::cout << "[DEBUG] Weight upload took " << main_clk_ticks - start << " cycles\n";
+    check_fsm_state(dut, STATUS_IDLE, "STATUS_IDLE after a good upload");
+    expect_result(classify_on_dut(dut, flat_a), bnn::classify(moved, flat_a), "Uploaded weights, same image");
+
+    // A corrupted CRC leaves the BNN on the weights it had
+    load_weights_over_spi(dut, boot_image, bnn::crc32(boot_image) ^ 1);
+    check_fsm_state(dut, STATUS_ERROR, "STATUS_ERROR after a bad CRC");
+    spi_send_byte(dut, CMD_CLEAR);
+    tick_main_clk(dut, 5);
+    check_fsm_state(dut, STATUS_IDLE, "STATUS_IDLE");
+    expect_result(classify_on_dut(dut, flat_b), bnn::classify(moved, flat_b), "Bad upload discarded");
+
+    // Both conv layers compute with the uploaded bank too
+    load_weights_over_spi(dut, conv_image, bnn::crc32(conv_image));
+    check_fsm_state(dut, STATUS_IDLE, "STATUS_IDLE after a conv upload");
+    expect_result(classify_on_dut(dut, flat_a), bnn::classify(conv, flat_a), "Uploaded conv weights");
+    expect_result(classify_on_dut(dut, flat_b), bnn::classify(conv, flat_b), "Uploaded conv weights, second image");
+
+    // The bank survives reset: put the boot weights back for later tests
+    load_weights_over_spi(dut, boot_image, bnn::crc32(boot_image));
+    check_fsm_state(dut, STATUS_IDLE, "STATUS_IDLE after restoring the boot weights");
+    expect_result(classify_on_dut(dut, flat_b), bnn::classify(boot, flat_b), "Boot weights restored");
+
+    do_reset(dut);
+    std::cout << "[TEST COMPLETE] Runtime weight upload\n";
+}